@@ -1,12 +1,11 @@
 #include <iostream>
-#include <thread>
-#include <chrono>
 #include <memory>
 #include "LCDInventoryController.h"
 #include "DisplayItem.h"
 #include "DisplayConfig.h"
 #include "ConsoleRenderer.h"
-#include "ConsoleInputListener.h"
+#include "ScannerInputListener.h"
+#include "CommandBatchReader.h"
 
 int main(int, char**)
 {
@@ -38,44 +37,42 @@ int main(int, char**)
     // The type system guarantees all items have identical widths
     // Type alias for common inventory use case: string keys, uint8_t values, 11x3 display
     LCDInventoryController<InventoryDisplayItem> controller(items, renderer, config);
+    controller.getDisplayController().enableKeyIndex();
 
-    // Set up input listener
-    ConsoleInputListener inputListener;
+    // Piped or redirected input is a command script: read it in large chunks and
+    // apply each chunk as one batch, rendering once per chunk instead of once per key
+    if (CommandBatchReader::isBulkInput())
+    {
+        CommandBatchReader reader;
+        std::vector<NavigationCommand> batch;
+        bool more = true;
+        while (more)
+        {
+            more = reader.readBatch(batch);
+            controller.applyCommands(batch);
+        }
+        return 0;
+    }
+
+    // Set up input listener (keyboard, plus a barcode scanner typing item keys)
+    ScannerInputListener inputListener;
     inputListener.startListening();
     inputListener.printHelp();
 
     controller.render();
 
-    while (true) {
+    while (inputListener.isListening()) {
         NavigationCommand command = inputListener.waitForCommand();
 
-        switch (command)
+        if (command == NavigationCommand::SelectByKey)
         {
-        case NavigationCommand::Up:
-            controller.navigateUp();
-            break;
-        case NavigationCommand::Down:
-            controller.navigateDown();
-            break;
-        case NavigationCommand::Select:
-            controller.selectItem();
-            break;
-        case NavigationCommand::Deselect:
-            controller.deselectItem();
-            break;
-        case NavigationCommand::Increment:
-            controller.incrementValue();
-            break;
-        case NavigationCommand::Decrement:
-            controller.decrementValue();
-            break;
-        case NavigationCommand::None:
-            // No action
-            break;
+            // Each scan counts one unit of the scanned item in
+            controller.selectByKey(std::string(inputListener.getScannedCode()), true);
+        }
+        else
+        {
+            controller.applyCommand(command);
         }
-
-        // Small delay to avoid busy waiting
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 
 }
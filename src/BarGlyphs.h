@@ -0,0 +1,75 @@
+#ifndef BARGLYPHS_H
+#define BARGLYPHS_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Set of eight bar glyphs (lowest to highest level) used for sparklines and position bars.
+ *
+ * HD44780-style controllers provide eight user-defined CGRAM characters. Their codes
+ * 0x00-0x07 are mirrored at 0x08-0x0F, and the mirrored codes are used here so that
+ * frames never contain NUL characters. Hosts upload the bitmaps from getCgramPattern()
+ * once at start-up; displays without CGRAM use the ASCII fallback.
+ */
+struct BarGlyphs
+{
+    static constexpr size_t levelCount = 8;
+    static constexpr size_t patternRows = 8;
+
+    std::array<char, levelCount> levels;
+
+    /**
+     * Glyphs mapped to CGRAM characters 0-7 (codes 0x08-0x0F).
+     */
+    static constexpr BarGlyphs cgram()
+    {
+        return BarGlyphs{{'\x08', '\x09', '\x0A', '\x0B', '\x0C', '\x0D', '\x0E', '\x0F'}};
+    }
+
+    /**
+     * Plain ASCII approximation for displays without custom characters.
+     */
+    static constexpr BarGlyphs ascii()
+    {
+        return BarGlyphs{{'_', '.', ',', '-', '=', '+', '*', '#'}};
+    }
+
+    /**
+     * Check whether any level is a CGRAM character (codes 0x00-0x0F).
+     */
+    constexpr bool usesCgram() const
+    {
+        for (char level : levels)
+        {
+            if (static_cast<unsigned char>(level) < 0x10)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Get the glyph for a level (clamped to 0..levelCount-1).
+     */
+    constexpr char glyph(size_t level) const
+    {
+        return levels[level < levelCount ? level : levelCount - 1];
+    }
+
+    /**
+     * Get the 5x8 bitmap of the CGRAM bar for a level: level 0 lights the bottom row,
+     * level 7 lights the whole cell.
+     * @param level Bar level (0 to levelCount-1)
+     * @param row Pixel row, 0 being the top row
+     * @return Row bitmap (5 least significant bits)
+     */
+    static constexpr uint8_t getCgramPattern(size_t level, size_t row)
+    {
+        return (row >= patternRows - 1 - (level < levelCount ? level : levelCount - 1)) ? 0x1F : 0x00;
+    }
+};
+
+#endif // BARGLYPHS_H
@@ -0,0 +1,60 @@
+#ifndef BITOPS_H
+#define BITOPS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * Word-at-a-time bit helpers for bitmaps stored as 64-bit words.
+ */
+
+/**
+ * Number of set bits in a word.
+ */
+inline size_t popCount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<size_t>(__popcnt64(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<size_t>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * Index of the lowest set bit of a non-zero word.
+ */
+inline size_t countTrailingZeros(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<size_t>(index);
+#else
+    return popCount((word & (0 - word)) - 1);
+#endif
+}
+
+/**
+ * Index of the rank-th (0-based) set bit of a word; the word must have more than rank bits set.
+ */
+inline size_t selectBit(uint64_t word, size_t rank)
+{
+    for (size_t i = 0; i < rank; ++i)
+    {
+        word &= word - 1;
+    }
+    return countTrailingZeros(word);
+}
+
+#endif // BITOPS_H
@@ -0,0 +1,54 @@
+#include "CommandBatchReader.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+CommandBatchReader::CommandBatchReader(int fd)
+    : m_fd(fd), m_chunk(chunkSize)
+{
+}
+
+bool CommandBatchReader::isBulkInput(int fd)
+{
+#ifdef _WIN32
+    return !_isatty(fd);
+#else
+    return !::isatty(fd);
+#endif
+}
+
+bool CommandBatchReader::readBatch(std::vector<NavigationCommand>& batch)
+{
+    batch.clear();
+
+#ifdef _WIN32
+    int bytesRead = _read(m_fd, m_chunk.data(), static_cast<unsigned>(m_chunk.size()));
+#else
+    ssize_t bytesRead;
+    do
+    {
+        // A signal arriving while the pipe is empty interrupts the read, not the input
+        bytesRead = ::read(m_fd, m_chunk.data(), m_chunk.size());
+    } while (bytesRead < 0 && errno == EINTR);
+#endif
+    if (bytesRead <= 0)
+    {
+        // A trailing lone Escape is the Escape key
+        NavigationCommand last = m_parser.timeout();
+        if (last != NavigationCommand::None)
+        {
+            batch.push_back(last);
+        }
+        return false;
+    }
+
+    // Sequences split across chunks are completed by the parser's state on the next read
+    size_t length = static_cast<size_t>(bytesRead);
+    batch.resize(length);
+    batch.resize(m_parser.parse(m_chunk.data(), length, batch.data()));
+    return true;
+}
@@ -0,0 +1,33 @@
+#ifndef CommandBatchReader_h
+#define CommandBatchReader_h
+
+#include "IInputListener.h"
+#include "EscapeSequenceParser.h"
+#include <vector>
+
+// Reads commands from piped or redirected input (e.g., `cat cmds | twoRowDisplayApp`)
+// in large chunks, so a script of thousands of commands is parsed in a few reads and
+// can be applied as a handful of batches instead of one blocking read per key.
+class CommandBatchReader
+{
+public:
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    // fd: input to read (standard input by default)
+    explicit CommandBatchReader(int fd = 0);
+
+    // True if the input is not an interactive terminal (a pipe or a file)
+    static bool isBulkInput(int fd = 0);
+
+    // Read the next chunk and replace batch with the commands it contains.
+    // Returns false once the input is exhausted or fails (batch then holds any final
+    // commands). Reads interrupted by a signal are retried.
+    bool readBatch(std::vector<NavigationCommand>& batch);
+
+private:
+    int m_fd;
+    EscapeSequenceParser m_parser;
+    std::vector<char> m_chunk;
+};
+
+#endif // CommandBatchReader_h
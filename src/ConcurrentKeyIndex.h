@@ -0,0 +1,456 @@
+#ifndef CONCURRENTKEYINDEX_H
+#define CONCURRENTKEYINDEX_H
+
+#include <atomic>
+#include "ParallelAlgorithms.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Concurrent key-to-item-index hash map for updates addressed by key (e.g., scanners).
+ *
+ * The map is split into shards, each an open-addressing table with linear probing.
+ * Lookups never lock: they read the shard's current table and its entries through
+ * atomics, so any number of threads can resolve keys while another thread inserts.
+ * Inserts and removes lock only the shard owning the key, so producers touching different
+ * shards do not contend.
+ *
+ * Removed entries stay in their slots until the shard is rehashed, which remove() does
+ * once they outnumber the live ones, so churn keeps every shard proportional to its keys.
+ * Entries and tables unlinked by a rehash are retired and freed by the next writer of the
+ * shard that finds no lookup in progress on it (each lookup counts itself in and out of its
+ * shard), so memory is reclaimed without pausing lookups. Keys are unique: insert() and
+ * build() never overwrite a mapping and report keys that were already present.
+ *
+ * @tparam TKey Key type
+ * @tparam THash Hash function for TKey
+ */
+template<typename TKey, typename THash = std::hash<TKey>>
+class ConcurrentKeyIndex
+{
+public:
+    static constexpr size_t notFound = static_cast<size_t>(-1);
+
+private:
+    static constexpr size_t shardCount = 16;
+    static constexpr size_t minimumSlots = 16;
+
+    struct Entry
+    {
+        size_t hash;
+        TKey key;
+        std::atomic<size_t> itemIndex;      // notFound once removed
+
+        Entry(size_t hash, TKey key, size_t itemIndex)
+            : hash(hash), key(std::move(key)), itemIndex(itemIndex)
+        {
+        }
+    };
+
+    struct Table
+    {
+        size_t mask;
+        std::unique_ptr<std::atomic<Entry*>[]> slots;
+
+        explicit Table(size_t slotCount)
+            : mask(slotCount - 1), slots(new std::atomic<Entry*>[slotCount])
+        {
+            for (size_t i = 0; i < slotCount; ++i)
+            {
+                slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;                   // Serializes writers of this shard
+        std::atomic<Table*> table{nullptr};
+        std::atomic<size_t> readers{0};     // Lookups in progress
+        size_t used = 0;                    // Occupied slots, including removed entries
+        std::atomic<size_t> live{0};
+        std::vector<std::unique_ptr<Table>> tables;     // Current (last) and retired tables
+        std::vector<std::unique_ptr<Entry>> entries;    // Entries linked from the current table
+        std::vector<std::unique_ptr<Entry>> retired;    // Removed entries unlinked by a rehash
+    };
+
+    THash hasher;
+    std::unique_ptr<Shard[]> shards;
+
+    size_t hashOf(const TKey& key) const
+    {
+        // Mix so that weak hashes (identity for integers) still spread over shards and slots
+        uint64_t hash = static_cast<uint64_t>(hasher(key));
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        return static_cast<size_t>(hash);
+    }
+
+    static size_t shardIndexOf(size_t hash)
+    {
+        // High bits pick the shard, low bits the slot
+        return (hash >> (sizeof(size_t) * 8 - 4)) % shardCount;
+    }
+
+    Shard& shardOf(size_t hash) const
+    {
+        return shards[shardIndexOf(hash)];
+    }
+
+    static Entry* findEntry(const Table* table, size_t hash, const TKey& key)
+    {
+        for (size_t slot = hash & table->mask;; slot = (slot + 1) & table->mask)
+        {
+            Entry* entry = table->slots[slot].load(std::memory_order_acquire);
+            if (!entry)
+            {
+                return nullptr;
+            }
+            if (entry->hash == hash && entry->key == key &&
+                entry->itemIndex.load(std::memory_order_acquire) != notFound)
+            {
+                return entry;
+            }
+        }
+    }
+
+    static void placeEntry(Table* table, Entry* entry)
+    {
+        size_t slot = entry->hash & table->mask;
+        while (table->slots[slot].load(std::memory_order_relaxed))
+        {
+            slot = (slot + 1) & table->mask;
+        }
+        table->slots[slot].store(entry, std::memory_order_release);
+    }
+
+    /**
+     * Free retired tables and entries unless a lookup on the shard is in progress
+     * (writer lock held). A lookup that starts afterwards loads the current table, which
+     * no longer reaches them.
+     */
+    static void releaseRetired(Shard& shard)
+    {
+        if ((shard.tables.size() > 1 || !shard.retired.empty()) &&
+            shard.readers.load(std::memory_order_seq_cst) == 0)
+        {
+            shard.tables.erase(shard.tables.begin(), shard.tables.end() - 1);
+            shard.retired.clear();
+        }
+    }
+
+    /**
+     * Replace the shard's table with one sized for its live entries (writer lock held).
+     * Removed entries are dropped from the new table and retired; readers of the old one
+     * still finish.
+     */
+    void rehash(Shard& shard, size_t minimumLive)
+    {
+        size_t slotCount = minimumSlots;
+        while (slotCount < minimumLive * 2)
+        {
+            slotCount <<= 1;
+        }
+
+        std::unique_ptr<Table> table(new Table(slotCount));
+        Table* old = shard.table.load(std::memory_order_relaxed);
+        if (old)
+        {
+            for (size_t i = 0; i <= old->mask; ++i)
+            {
+                Entry* entry = old->slots[i].load(std::memory_order_relaxed);
+                if (entry && entry->itemIndex.load(std::memory_order_relaxed) != notFound)
+                {
+                    placeEntry(table.get(), entry);
+                }
+            }
+        }
+        shard.used = shard.live;
+        shard.table.store(table.get(), std::memory_order_seq_cst);
+        shard.tables.push_back(std::move(table));
+
+        auto removed = std::partition(shard.entries.begin(), shard.entries.end(),
+            [](const std::unique_ptr<Entry>& entry)
+            {
+                return entry->itemIndex.load(std::memory_order_relaxed) != notFound;
+            });
+        std::move(removed, shard.entries.end(), std::back_inserter(shard.retired));
+        shard.entries.erase(removed, shard.entries.end());
+        releaseRetired(shard);
+    }
+
+public:
+    explicit ConcurrentKeyIndex(const THash& hasher = THash())
+        : hasher(hasher), shards(new Shard[shardCount])
+    {
+        for (size_t i = 0; i < shardCount; ++i)
+        {
+            rehash(shards[i], 0);
+        }
+    }
+
+    ConcurrentKeyIndex(const ConcurrentKeyIndex&) = delete;
+    ConcurrentKeyIndex& operator=(const ConcurrentKeyIndex&) = delete;
+
+    /**
+     * Get the item index of a key, or notFound. Lock-free; safe from any thread.
+     */
+    size_t find(const TKey& key) const
+    {
+        size_t hash = hashOf(key);
+        Shard& shard = shardOf(hash);
+        shard.readers.fetch_add(1, std::memory_order_seq_cst);
+        const Table* table = shard.table.load(std::memory_order_seq_cst);
+        const Entry* entry = findEntry(table, hash, key);
+        size_t itemIndex = entry ? entry->itemIndex.load(std::memory_order_acquire) : notFound;
+        shard.readers.fetch_sub(1, std::memory_order_release);
+        return itemIndex;
+    }
+
+    /**
+     * Map a key to an item index. Locks only the key's shard.
+     * @return false if the key is already present (its mapping is kept)
+     */
+    bool insert(const TKey& key, size_t itemIndex)
+    {
+        size_t hash = hashOf(key);
+        Shard& shard = shardOf(hash);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        if (findEntry(table, hash, key))
+        {
+            return false;
+        }
+        // Keep the load factor at or below one half
+        if ((shard.used + 1) * 2 > table->mask + 1)
+        {
+            rehash(shard, shard.live + 1);
+            table = shard.table.load(std::memory_order_relaxed);
+        }
+
+        shard.entries.emplace_back(new Entry(hash, key, itemIndex));
+        placeEntry(table, shard.entries.back().get());
+        ++shard.used;
+        ++shard.live;
+        releaseRetired(shard);
+        return true;
+    }
+
+    /**
+     * Insert keys 0..count-1 (key i maps to item i) using all threads of a pool.
+     * Keys are hashed and partitioned by shard in parallel chunks, then each shard is
+     * filled by a single thread, so threads never contend for a shard and every table is
+     * sized once. Afterwards the index is maintained with insert() and remove() as usual.
+     * Must not run concurrently with other writers; keys already present are skipped.
+     *
+     * @param getKey Callable (size_t itemIndex) -> TKey
+     * @return Number of keys inserted (less than count if some keys were already present)
+     */
+    template<typename TGetKey>
+    size_t build(size_t count, TGetKey getKey, WorkerPool& pool)
+    {
+        struct Pending
+        {
+            size_t hash;
+            TKey key;
+            size_t itemIndex;
+        };
+
+        std::vector<size_t> bounds = splitRange(count, pool.getConcurrency());
+        size_t chunkCount = bounds.size() - 1;
+        std::vector<std::vector<Pending>> partitions(chunkCount * shardCount);
+        pool.parallelFor(chunkCount, [&](size_t begin, size_t end)
+        {
+            for (size_t chunk = begin; chunk < end; ++chunk)
+            {
+                for (size_t i = bounds[chunk]; i < bounds[chunk + 1]; ++i)
+                {
+                    TKey key = getKey(i);
+                    size_t hash = hashOf(key);
+                    partitions[chunk * shardCount + shardIndexOf(hash)].push_back(
+                        Pending{hash, std::move(key), i});
+                }
+            }
+        });
+
+        std::atomic<size_t> inserted{0};
+        pool.parallelFor(shardCount, [&](size_t begin, size_t end)
+        {
+            for (size_t s = begin; s < end; ++s)
+            {
+                Shard& shard = shards[s];
+                size_t liveBefore = shard.live;
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                size_t incoming = 0;
+                for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+                {
+                    incoming += partitions[chunk * shardCount + s].size();
+                }
+                Table* table = shard.table.load(std::memory_order_relaxed);
+                if ((shard.used + incoming) * 2 > table->mask + 1)
+                {
+                    rehash(shard, shard.live + incoming);
+                    table = shard.table.load(std::memory_order_relaxed);
+                }
+                shard.entries.reserve(shard.entries.size() + incoming);
+
+                for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+                {
+                    for (Pending& pending : partitions[chunk * shardCount + s])
+                    {
+                        if (findEntry(table, pending.hash, pending.key))
+                        {
+                            continue;
+                        }
+                        shard.entries.emplace_back(
+                            new Entry(pending.hash, std::move(pending.key), pending.itemIndex));
+                        placeEntry(table, shard.entries.back().get());
+                        ++shard.used;
+                        ++shard.live;
+                    }
+                }
+                inserted += shard.live - liveBefore;
+            }
+        });
+        return inserted;
+    }
+
+    /**
+     * Remove a key. Locks only the key's shard.
+     * @return false if the key was not present
+     */
+    bool remove(const TKey& key)
+    {
+        size_t hash = hashOf(key);
+        Shard& shard = shardOf(hash);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        Entry* entry = findEntry(shard.table.load(std::memory_order_relaxed), hash, key);
+        if (!entry)
+        {
+            return false;
+        }
+        // The entry stays in its slot so that probe chains through it remain intact,
+        // until removed entries outnumber live ones and the shard is rehashed without them
+        entry->itemIndex.store(notFound, std::memory_order_release);
+        --shard.live;
+        size_t removed = shard.used - shard.live;
+        if (removed > shard.live && removed >= minimumSlots / 2)
+        {
+            rehash(shard, shard.live);
+        }
+        else
+        {
+            releaseRetired(shard);
+        }
+        return true;
+    }
+
+    /**
+     * Add delta to every item index at or above firstIndex, after items were inserted
+     * into (delta 1) or removed from (delta -1) the middle of the list. O(entries).
+     * Lookups running concurrently may see old or new indices.
+     */
+    void shiftIndices(size_t firstIndex, std::ptrdiff_t delta)
+    {
+        for (size_t s = 0; s < shardCount; ++s)
+        {
+            Shard& shard = shards[s];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto& entry : shard.entries)
+            {
+                size_t itemIndex = entry->itemIndex.load(std::memory_order_relaxed);
+                if (itemIndex != notFound && itemIndex >= firstIndex)
+                {
+                    entry->itemIndex.store(itemIndex + static_cast<size_t>(delta),
+                                           std::memory_order_release);
+                }
+            }
+        }
+    }
+
+    /**
+     * Renumber item indices after the items at itemIndices (ascending) were removed from
+     * the list: every index drops by the number of removed items below it. Remove the keys
+     * of those items first. One pass over the entries, O(entries * log removed).
+     * Lookups running concurrently may see old or new indices.
+     */
+    void compactIndices(const std::vector<size_t>& itemIndices)
+    {
+        if (itemIndices.empty())
+        {
+            return;
+        }
+        for (size_t s = 0; s < shardCount; ++s)
+        {
+            Shard& shard = shards[s];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto& entry : shard.entries)
+            {
+                size_t itemIndex = entry->itemIndex.load(std::memory_order_relaxed);
+                if (itemIndex == notFound || itemIndex < itemIndices.front())
+                {
+                    continue;
+                }
+                size_t removedBelow = static_cast<size_t>(
+                    std::lower_bound(itemIndices.begin(), itemIndices.end(), itemIndex) - itemIndices.begin());
+                entry->itemIndex.store(itemIndex - removedBelow, std::memory_order_release);
+            }
+        }
+    }
+
+    /**
+     * Rehash every shard without its removed entries and free what no lookup can still
+     * reach. Removals already do this as they go; this additionally shrinks every table to
+     * its live keys. Safe to call concurrently with lookups and writers.
+     */
+    void reclaim()
+    {
+        for (size_t s = 0; s < shardCount; ++s)
+        {
+            Shard& shard = shards[s];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            rehash(shard, shard.live);
+        }
+    }
+
+    /**
+     * Get number of entries held, live or removed, including retired ones not yet freed
+     * (not synchronized with concurrent writers). Stays proportional to size() under churn.
+     */
+    size_t entryCount() const
+    {
+        size_t count = 0;
+        for (size_t s = 0; s < shardCount; ++s)
+        {
+            count += shards[s].entries.size() + shards[s].retired.size();
+        }
+        return count;
+    }
+
+    /**
+     * Get number of keys (not synchronized with concurrent writers).
+     */
+    size_t size() const
+    {
+        size_t count = 0;
+        for (size_t s = 0; s < shardCount; ++s)
+        {
+            count += shards[s].live;
+        }
+        return count;
+    }
+};
+
+#endif // CONCURRENTKEYINDEX_H
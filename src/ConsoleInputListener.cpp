@@ -1,18 +1,22 @@
 #include "ConsoleInputListener.h"
+#include "KeyBindings.h"
 #include <iostream>
 
 #ifdef _WIN32
 #include <conio.h>
-#else
-#include <termios.h>
-#include <unistd.h>
-#include <fcntl.h>
 #endif
 
-ConsoleInputListener::ConsoleInputListener()
+#ifdef _WIN32
+ConsoleInputListener::ConsoleInputListener(int)
     : m_listening(false)
 {
 }
+#else
+ConsoleInputListener::ConsoleInputListener(int fd)
+    : m_listening(false), m_reader(fd)
+{
+}
+#endif
 
 ConsoleInputListener::~ConsoleInputListener()
 {
@@ -21,12 +25,19 @@ ConsoleInputListener::~ConsoleInputListener()
 
 void ConsoleInputListener::startListening()
 {
+#ifndef _WIN32
+    // Keys must arrive as they are pressed, without echo or line buffering
+    m_reader.enterRawMode();
+#endif
     m_listening = true;
 }
 
 void ConsoleInputListener::stopListening()
 {
     m_listening = false;
+#ifndef _WIN32
+    m_reader.restoreMode();
+#endif
 }
 
 bool ConsoleInputListener::isListening() const
@@ -36,42 +47,49 @@ bool ConsoleInputListener::isListening() const
 
 void ConsoleInputListener::printHelp() const
 {
-    std::cout << "\n=== Navigation Controls ===" << std::endl;
-    std::cout << "  w / W  : Navigate Up" << std::endl;
-    std::cout << "  s / S  : Navigate Down" << std::endl;
-    std::cout << "  e / E  : Select Item" << std::endl;
-    std::cout << "  q / Q  : Deselect Item" << std::endl;
-    std::cout << "  d / D  : Increment Value" << std::endl;
-    std::cout << "  a / A  : Decrement Value" << std::endl;
-    std::cout << "  x / X  : Exit" << std::endl;
-    std::cout << "===========================\n" << std::endl;
+    printKeyBindings(std::cout);
 }
 
 NavigationCommand ConsoleInputListener::charToCommand(char c) const
 {
-    switch (c)
+    return keyToCommand(c);
+}
+
+#ifdef _WIN32
+
+NavigationCommand ConsoleInputListener::readConsoleKey()
+{
+    int c = _getch();
+    if (c == 0 || c == 0xE0)
+    {
+        // Extended key: a second code identifies it
+        switch (_getch())
+        {
+        case 72:
+            return NavigationCommand::Up;
+        case 80:
+            return NavigationCommand::Down;
+        case 77:
+            return NavigationCommand::Increment;
+        case 75:
+            return NavigationCommand::Decrement;
+        case 73:
+            return NavigationCommand::PageUp;
+        case 81:
+            return NavigationCommand::PageDown;
+        case 71:
+            return NavigationCommand::First;
+        case 79:
+            return NavigationCommand::Last;
+        default:
+            return NavigationCommand::None;
+        }
+    }
+    if (c == 27)
     {
-    case 'w':
-    case 'W':
-        return NavigationCommand::Up;
-    case 's':
-    case 'S':
-        return NavigationCommand::Down;
-    case 'e':
-    case 'E':
-        return NavigationCommand::Select;
-    case 'q':
-    case 'Q':
         return NavigationCommand::Deselect;
-    case 'd':
-    case 'D':
-        return NavigationCommand::Increment;
-    case 'a':
-    case 'A':
-        return NavigationCommand::Decrement;
-    default:
-        return NavigationCommand::None;
     }
+    return charToCommand(static_cast<char>(c));
 }
 
 NavigationCommand ConsoleInputListener::pollCommand()
@@ -83,8 +101,7 @@ NavigationCommand ConsoleInputListener::pollCommand()
 
     if (_kbhit())
     {
-        char c = static_cast<char>(_getch());
-        return charToCommand(c);
+        return readConsoleKey();
     }
     return NavigationCommand::None;
 }
@@ -96,6 +113,72 @@ NavigationCommand ConsoleInputListener::waitForCommand()
         return NavigationCommand::None;
     }
 
-    char c = static_cast<char>(_getch());
-    return charToCommand(c);
+    return readConsoleKey();
 }
+
+#else
+
+NavigationCommand ConsoleInputListener::pollCommand()
+{
+    return nextCommand(0);
+}
+
+NavigationCommand ConsoleInputListener::waitForCommand()
+{
+    return nextCommand(-1);
+}
+
+NavigationCommand ConsoleInputListener::nextCommand(int timeoutMs)
+{
+    for (;;)
+    {
+        while (m_reader.hasInput())
+        {
+            NavigationCommand command = m_parser.feed(m_reader.next());
+            if (command != NavigationCommand::None)
+            {
+                return command;
+            }
+        }
+        if (!m_listening)
+        {
+            return m_parser.timeout();
+        }
+
+        // An incomplete sequence waits at most the escape timeout for its remaining bytes
+        int waitMs = timeoutMs;
+        if (m_parser.isPending())
+        {
+            waitMs = m_reader.escapeWaitMs(timeoutMs);
+        }
+
+        TerminalReader::ReadResult result = m_reader.fill(waitMs);
+        if (result == TerminalReader::ReadResult::Closed)
+        {
+            m_listening = false;
+        }
+        if (result != TerminalReader::ReadResult::Data)
+        {
+            if (!m_listening)
+            {
+                // End of input: an incomplete sequence will never be finished
+                return m_parser.timeout();
+            }
+            if (m_parser.isPending() && m_reader.escapeTimedOut())
+            {
+                NavigationCommand command = m_parser.timeout();
+                if (command != NavigationCommand::None)
+                {
+                    return command;
+                }
+                continue;
+            }
+            if (timeoutMs >= 0)
+            {
+                return NavigationCommand::None;
+            }
+        }
+    }
+}
+
+#endif
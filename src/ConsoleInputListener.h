@@ -2,17 +2,24 @@
 #define ConsoleInputListener_h
 
 #include "IInputListener.h"
+#include "EscapeSequenceParser.h"
+#include "TerminalReader.h"
 #include <atomic>
 #include <string>
 
 // Console-based input listener that reads keyboard commands
-// Supports single-key input for quick navigation
+// Supports single-key input for quick navigation, plus the arrow, Home/End and
+// PageUp/PageDown keys (escape sequences on POSIX terminals)
 class ConsoleInputListener : public IInputListener
 {
 public:
-    ConsoleInputListener();
+    // fd: input to read (standard input by default; ignored on Windows, which reads the console)
+    explicit ConsoleInputListener(int fd = 0);
     ~ConsoleInputListener() override;
 
+    ConsoleInputListener(const ConsoleInputListener&) = delete;
+    ConsoleInputListener& operator=(const ConsoleInputListener&) = delete;
+
     void startListening() override;
     void stopListening() override;
     NavigationCommand pollCommand() override;
@@ -27,6 +34,17 @@ private:
 
     // Convert a character input to a navigation command
     NavigationCommand charToCommand(char c) const;
+
+#ifdef _WIN32
+    // Read one key, decoding the two-byte codes of the arrow and paging keys
+    NavigationCommand readConsoleKey();
+#else
+    TerminalReader m_reader;
+    EscapeSequenceParser m_parser;
+
+    // Next command, waiting up to timeoutMs for input (-1 waits indefinitely)
+    NavigationCommand nextCommand(int timeoutMs);
+#endif
 };
 
 #endif // ConsoleInputListener_h
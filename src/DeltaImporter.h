@@ -0,0 +1,274 @@
+#ifndef DELTAIMPORTER_H
+#define DELTAIMPORTER_H
+
+#include "LCDDisplayController.h"
+#include <algorithm>
+#include <charconv>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Streams an inventory delta file into a live controller instead of reloading everything.
+ *
+ * The delta format is line based:
+ *
+ *     # comment (blank lines are ignored too)
+ *     +<key><TAB><value>      upsert: set the item's value, or append a new item
+ *     -<key>                  delete the item
+ *
+ * Keys are resolved through the controller's key index (enabled on first use). The whole
+ * import is one batched mutation applied in bulk, like InventoryDiff::apply(): value changes
+ * are collected and applied together with setValues(), while deletes and new items are held
+ * back and applied once at the end with removeItems() and appendItems(), so item indices
+ * resolved while reading stay valid and the key index, views and filters are updated in
+ * one pass each. The selection is preserved, and a frame is only drawn if an affected row
+ * is on screen.
+ *
+ * @tparam TDisplayItem The DisplayItem type of the controller
+ */
+template<typename TDisplayItem>
+class DeltaImporter
+{
+public:
+    using Controller = LCDDisplayController<TDisplayItem>;
+    using KeyType = typename Controller::KeyType;
+    using ValueType = typename Controller::ValueType;
+
+    struct Stats
+    {
+        size_t updated = 0;     // Value changes applied to existing items
+        size_t inserted = 0;    // New items appended (or later deleted by the same import)
+        size_t removed = 0;     // Items deleted
+        size_t missing = 0;     // Deletes of unknown keys
+    };
+
+    /**
+     * @param controller Controller to apply deltas to
+     * @param flushSize Number of value changes collected before they are applied
+     */
+    explicit DeltaImporter(Controller& controller, size_t flushSize = 4096)
+        : controller(controller), flushSize(flushSize == 0 ? 1 : flushSize)
+    {
+    }
+
+    /**
+     * Import a delta stream. Throws std::invalid_argument on a malformed line; the lines
+     * before it have been applied.
+     */
+    Stats import(std::istream& input)
+    {
+        if (!controller.getKeyIndex())
+        {
+            controller.enableKeyIndex();
+        }
+
+        typename Controller::BatchScope batch(controller);
+        stats = Stats();
+        pending.clear();
+        removals.clear();
+        removedItems.assign(controller.getItemCount(), false);
+        additions.clear();
+        additionOf.clear();
+        deletedAdditions.clear();
+        std::string line;
+        size_t lineNumber = 0;
+        while (std::getline(input, line))
+        {
+            ++lineNumber;
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+            if (!applyLine(line))
+            {
+                flush();
+                throw std::invalid_argument("Malformed delta line " + std::to_string(lineNumber) +
+                                            ": " + line);
+            }
+        }
+        flush();
+        return stats;
+    }
+
+private:
+    Controller& controller;
+    size_t flushSize;
+    Stats stats;
+    std::vector<typename Controller::ValueUpdate> pending;  // Value changes not yet applied
+    std::vector<size_t> removals;                   // Existing items to delete
+    std::vector<bool> removedItems;                 // Item index -> listed in removals
+    std::vector<TDisplayItem> additions;            // New items to append, in delta order
+    std::unordered_map<KeyType, size_t> additionOf; // Key -> position in additions (live ones)
+    std::vector<bool> deletedAdditions;             // Additions deleted again before the end
+
+    template<typename T>
+    static bool parseField(const std::string& text, T& result)
+    {
+        if constexpr (std::is_same<T, std::string>::value)
+        {
+            result = text;
+            return !text.empty();
+        }
+        else if constexpr (std::is_integral<T>::value)
+        {
+            // Parse through a wide integer: streaming into a char-sized type (e.g., the
+            // uint8_t of InventoryDisplayItem) would read a single character
+            using Wide = typename std::conditional<std::is_signed<T>::value, long long,
+                                                   unsigned long long>::type;
+            size_t first = text.find_first_not_of(" \t");
+            size_t last = text.find_last_not_of(" \t");
+            if (first == std::string::npos)
+            {
+                return false;
+            }
+            Wide wide = 0;
+            const char* end = text.data() + last + 1;
+            auto parsed = std::from_chars(text.data() + first, end, wide);
+            if (parsed.ec != std::errc() || parsed.ptr != end ||
+                wide < static_cast<Wide>(std::numeric_limits<T>::min()) ||
+                wide > static_cast<Wide>(std::numeric_limits<T>::max()))
+            {
+                return false;
+            }
+            result = static_cast<T>(wide);
+            return true;
+        }
+        else
+        {
+            std::istringstream stream(text);
+            stream >> result;
+            return !stream.fail() && (stream >> std::ws).eof();
+        }
+    }
+
+    /**
+     * Index of an existing item with the key that is not deleted yet, or IItemView::noItem.
+     */
+    size_t findExisting(const KeyType& key) const
+    {
+        size_t itemIndex = controller.findItem(key);
+        return itemIndex < removedItems.size() && !removedItems[itemIndex] ? itemIndex
+                                                                          : IItemView::noItem;
+    }
+
+    bool applyLine(const std::string& line)
+    {
+        KeyType key;
+        if (line[0] == '-')
+        {
+            if (!parseField(line.substr(1), key))
+            {
+                return false;
+            }
+            auto addition = additionOf.find(key);
+            if (addition != additionOf.end())
+            {
+                deletedAdditions[addition->second] = true;
+                additionOf.erase(addition);
+                ++stats.removed;
+                return true;
+            }
+            size_t itemIndex = findExisting(key);
+            if (itemIndex == IItemView::noItem)
+            {
+                ++stats.missing;
+                return true;
+            }
+            removals.push_back(itemIndex);
+            removedItems[itemIndex] = true;
+            ++stats.removed;
+            return true;
+        }
+
+        size_t separator = line.find('\t');
+        ValueType value;
+        if (line[0] != '+' || separator == std::string::npos ||
+            !parseField(line.substr(1, separator - 1), key) ||
+            !parseField(line.substr(separator + 1), value))
+        {
+            return false;
+        }
+
+        auto addition = additionOf.find(key);
+        size_t itemIndex = addition == additionOf.end() ? findExisting(key) : IItemView::noItem;
+        if (addition != additionOf.end())
+        {
+            if (!(additions[addition->second].getValue() == value))
+            {
+                additions[addition->second].setValue(value);
+                ++stats.updated;
+            }
+        }
+        else if (itemIndex == IItemView::noItem)
+        {
+            additionOf.emplace(key, additions.size());
+            additions.emplace_back(key, value);
+            deletedAdditions.push_back(false);
+            ++stats.inserted;
+        }
+        else
+        {
+            pending.emplace_back(itemIndex, value);
+            if (pending.size() >= flushSize)
+            {
+                flushValues();
+            }
+        }
+        return true;
+    }
+
+    void flushValues()
+    {
+        if (!pending.empty())
+        {
+            stats.updated += controller.setValues(pending);
+            pending.clear();
+        }
+    }
+
+    /**
+     * Apply everything collected so far: values, then deletes, then new items.
+     */
+    void flush()
+    {
+        flushValues();
+        if (!removals.empty())
+        {
+            std::sort(removals.begin(), removals.end());
+            controller.removeItems(removals);
+            removals.clear();
+        }
+        removedItems.assign(controller.getItemCount(), false);
+
+        std::vector<TDisplayItem> appended;
+        appended.reserve(additions.size());
+        for (size_t i = 0; i < additions.size(); ++i)
+        {
+            if (!deletedAdditions[i])
+            {
+                appended.push_back(std::move(additions[i]));
+            }
+        }
+        additions.clear();
+        additionOf.clear();
+        deletedAdditions.clear();
+        if (!appended.empty())
+        {
+            controller.appendItems(appended);
+        }
+    }
+};
+
+#endif // DELTAIMPORTER_H
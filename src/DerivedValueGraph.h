@@ -0,0 +1,327 @@
+#ifndef DERIVEDVALUEGRAPH_H
+#define DERIVEDVALUEGRAPH_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Dependency graph for derived values (e.g., total = sum of a category, value x unit price).
+ *
+ * A derived item's value is a function of other items' values. Changes are collected with
+ * markChanged() and applied by propagate(), which recomputes only the derived items that
+ * depend on something that changed, in topological order (each node once per propagation,
+ * after all of its inputs). Nodes are bucketed by their depth in the graph, so no sort is
+ * needed per propagation.
+ *
+ * @tparam TValue Value type of the items
+ */
+template<typename TValue>
+class DerivedValueGraph
+{
+public:
+    using ComputeFunction = std::function<TValue(const std::vector<TValue>& inputs)>;
+
+private:
+    struct Node
+    {
+        std::vector<size_t> inputs;
+        ComputeFunction compute;
+        size_t level;           // 1 + highest input level (plain items are level 0)
+        bool pending;           // Queued for recomputation
+    };
+
+    std::unordered_map<size_t, Node> nodes;                     // Derived items only
+    std::unordered_map<size_t, std::vector<size_t>> dependents; // Item -> derived items using it
+    std::vector<std::vector<size_t>> pendingByLevel;            // Dirty derived items per level
+    std::vector<TValue> scratchInputs;                          // Reused input buffer
+
+    size_t levelOf(size_t itemIndex) const
+    {
+        auto node = nodes.find(itemIndex);
+        return (node == nodes.end()) ? 0 : node->second.level;
+    }
+
+    void queue(size_t itemIndex)
+    {
+        Node& node = nodes.at(itemIndex);
+        if (node.pending)
+        {
+            return;
+        }
+        node.pending = true;
+        if (pendingByLevel.size() <= node.level)
+        {
+            pendingByLevel.resize(node.level + 1);
+        }
+        pendingByLevel[node.level].push_back(itemIndex);
+    }
+
+    void unqueue(size_t itemIndex)
+    {
+        Node& node = nodes.at(itemIndex);
+        if (!node.pending)
+        {
+            return;
+        }
+        node.pending = false;
+        auto& bucket = pendingByLevel[node.level];
+        for (size_t i = 0; i < bucket.size(); ++i)
+        {
+            if (bucket[i] == itemIndex)
+            {
+                bucket[i] = bucket.back();
+                bucket.pop_back();
+                return;
+            }
+        }
+    }
+
+    bool dependsOn(size_t itemIndex, size_t target) const
+    {
+        // Depth-first search through inputs of derived items
+        std::vector<size_t> stack{itemIndex};
+        std::unordered_map<size_t, bool> visited;
+        while (!stack.empty())
+        {
+            size_t current = stack.back();
+            stack.pop_back();
+            if (current == target)
+            {
+                return true;
+            }
+            if (visited[current])
+            {
+                continue;
+            }
+            visited[current] = true;
+            auto node = nodes.find(current);
+            if (node != nodes.end())
+            {
+                stack.insert(stack.end(), node->second.inputs.begin(), node->second.inputs.end());
+            }
+        }
+        return false;
+    }
+
+    void unlinkInputs(size_t target, const std::vector<size_t>& inputs)
+    {
+        for (size_t input : inputs)
+        {
+            auto users = dependents.find(input);
+            if (users == dependents.end())
+            {
+                continue;
+            }
+            auto& list = users->second;
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                if (list[i] == target)
+                {
+                    list[i] = list.back();
+                    list.pop_back();
+                    break;
+                }
+            }
+            if (list.empty())
+            {
+                dependents.erase(users);
+            }
+        }
+    }
+
+    void updateLevels(size_t start)
+    {
+        std::vector<size_t> work{start};
+        while (!work.empty())
+        {
+            size_t current = work.back();
+            work.pop_back();
+            Node& node = nodes.at(current);
+
+            size_t level = 1;
+            for (size_t input : node.inputs)
+            {
+                size_t inputLevel = levelOf(input) + 1;
+                level = (inputLevel > level) ? inputLevel : level;
+            }
+            if (level == node.level && current != start)
+            {
+                continue;
+            }
+
+            // Keep queued nodes in the bucket matching their level
+            bool wasPending = node.pending;
+            unqueue(current);
+            node.level = level;
+            if (wasPending)
+            {
+                queue(current);
+            }
+
+            auto users = dependents.find(current);
+            if (users != dependents.end())
+            {
+                work.insert(work.end(), users->second.begin(), users->second.end());
+            }
+        }
+    }
+
+public:
+    /**
+     * Define (or redefine) a derived item.
+     * Throws std::invalid_argument if the definition would create a cycle.
+     *
+     * @param target Item whose value is derived
+     * @param inputs Items the value depends on (passed to compute in this order)
+     * @param compute Function computing the value from the inputs
+     */
+    void define(size_t target, std::vector<size_t> inputs, ComputeFunction compute)
+    {
+        if (!compute)
+        {
+            throw std::invalid_argument("Compute function cannot be empty");
+        }
+        for (size_t input : inputs)
+        {
+            if (input == target || dependsOn(input, target))
+            {
+                throw std::invalid_argument("Derived value definition creates a cycle");
+            }
+        }
+
+        auto existing = nodes.find(target);
+        if (existing != nodes.end())
+        {
+            unqueue(target);
+            unlinkInputs(target, existing->second.inputs);
+            existing->second.inputs = std::move(inputs);
+            existing->second.compute = std::move(compute);
+        }
+        else
+        {
+            existing = nodes.emplace(target, Node{std::move(inputs), std::move(compute), 1, false}).first;
+        }
+
+        for (size_t input : existing->second.inputs)
+        {
+            dependents[input].push_back(target);
+        }
+
+        updateLevels(target);
+        queue(target);
+    }
+
+    /**
+     * Remove a derived item definition (its current value is kept).
+     * @return true if the item was derived
+     */
+    bool remove(size_t target)
+    {
+        auto node = nodes.find(target);
+        if (node == nodes.end())
+        {
+            return false;
+        }
+
+        unqueue(target);
+        unlinkInputs(target, node->second.inputs);
+        nodes.erase(node);
+
+        // Items that used this one keep it as a plain input
+        auto users = dependents.find(target);
+        if (users != dependents.end())
+        {
+            for (size_t user : users->second)
+            {
+                updateLevels(user);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Note that an item's value changed; its derived dependents are queued. O(dependents).
+     */
+    void markChanged(size_t itemIndex)
+    {
+        auto users = dependents.find(itemIndex);
+        if (users == dependents.end())
+        {
+            return;
+        }
+        for (size_t user : users->second)
+        {
+            queue(user);
+        }
+    }
+
+    /**
+     * Recompute every queued derived item in topological order.
+     * A recomputed item that changes value queues its own dependents.
+     *
+     * @param getValue Callable (size_t item) -> TValue
+     * @param setValue Callable (size_t item, const TValue&) storing a changed value
+     * @return Number of derived items whose value changed
+     */
+    template<typename TGetValue, typename TSetValue>
+    size_t propagate(TGetValue getValue, TSetValue setValue)
+    {
+        size_t changedCount = 0;
+        std::vector<size_t> bucket;
+        for (size_t level = 1; level < pendingByLevel.size(); ++level)
+        {
+            // Dependents always have a higher level, so this bucket cannot grow meanwhile
+            bucket.swap(pendingByLevel[level]);
+            for (size_t itemIndex : bucket)
+            {
+                Node& node = nodes.at(itemIndex);
+                node.pending = false;
+
+                scratchInputs.clear();
+                for (size_t input : node.inputs)
+                {
+                    scratchInputs.push_back(getValue(input));
+                }
+                TValue value = node.compute(scratchInputs);
+                if (!(value == getValue(itemIndex)))
+                {
+                    setValue(itemIndex, value);
+                    markChanged(itemIndex);
+                    ++changedCount;
+                }
+            }
+            bucket.clear();
+        }
+        return changedCount;
+    }
+
+    /**
+     * Check if any derived item is waiting for recomputation.
+     */
+    bool hasPending() const
+    {
+        for (const auto& bucket : pendingByLevel)
+        {
+            if (!bucket.empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isDerived(size_t itemIndex) const
+    {
+        return nodes.find(itemIndex) != nodes.end();
+    }
+
+    size_t getDerivedCount() const
+    {
+        return nodes.size();
+    }
+};
+
+#endif // DERIVEDVALUEGRAPH_H
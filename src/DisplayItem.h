@@ -105,6 +105,32 @@ public:
         return formatToWidth(toString(value), ValueWidth);
     }
 
+    // Get unformatted key text (before padding/truncation), e.g. for other display widths
+    std::string getKeyText() const
+    {
+        return toString(key);
+    }
+
+    // Get unformatted value text (before padding/truncation)
+    std::string getValueText() const
+    {
+        return toString(value);
+    }
+
+    // Append text to a line, padded or truncated to the given width (no temporaries)
+    static void appendToWidth(std::string& line, const std::string& text, size_t width)
+    {
+        if (text.length() >= width)
+        {
+            line.append(text, 0, width);
+        }
+        else
+        {
+            line += text;
+            line.append(width - text.length(), ' ');
+        }
+    }
+
     // Compile-time accessors for widths
     static constexpr size_t getKeyWidth() { return KeyWidth; }
     static constexpr size_t getValueWidth() { return ValueWidth; }
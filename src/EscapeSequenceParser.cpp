@@ -0,0 +1,158 @@
+#include "EscapeSequenceParser.h"
+#include "KeyBindings.h"
+
+namespace
+{
+    const char escapeChar = '\x1B';
+}
+
+EscapeSequenceParser::EscapeSequenceParser()
+    : m_state(State::Ground), m_firstParameter(0), m_inFirstParameter(true)
+{
+}
+
+NavigationCommand EscapeSequenceParser::feed(char c)
+{
+    switch (m_state)
+    {
+    case State::Ground:
+        if (c == escapeChar)
+        {
+            m_state = State::Escape;
+            return NavigationCommand::None;
+        }
+        return keyToCommand(c);
+
+    case State::Escape:
+        if (c == '[')
+        {
+            m_state = State::Csi;
+            m_firstParameter = 0;
+            m_inFirstParameter = true;
+            return NavigationCommand::None;
+        }
+        if (c == 'O')
+        {
+            m_state = State::Ss3;
+            return NavigationCommand::None;
+        }
+        if (c == escapeChar)
+        {
+            // Escape pressed twice: the first one stands alone
+            return NavigationCommand::Deselect;
+        }
+        // Alt+key arrives as ESC key: treat it as the key
+        m_state = State::Ground;
+        return keyToCommand(c);
+
+    case State::Csi:
+        if (c >= '0' && c <= '9')
+        {
+            if (m_inFirstParameter && m_firstParameter < 1000)
+            {
+                m_firstParameter = m_firstParameter * 10 + static_cast<unsigned>(c - '0');
+            }
+            return NavigationCommand::None;
+        }
+        if (c == ';' || c == ':')
+        {
+            // Modifier and further parameters are ignored
+            m_inFirstParameter = false;
+            return NavigationCommand::None;
+        }
+        if (c >= 0x20 && c <= 0x3F)
+        {
+            // Other parameter and intermediate bytes
+            return NavigationCommand::None;
+        }
+        m_state = State::Ground;
+        if (c == '~')
+        {
+            return tildeToCommand(m_firstParameter);
+        }
+        if (c >= 0x40 && c <= 0x7E)
+        {
+            return finalToCommand(c);
+        }
+        // Not a valid sequence: drop it and treat the byte as a plain key
+        return (c == escapeChar) ? feed(c) : keyToCommand(c);
+
+    case State::Ss3:
+        m_state = State::Ground;
+        return finalToCommand(c);
+    }
+    return NavigationCommand::None;
+}
+
+size_t EscapeSequenceParser::parse(const char* data, size_t length, NavigationCommand* out)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        NavigationCommand command = feed(data[i]);
+        if (command != NavigationCommand::None)
+        {
+            out[count++] = command;
+        }
+    }
+    return count;
+}
+
+bool EscapeSequenceParser::isPending() const
+{
+    return m_state != State::Ground;
+}
+
+NavigationCommand EscapeSequenceParser::timeout()
+{
+    State state = m_state;
+    m_state = State::Ground;
+    return (state == State::Escape) ? NavigationCommand::Deselect : NavigationCommand::None;
+}
+
+void EscapeSequenceParser::reset()
+{
+    m_state = State::Ground;
+}
+
+NavigationCommand EscapeSequenceParser::finalToCommand(char final)
+{
+    switch (final)
+    {
+    case 'A':
+        return NavigationCommand::Up;
+    case 'B':
+        return NavigationCommand::Down;
+    case 'C':
+        return NavigationCommand::Increment;
+    case 'D':
+        return NavigationCommand::Decrement;
+    case 'H':
+        return NavigationCommand::First;
+    case 'F':
+        return NavigationCommand::Last;
+    default:
+        // Function keys (ESC O P..S) and others have no binding
+        return NavigationCommand::None;
+    }
+}
+
+NavigationCommand EscapeSequenceParser::tildeToCommand(unsigned parameter)
+{
+    switch (parameter)
+    {
+    case 1:
+    case 7:
+        return NavigationCommand::First;
+    case 4:
+    case 8:
+        return NavigationCommand::Last;
+    case 5:
+        return NavigationCommand::PageUp;
+    case 6:
+        return NavigationCommand::PageDown;
+    default:
+        // Insert, Delete and F5 and above have no binding
+        return NavigationCommand::None;
+    }
+}
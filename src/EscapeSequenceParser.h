@@ -0,0 +1,55 @@
+#ifndef EscapeSequenceParser_h
+#define EscapeSequenceParser_h
+
+#include "IInputListener.h"
+#include <cstddef>
+
+// State machine turning raw terminal input into navigation commands.
+// Understands plain keys (see KeyBindings.h) and ANSI/xterm sequences for the arrow, Home,
+// End, PageUp, PageDown and function keys, in both CSI (ESC [) and SS3 (ESC O) forms,
+// with or without modifier parameters. Up/Down navigate, Right/Left increment/decrement,
+// and a lone Escape deselects. No allocation; one byte is processed per call.
+class EscapeSequenceParser
+{
+public:
+    // Recommended wait for the rest of a sequence before treating Escape as a key
+    static constexpr int escapeTimeoutMs = 25;
+
+    EscapeSequenceParser();
+
+    // Process one byte; returns the command it completes, or None
+    // (inside a sequence, or for keys without a binding)
+    NavigationCommand feed(char c);
+
+    // Process a block of input, writing one entry per completed command.
+    // out must have room for length entries; returns the number written.
+    size_t parse(const char* data, size_t length, NavigationCommand* out);
+
+    // True while an escape sequence is incomplete. If no more input arrives within
+    // the escape timeout, call timeout(): a lone Escape is then the Escape key.
+    bool isPending() const;
+
+    // End an incomplete sequence; returns the command for a lone Escape (Deselect) or None
+    NavigationCommand timeout();
+
+    // Reset to the initial state, dropping any incomplete sequence
+    void reset();
+
+private:
+    enum class State
+    {
+        Ground,     // Plain keys
+        Escape,     // After ESC
+        Csi,        // After ESC [
+        Ss3         // After ESC O
+    };
+
+    State m_state;
+    unsigned m_firstParameter;      // First numeric parameter of a CSI sequence
+    bool m_inFirstParameter;
+
+    static NavigationCommand finalToCommand(char final);
+    static NavigationCommand tildeToCommand(unsigned parameter);
+};
+
+#endif // EscapeSequenceParser_h
@@ -0,0 +1,117 @@
+#ifndef FENWICKTREE_H
+#define FENWICKTREE_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Fenwick (binary indexed) tree over non-negative counts.
+ * Point updates, prefix sums and "which element contains position p" are O(log n),
+ * which is what row mapping needs when groups of rows are collapsed or expanded.
+ */
+class FenwickTree
+{
+private:
+    std::vector<size_t> tree;   // 1-based internal layout, tree[0] unused
+    size_t highestPowerOfTwo;
+
+public:
+    FenwickTree()
+        : tree(1, 0), highestPowerOfTwo(0)
+    {
+    }
+
+    /**
+     * Build from initial counts in O(n).
+     */
+    explicit FenwickTree(const std::vector<size_t>& counts)
+        : tree(counts.size() + 1, 0), highestPowerOfTwo(1)
+    {
+        for (size_t i = 1; i <= counts.size(); ++i)
+        {
+            tree[i] += counts[i - 1];
+            size_t parent = i + (i & (0 - i));
+            if (parent <= counts.size())
+            {
+                tree[parent] += tree[i];
+            }
+        }
+        while (highestPowerOfTwo * 2 <= counts.size())
+        {
+            highestPowerOfTwo *= 2;
+        }
+        if (counts.empty())
+        {
+            highestPowerOfTwo = 0;
+        }
+    }
+
+    size_t size() const
+    {
+        return tree.size() - 1;
+    }
+
+    /**
+     * Add an amount to one element.
+     */
+    void add(size_t index, size_t amount)
+    {
+        for (size_t i = index + 1; i < tree.size(); i += i & (0 - i))
+        {
+            tree[i] += amount;
+        }
+    }
+
+    /**
+     * Subtract an amount from one element (at most the element's current count).
+     */
+    void subtract(size_t index, size_t amount)
+    {
+        for (size_t i = index + 1; i < tree.size(); i += i & (0 - i))
+        {
+            tree[i] -= amount;
+        }
+    }
+
+    /**
+     * Sum of the first count elements.
+     */
+    size_t prefixSum(size_t count) const
+    {
+        size_t sum = 0;
+        for (size_t i = count; i > 0; i -= i & (0 - i))
+        {
+            sum += tree[i];
+        }
+        return sum;
+    }
+
+    /**
+     * Sum of all elements.
+     */
+    size_t total() const
+    {
+        return prefixSum(size());
+    }
+
+    /**
+     * Find the element containing a position, i.e. the smallest index with
+     * prefixSum(index + 1) > position. Returns size() if position >= total().
+     */
+    size_t findByPosition(size_t position) const
+    {
+        size_t index = 0;
+        for (size_t step = highestPowerOfTwo; step > 0; step >>= 1)
+        {
+            size_t next = index + step;
+            if (next < tree.size() && tree[next] <= position)
+            {
+                index = next;
+                position -= tree[next];
+            }
+        }
+        return index;
+    }
+};
+
+#endif // FENWICKTREE_H
@@ -0,0 +1,74 @@
+#include "FileValueSource.h"
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+FileValueSource::FileValueSource(const std::string& path)
+    : m_path(path), m_fd(-1), m_divisor(1.0)
+{
+#ifndef _WIN32
+    m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0)
+    {
+        throw std::runtime_error("Cannot open value source: " + path);
+    }
+#endif
+}
+
+FileValueSource::~FileValueSource()
+{
+#ifndef _WIN32
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+    }
+#endif
+}
+
+double FileValueSource::read() const
+{
+    char buffer[64];
+    size_t length = 0;
+
+#ifdef _WIN32
+    std::ifstream file(m_path);
+    file.read(buffer, sizeof(buffer) - 1);
+    length = static_cast<size_t>(file.gcount());
+#else
+    ssize_t bytesRead = ::pread(m_fd, buffer, sizeof(buffer) - 1, 0);
+    if (bytesRead < 0)
+    {
+        throw std::runtime_error("Cannot read value source: " + m_path);
+    }
+    length = static_cast<size_t>(bytesRead);
+#endif
+
+    buffer[length] = '\0';
+    char* end = nullptr;
+    double value = std::strtod(buffer, &end);
+    if (end == buffer)
+    {
+        throw std::runtime_error("Value source is not numeric: " + m_path);
+    }
+    return value / m_divisor;
+}
+
+void FileValueSource::setDivisor(double divisor)
+{
+    if (divisor == 0.0)
+    {
+        throw std::invalid_argument("Divisor cannot be zero");
+    }
+    m_divisor = divisor;
+}
+
+const std::string& FileValueSource::getPath() const
+{
+    return m_path;
+}
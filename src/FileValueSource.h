@@ -0,0 +1,39 @@
+#ifndef FILEVALUESOURCE_H
+#define FILEVALUESOURCE_H
+
+#include <string>
+
+/**
+ * Reads a numeric value from a small text file such as a sysfs attribute or /proc entry.
+ * The file is opened once and re-read from offset 0 on every sample, which is how sysfs
+ * expects attributes to be polled and avoids an open/close pair per reading.
+ */
+class FileValueSource
+{
+public:
+    explicit FileValueSource(const std::string& path);
+    ~FileValueSource();
+
+    FileValueSource(const FileValueSource&) = delete;
+    FileValueSource& operator=(const FileValueSource&) = delete;
+
+    /**
+     * Read the current value (the first number in the file, scaled by divisor).
+     * Throws std::runtime_error if the file cannot be read or does not start with a number.
+     */
+    double read() const;
+
+    /**
+     * Set a divisor applied to each reading (e.g., 1000 for millidegree temperatures).
+     */
+    void setDivisor(double divisor);
+
+    const std::string& getPath() const;
+
+private:
+    std::string m_path;
+    int m_fd;
+    double m_divisor;
+};
+
+#endif // FILEVALUESOURCE_H
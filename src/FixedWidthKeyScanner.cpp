@@ -0,0 +1,180 @@
+#include "FixedWidthKeyScanner.h"
+#include "BitOps.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FIXEDWIDTHKEYSCANNER_SSE2 1
+#endif
+
+FixedWidthKeyScanner::FixedWidthKeyScanner(size_t minStride)
+    : m_slots(padding, '\0'), m_stride(minStride == 0 ? 1 : minStride), m_count(0)
+{
+}
+
+size_t FixedWidthKeyScanner::getKeyCount() const
+{
+    return m_count;
+}
+
+void FixedWidthKeyScanner::getKey(size_t index, std::string& out) const
+{
+    std::string_view key = getKey(index);
+    out.assign(key.data(), key.size());
+}
+
+std::string_view FixedWidthKeyScanner::getKey(size_t index) const
+{
+    if (index >= m_count)
+    {
+        throw std::out_of_range("Key index out of range");
+    }
+    const char* key = slot(index);
+    return std::string_view(key, std::find(key, key + m_stride, '\0') - key);
+}
+
+void FixedWidthKeyScanner::append(std::string_view key)
+{
+    insert(m_count, key);
+}
+
+void FixedWidthKeyScanner::insert(size_t index, std::string_view key)
+{
+    if (index > m_count)
+    {
+        throw std::out_of_range("Key index out of range");
+    }
+    if (key.find('\0') != std::string_view::npos)
+    {
+        throw std::invalid_argument("Keys cannot contain NUL characters");
+    }
+    ensureStride(key.size());
+
+    m_slots.insert(m_slots.begin() + static_cast<std::ptrdiff_t>(index * m_stride), m_stride, '\0');
+    std::memcpy(slot(index), key.data(), key.size());
+    ++m_count;
+}
+
+void FixedWidthKeyScanner::remove(size_t index)
+{
+    if (index >= m_count)
+    {
+        throw std::out_of_range("Key index out of range");
+    }
+    auto begin = m_slots.begin() + static_cast<std::ptrdiff_t>(index * m_stride);
+    m_slots.erase(begin, begin + static_cast<std::ptrdiff_t>(m_stride));
+    --m_count;
+}
+
+size_t FixedWidthKeyScanner::getStride() const
+{
+    return m_stride;
+}
+
+bool FixedWidthKeyScanner::contains(size_t index, std::string_view pattern) const
+{
+    return getKey(index).find(pattern) != std::string_view::npos;
+}
+
+size_t FixedWidthKeyScanner::scan(std::string_view pattern, size_t first, size_t last,
+                                  std::vector<size_t>& matches) const
+{
+    last = std::min(last, m_count);
+    if (first >= last)
+    {
+        return 0;
+    }
+    if (pattern.empty())
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            matches.push_back(i);
+        }
+        return last - first;
+    }
+    if (pattern.size() > m_stride || pattern.find('\0') != std::string_view::npos)
+    {
+        return 0;
+    }
+
+#ifdef FIXEDWIDTHKEYSCANNER_SSE2
+    size_t length = pattern.size();
+    const __m128i firstByte = _mm_set1_epi8(pattern.front());
+    const __m128i lastByte = _mm_set1_epi8(pattern.back());
+    const char* data = m_slots.data();
+    size_t end = last * m_stride;
+    size_t before = matches.size();
+
+    size_t position = first * m_stride;
+    while (position + length <= end)
+    {
+        // The last-byte load reads at most padding - 1 bytes past the final slot
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position + length - 1));
+        uint64_t candidates = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, firstByte), _mm_cmpeq_epi8(tail, lastByte))));
+
+        size_t next = position + 16;
+        while (candidates != 0)
+        {
+            size_t hit = position + countTrailingZeros(candidates);
+            candidates &= candidates - 1;
+            size_t offset = hit % m_stride;
+            if (hit + length <= end && offset + length <= m_stride &&
+                std::memcmp(data + hit + 1, pattern.data() + 1, length - 1) == 0)
+            {
+                // Padding is NUL and patterns cannot match NUL, so the hit is inside the key
+                matches.push_back(hit / m_stride);
+                next = hit - offset + m_stride;
+                break;
+            }
+        }
+        position = next;
+    }
+    return matches.size() - before;
+#else
+    return scanScalar(pattern, first, last, matches);
+#endif
+}
+
+size_t FixedWidthKeyScanner::scanScalar(std::string_view pattern, size_t first, size_t last,
+                                        std::vector<size_t>& matches) const
+{
+    size_t before = matches.size();
+    for (size_t i = first; i < last; ++i)
+    {
+        if (contains(i, pattern))
+        {
+            matches.push_back(i);
+        }
+    }
+    return matches.size() - before;
+}
+
+char* FixedWidthKeyScanner::slot(size_t index)
+{
+    return m_slots.data() + index * m_stride;
+}
+
+const char* FixedWidthKeyScanner::slot(size_t index) const
+{
+    return m_slots.data() + index * m_stride;
+}
+
+void FixedWidthKeyScanner::ensureStride(size_t length)
+{
+    if (length <= m_stride)
+    {
+        return;
+    }
+    size_t newStride = std::max(length, m_stride * 2);
+    std::vector<char> slots(m_count * newStride + padding, '\0');
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        std::memcpy(slots.data() + i * newStride, slot(i), m_stride);
+    }
+    m_slots.swap(slots);
+    m_stride = newStride;
+}
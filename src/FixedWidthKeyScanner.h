@@ -0,0 +1,73 @@
+#ifndef FIXEDWIDTHKEYSCANNER_H
+#define FIXEDWIDTHKEYSCANNER_H
+
+#include "IKeyColumn.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Key column stored as fixed-width, zero-padded slots, searchable for substrings.
+ *
+ * All keys live back to back in one buffer with a fixed stride, so a substring scan is a
+ * single pass over contiguous memory. With SSE2 the scan compares 16 positions at a time
+ * against the first and last byte of the pattern and only verifies positions where both
+ * match (rare for real text); other targets fall back to a scalar search per key. A hit
+ * ends the scan of its key, and hits that would run past the end of a slot are rejected.
+ *
+ * The stride grows (re-laying out the buffer) when a key longer than it is added.
+ */
+class FixedWidthKeyScanner : public IKeyColumn
+{
+public:
+    /**
+     * @param minStride Initial slot width (e.g., the display key width)
+     */
+    explicit FixedWidthKeyScanner(size_t minStride = 16);
+
+    size_t getKeyCount() const override;
+    void getKey(size_t index, std::string& out) const override;
+
+    std::string_view getKey(size_t index) const;
+
+    void append(std::string_view key);
+
+    /**
+     * Insert a key before index (later keys shift up). O(n) like an item insertion.
+     */
+    void insert(size_t index, std::string_view key);
+
+    /**
+     * Remove a key (later keys shift down). O(n) like an item removal.
+     */
+    void remove(size_t index);
+
+    size_t getStride() const;
+
+    /**
+     * Check if the key at index contains a pattern.
+     */
+    bool contains(size_t index, std::string_view pattern) const;
+
+    /**
+     * Append the indices of keys in [first, last) that contain a pattern, in order.
+     * An empty pattern matches every key.
+     * @return Number of indices appended
+     */
+    size_t scan(std::string_view pattern, size_t first, size_t last, std::vector<size_t>& matches) const;
+
+private:
+    static constexpr size_t padding = 16;   // Zero bytes after the last slot for 16-byte loads
+
+    std::vector<char> m_slots;              // m_count slots of m_stride bytes, then padding
+    size_t m_stride;
+    size_t m_count;
+
+    char* slot(size_t index);
+    const char* slot(size_t index) const;
+    void ensureStride(size_t length);
+    size_t scanScalar(std::string_view pattern, size_t first, size_t last, std::vector<size_t>& matches) const;
+};
+
+#endif // FIXEDWIDTHKEYSCANNER_H
@@ -0,0 +1,183 @@
+#include "FrontCodedKeyStore.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+FrontCodedKeyStore::FrontCodedKeyStore(const std::vector<std::string>& sortedKeys, size_t blockSize)
+    : m_count(sortedKeys.size()), m_blockSize(blockSize),
+      m_cursorIndex(notFound), m_cursorNext(0)
+{
+    if (blockSize == 0)
+    {
+        throw std::invalid_argument("Block size must be at least 1");
+    }
+
+    const std::string* previous = nullptr;
+    for (size_t i = 0; i < sortedKeys.size(); ++i)
+    {
+        const std::string& key = sortedKeys[i];
+        if (previous && key < *previous)
+        {
+            throw std::invalid_argument("Keys must be sorted");
+        }
+
+        size_t shared = 0;
+        if (i % blockSize == 0)
+        {
+            if (m_data.size() > std::numeric_limits<uint32_t>::max())
+            {
+                throw std::length_error("Key store exceeds 4 GB");
+            }
+            m_restarts.push_back(static_cast<uint32_t>(m_data.size()));
+        }
+        else
+        {
+            size_t limit = std::min(key.size(), previous->size());
+            while (shared < limit && key[shared] == (*previous)[shared])
+            {
+                ++shared;
+            }
+        }
+
+        appendVarint(m_data, shared);
+        appendVarint(m_data, key.size() - shared);
+        m_data.insert(m_data.end(), key.begin() + shared, key.end());
+        previous = &key;
+    }
+    m_data.shrink_to_fit();
+    m_restarts.shrink_to_fit();
+}
+
+void FrontCodedKeyStore::appendVarint(std::vector<uint8_t>& data, size_t value)
+{
+    while (value >= 0x80)
+    {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+size_t FrontCodedKeyStore::readVarint(size_t& offset) const
+{
+    size_t value = 0;
+    unsigned shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = m_data[offset++];
+        value |= static_cast<size_t>(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+void FrontCodedKeyStore::decodeEntry(size_t& offset, std::string& key) const
+{
+    size_t shared = readVarint(offset);
+    size_t suffixLength = readVarint(offset);
+    key.resize(shared);
+    key.append(reinterpret_cast<const char*>(&m_data[offset]), suffixLength);
+    offset += suffixLength;
+}
+
+void FrontCodedKeyStore::seek(size_t index) const
+{
+    // Continue from the cursor when it is earlier in the same block, else from the restart point
+    size_t block = index / m_blockSize;
+    if (m_cursorIndex == notFound || m_cursorIndex > index || m_cursorIndex / m_blockSize != block)
+    {
+        m_cursorIndex = block * m_blockSize;
+        m_cursorNext = m_restarts[block];
+        decodeEntry(m_cursorNext, m_cursorKey);
+    }
+    while (m_cursorIndex < index)
+    {
+        decodeEntry(m_cursorNext, m_cursorKey);
+        ++m_cursorIndex;
+    }
+}
+
+size_t FrontCodedKeyStore::getKeyCount() const
+{
+    return m_count;
+}
+
+void FrontCodedKeyStore::getKey(size_t index, std::string& out) const
+{
+    if (index >= m_count)
+    {
+        throw std::out_of_range("Key index out of range");
+    }
+    seek(index);
+    out.assign(m_cursorKey);
+}
+
+std::string FrontCodedKeyStore::getKey(size_t index) const
+{
+    std::string key;
+    getKey(index, key);
+    return key;
+}
+
+size_t FrontCodedKeyStore::lowerBound(const std::string& key) const
+{
+    // Last block whose restart key is less than the key
+    size_t low = 0;
+    size_t high = m_restarts.size();
+    std::string restartKey;
+    while (low < high)
+    {
+        size_t mid = (low + high) / 2;
+        size_t offset = m_restarts[mid];
+        decodeEntry(offset, restartKey);
+        if (restartKey < key)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if (low == 0)
+    {
+        return 0;
+    }
+
+    // Scan that block for the first key not less than the key
+    size_t block = low - 1;
+    size_t index = block * m_blockSize;
+    size_t end = std::min(index + m_blockSize, m_count);
+    size_t offset = m_restarts[block];
+    std::string current;
+    for (; index < end; ++index)
+    {
+        decodeEntry(offset, current);
+        if (!(current < key))
+        {
+            return index;
+        }
+    }
+    return index;
+}
+
+size_t FrontCodedKeyStore::find(const std::string& key) const
+{
+    size_t index = lowerBound(key);
+    if (index < m_count && getKey(index) == key)
+    {
+        return index;
+    }
+    return notFound;
+}
+
+size_t FrontCodedKeyStore::getByteSize() const
+{
+    return m_data.size() + m_restarts.size() * sizeof(uint32_t);
+}
+
+size_t FrontCodedKeyStore::getBlockSize() const
+{
+    return m_blockSize;
+}
@@ -0,0 +1,77 @@
+#ifndef FRONTCODEDKEYSTORE_H
+#define FRONTCODEDKEYSTORE_H
+
+#include "IKeyColumn.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * Read-mostly store of sorted keys using front coding.
+ *
+ * Keys are grouped in blocks; the first key of a block (its restart point) is stored in full
+ * and every other key as the length of the prefix it shares with the previous key plus the
+ * remaining suffix. Catalogs with long common prefixes ("WIDGET-BLUE-...") shrink to a
+ * fraction of their std::string size.
+ *
+ * Random access decodes from the nearest restart point (at most blockSize keys), key lookup
+ * is a binary search over restart points, and reading consecutive keys - as a render of the
+ * visible window does - decodes one entry per key. The sequential-read position is cached
+ * internally, so a store must not be read from several threads at once.
+ */
+class FrontCodedKeyStore : public IKeyColumn
+{
+public:
+    static constexpr size_t notFound = static_cast<size_t>(-1);
+
+    /**
+     * @param sortedKeys Keys in ascending order (duplicates allowed)
+     * @param blockSize Keys per block (restart interval)
+     * @throws std::invalid_argument if keys are not sorted or blockSize is 0
+     */
+    explicit FrontCodedKeyStore(const std::vector<std::string>& sortedKeys, size_t blockSize = 16);
+
+    size_t getKeyCount() const override;
+    void getKey(size_t index, std::string& out) const override;
+
+    /**
+     * Get a key as a new string.
+     */
+    std::string getKey(size_t index) const;
+
+    /**
+     * Get the index of the first key not less than the given key (getKeyCount() if none).
+     * O(log blocks + blockSize).
+     */
+    size_t lowerBound(const std::string& key) const;
+
+    /**
+     * Get the index of a key, or notFound.
+     */
+    size_t find(const std::string& key) const;
+
+    /**
+     * Get the encoded size in bytes (entries plus restart table).
+     */
+    size_t getByteSize() const;
+
+    size_t getBlockSize() const;
+
+private:
+    std::vector<uint8_t> m_data;        // Encoded entries: varint shared, varint suffix length, suffix
+    std::vector<uint32_t> m_restarts;   // Offset of the first entry of each block
+    size_t m_count;
+    size_t m_blockSize;
+
+    // Sequential-read cursor: the key at m_cursorIndex and the offset of the entry after it
+    mutable size_t m_cursorIndex;
+    mutable size_t m_cursorNext;
+    mutable std::string m_cursorKey;
+
+    static void appendVarint(std::vector<uint8_t>& data, size_t value);
+    size_t readVarint(size_t& offset) const;
+    void decodeEntry(size_t& offset, std::string& key) const;
+    void seek(size_t index) const;
+};
+
+#endif // FRONTCODEDKEYSTORE_H
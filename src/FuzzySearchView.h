@@ -0,0 +1,168 @@
+#ifndef FUZZYSEARCHVIEW_H
+#define FUZZYSEARCHVIEW_H
+
+#include "IItemView.h"
+#include "TrigramIndex.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/**
+ * Item view listing the items whose keys are closest to a possibly mistyped query,
+ * best match first (e.g., "SKU-10432" finds "SKU-10423").
+ *
+ * Keys are indexed in a TrigramIndex that follows item insertions and removals, so the
+ * view stays valid while the inventory changes. Call the controller's refreshView() after
+ * setQuery().
+ *
+ * @tparam TDisplayItem The DisplayItem type
+ */
+template<typename TDisplayItem>
+class FuzzySearchView : public IItemView
+{
+public:
+    /**
+     * @param items Items of the controller the view is installed on
+     * @param maxResults Number of ranked matches shown
+     * @param maxDistance Largest number of typos (edits) tolerated
+     */
+    explicit FuzzySearchView(const std::vector<TDisplayItem>& items, size_t maxResults = 20,
+                             size_t maxDistance = 2)
+        : items(&items), maxResults(maxResults), maxDistance(maxDistance)
+    {
+        for (const auto& item : items)
+        {
+            index.append(item.getKeyText());
+        }
+    }
+
+    /**
+     * Search for a query; an empty query shows no rows.
+     */
+    void setQuery(const std::string& newQuery)
+    {
+        query = newQuery;
+        results = index.search(query, maxResults, maxDistance);
+    }
+
+    const std::string& getQuery() const
+    {
+        return query;
+    }
+
+    /**
+     * Get the ranked matches (item index and edit distance), best first.
+     */
+    const std::vector<TrigramIndex::Match>& getResults() const
+    {
+        return results;
+    }
+
+    size_t getRowCount() const override
+    {
+        return results.size();
+    }
+
+    size_t getItemAtRow(size_t row) const override
+    {
+        return (row < results.size()) ? results[row].itemIndex : noItem;
+    }
+
+    size_t getRowOfItem(size_t itemIndex) const override
+    {
+        for (size_t row = 0; row < results.size(); ++row)
+        {
+            if (results[row].itemIndex == itemIndex)
+            {
+                return row;
+            }
+        }
+        return noItem;
+    }
+
+    std::string getRowLabel(size_t row) const override
+    {
+        (void)row;
+        return std::string();
+    }
+
+    bool activateRow(size_t row) override
+    {
+        (void)row;
+        return false;
+    }
+
+    /**
+     * The new item may rank among the results, so the query is run again.
+     */
+    void itemInserted(size_t itemIndex) override
+    {
+        index.insert(itemIndex, (*items)[itemIndex].getKeyText());
+        results = index.search(query, maxResults, maxDistance);
+    }
+
+    void itemRemoved(size_t itemIndex) override
+    {
+        index.remove(itemIndex);
+        std::vector<TrigramIndex::Match> remaining;
+        for (auto match : results)
+        {
+            if (match.itemIndex != itemIndex)
+            {
+                match.itemIndex -= (match.itemIndex > itemIndex) ? 1 : 0;
+                remaining.push_back(match);
+            }
+        }
+        results.swap(remaining);
+    }
+
+    /**
+     * The index is rebuilt from the remaining keys once instead of removing keys one by one.
+     */
+    void itemsRemoved(const std::vector<size_t>& itemIndices) override
+    {
+        TrigramIndex kept;
+        size_t next = 0;
+        for (size_t i = 0; i < items->size(); ++i)
+        {
+            if (next < itemIndices.size() && itemIndices[next] == i)
+            {
+                ++next;
+                continue;
+            }
+            kept.append((*items)[i].getKeyText());
+        }
+        index = std::move(kept);
+
+        std::vector<TrigramIndex::Match> remaining;
+        for (auto match : results)
+        {
+            auto position = std::lower_bound(itemIndices.begin(), itemIndices.end(), match.itemIndex);
+            if (position == itemIndices.end() || *position != match.itemIndex)
+            {
+                match.itemIndex -= static_cast<size_t>(position - itemIndices.begin());
+                remaining.push_back(match);
+            }
+        }
+        results.swap(remaining);
+    }
+
+    void itemsAppended(size_t firstIndex, size_t count) override
+    {
+        for (size_t i = firstIndex; i < firstIndex + count; ++i)
+        {
+            index.append((*items)[i].getKeyText());
+        }
+        results = index.search(query, maxResults, maxDistance);
+    }
+
+private:
+    const std::vector<TDisplayItem>* items;
+    TrigramIndex index;
+    size_t maxResults;
+    size_t maxDistance;
+    std::string query;
+    std::vector<TrigramIndex::Match> results;   // Ranked matches shown as rows
+};
+
+#endif // FUZZYSEARCHVIEW_H
@@ -0,0 +1,41 @@
+#ifndef IDISPLAYPAGE_H
+#define IDISPLAYPAGE_H
+
+/**
+ * Interface for a logical page that can be shown on a physical display.
+ * Implemented by display controllers so that containers such as PagedDisplay
+ * can switch between them without knowing their item types.
+ */
+class IDisplayPage
+{
+public:
+    virtual ~IDisplayPage() = default;
+
+    /**
+     * Render the page (only marks it dirty while hidden).
+     */
+    virtual void render() = 0;
+
+    /**
+     * Show or hide the page. Becoming visible renders one frame if the page is dirty.
+     * @return true if visibility changed
+     */
+    virtual bool setVisible(bool shouldBeVisible) = 0;
+
+    /**
+     * Check if the page is currently visible.
+     */
+    virtual bool isVisible() const = 0;
+
+    /**
+     * Check if the page changed since its last rendered frame.
+     */
+    virtual bool isDirty() const = 0;
+
+    /**
+     * Mark the page dirty so that it repaints the next time it is shown.
+     */
+    virtual void invalidate() = 0;
+};
+
+#endif // IDISPLAYPAGE_H
@@ -10,6 +10,11 @@ enum class NavigationCommand
     Deselect,
     Increment,
     Decrement,
+    PageUp,
+    PageDown,
+    First,
+    Last,
+    SelectByKey,    // Jump to an item by key (e.g., a scanned code); the key comes from the listener
     None
 };
 
@@ -0,0 +1,106 @@
+#ifndef IITEMVIEW_H
+#define IITEMVIEW_H
+
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Interface mapping display rows to items.
+ *
+ * Without a view, row N shows item N. A view can reorder, filter or group items and
+ * insert rows that are not items (e.g., section headers). Controllers navigate rows and
+ * ask the view which item, if any, a row shows.
+ */
+class IItemView
+{
+public:
+    static constexpr size_t noItem = static_cast<size_t>(-1);
+
+    virtual ~IItemView() = default;
+
+    /**
+     * Get number of rows in the view.
+     */
+    virtual size_t getRowCount() const = 0;
+
+    /**
+     * Get the item shown on a row, or noItem for rows that are not items (headers).
+     */
+    virtual size_t getItemAtRow(size_t row) const = 0;
+
+    /**
+     * Get the row showing an item, or noItem if the item is not shown.
+     */
+    virtual size_t getRowOfItem(size_t itemIndex) const = 0;
+
+    /**
+     * Get the text of a row that is not an item (empty for item rows).
+     */
+    virtual std::string getRowLabel(size_t row) const = 0;
+
+    /**
+     * React to the user selecting a row that is not an item (e.g., expand a section).
+     * @return true if the rows of the view changed
+     */
+    virtual bool activateRow(size_t row) = 0;
+
+    /**
+     * React to the value of an item changing (e.g., re-check it against a filter).
+     * @return true if the rows of the view changed
+     */
+    virtual bool itemChanged(size_t itemIndex)
+    {
+        (void)itemIndex;
+        return false;
+    }
+
+    /**
+     * Keep the view in step with an item inserted at itemIndex (later items shift up).
+     * Called after the item was inserted. Views that cannot follow insertions throw
+     * std::logic_error.
+     */
+    virtual void itemInserted(size_t itemIndex)
+    {
+        (void)itemIndex;
+        throw std::logic_error("Item view does not support inserting items");
+    }
+
+    /**
+     * Keep the view in step with the item at itemIndex being removed (later items shift down).
+     * Views that cannot follow removals throw std::logic_error.
+     */
+    virtual void itemRemoved(size_t itemIndex)
+    {
+        (void)itemIndex;
+        throw std::logic_error("Item view does not support removing items");
+    }
+
+    /**
+     * Keep the view in step with several items being removed at once (ascending indices,
+     * called before the removal). The default removes them one by one, last first;
+     * views over large lists override it with a single pass.
+     */
+    virtual void itemsRemoved(const std::vector<size_t>& itemIndices)
+    {
+        for (auto itemIndex = itemIndices.rbegin(); itemIndex != itemIndices.rend(); ++itemIndex)
+        {
+            itemRemoved(*itemIndex);
+        }
+    }
+
+    /**
+     * Keep the view in step with count items appended at firstIndex (the old item count).
+     * Called after the items were appended. The default inserts them one by one.
+     */
+    virtual void itemsAppended(size_t firstIndex, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            itemInserted(firstIndex + i);
+        }
+    }
+};
+
+#endif // IITEMVIEW_H
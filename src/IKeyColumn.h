@@ -0,0 +1,31 @@
+#ifndef IKEYCOLUMN_H
+#define IKEYCOLUMN_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Interface for key text stored outside the items (e.g., a compressed catalog).
+ *
+ * A controller with a key column shows the column's text instead of each item's key,
+ * so large catalogs can keep their keys in a compact store and their items key-less.
+ * Lookups by item key (findItem(), the key index) are not available on such a controller;
+ * keys are resolved through the column instead.
+ */
+class IKeyColumn
+{
+public:
+    virtual ~IKeyColumn() = default;
+
+    /**
+     * Get number of keys in the column.
+     */
+    virtual size_t getKeyCount() const = 0;
+
+    /**
+     * Write the key of an item into a caller-provided buffer (its capacity is reused).
+     */
+    virtual void getKey(size_t index, std::string& out) const = 0;
+};
+
+#endif // IKEYCOLUMN_H
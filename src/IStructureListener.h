@@ -0,0 +1,30 @@
+#ifndef ISTRUCTURELISTENER_H
+#define ISTRUCTURELISTENER_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Interface for components that address a controller's items by index and must follow
+ * items being inserted or removed (e.g., PeriodicSampler sources).
+ *
+ * Listeners are notified after the controller's items changed, before the next frame.
+ */
+class IStructureListener
+{
+public:
+    virtual ~IStructureListener() = default;
+
+    /**
+     * Items [firstIndex, firstIndex + count) were inserted (later items shifted up by count).
+     */
+    virtual void itemsInserted(size_t firstIndex, size_t count) = 0;
+
+    /**
+     * The items at the given indices (ascending, before the removal) were removed;
+     * later items shifted down past them.
+     */
+    virtual void itemsRemoved(const std::vector<size_t>& itemIndices) = 0;
+};
+
+#endif // ISTRUCTURELISTENER_H
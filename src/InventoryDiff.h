@@ -0,0 +1,203 @@
+#ifndef INVENTORYDIFF_H
+#define INVENTORYDIFF_H
+
+#include "LCDDisplayController.h"
+#include "ParallelAlgorithms.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * Reconciliation diff between two item sets (e.g., the on-device inventory and an
+ * upstream export), matched by key. Keys are expected to be unique within each set.
+ *
+ * Both sets are brought into key order (skipped for input that is already sorted),
+ * the upstream order is cut into one piece per thread, and each piece is merged against
+ * the matching key range of the local set independently, so the work scales with cores.
+ *
+ * @tparam TDisplayItem The DisplayItem type of both sets
+ */
+template<typename TDisplayItem>
+class InventoryDiff
+{
+public:
+    using Controller = LCDDisplayController<TDisplayItem>;
+    using KeyType = typename Controller::KeyType;
+    using ValueType = typename Controller::ValueType;
+
+    struct Result
+    {
+        std::vector<TDisplayItem> added;                    // Upstream items missing locally
+        std::vector<size_t> removed;                        // Local items missing upstream (ascending)
+        std::vector<std::pair<size_t, ValueType>> changed;  // (local item index, upstream value)
+
+        bool empty() const
+        {
+            return added.empty() && removed.empty() && changed.empty();
+        }
+    };
+
+private:
+    /**
+     * Keys of a set and the item order that sorts them.
+     */
+    struct SortedSet
+    {
+        std::vector<KeyType> keys;      // keys[i] is the key of item i
+        std::vector<size_t> order;      // Item indices in key order
+    };
+
+    static SortedSet sortByKey(const std::vector<TDisplayItem>& items, WorkerPool* pool)
+    {
+        SortedSet set;
+        set.keys.resize(items.size());
+        set.order.resize(items.size());
+        auto extract = [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                set.keys[i] = items[i].getKey();
+                set.order[i] = i;
+            }
+        };
+        if (pool)
+        {
+            pool->parallelFor(items.size(), extract, 4096);
+        }
+        else
+        {
+            extract(0, items.size());
+        }
+
+        if (!std::is_sorted(set.keys.begin(), set.keys.end()))
+        {
+            auto byKey = [&set](size_t a, size_t b) { return set.keys[a] < set.keys[b]; };
+            if (pool)
+            {
+                parallelSort(*pool, set.order.begin(), set.order.end(), byKey);
+            }
+            else
+            {
+                std::sort(set.order.begin(), set.order.end(), byKey);
+            }
+        }
+        return set;
+    }
+
+    /**
+     * Merge one key range of both sets into a partial result.
+     */
+    static void diffRange(const std::vector<TDisplayItem>& local, const SortedSet& localSet,
+                          size_t localBegin, size_t localEnd,
+                          const std::vector<TDisplayItem>& upstream, const SortedSet& upstreamSet,
+                          size_t upstreamBegin, size_t upstreamEnd, Result& result)
+    {
+        size_t l = localBegin;
+        size_t u = upstreamBegin;
+        while (l < localEnd || u < upstreamEnd)
+        {
+            size_t localItem = (l < localEnd) ? localSet.order[l] : 0;
+            size_t upstreamItem = (u < upstreamEnd) ? upstreamSet.order[u] : 0;
+
+            if (u == upstreamEnd ||
+                (l < localEnd && localSet.keys[localItem] < upstreamSet.keys[upstreamItem]))
+            {
+                result.removed.push_back(localItem);
+                ++l;
+            }
+            else if (l == localEnd || upstreamSet.keys[upstreamItem] < localSet.keys[localItem])
+            {
+                result.added.push_back(upstream[upstreamItem]);
+                ++u;
+            }
+            else
+            {
+                const ValueType& upstreamValue = upstream[upstreamItem].getValue();
+                if (!(local[localItem].getValue() == upstreamValue))
+                {
+                    result.changed.emplace_back(localItem, upstreamValue);
+                }
+                ++l;
+                ++u;
+            }
+        }
+    }
+
+public:
+    /**
+     * Compute the changes that turn local into upstream.
+     * @param pool Optional worker pool; without one the diff runs on the calling thread
+     */
+    static Result compute(const std::vector<TDisplayItem>& local,
+                          const std::vector<TDisplayItem>& upstream,
+                          WorkerPool* pool = nullptr)
+    {
+        SortedSet localSet = sortByKey(local, pool);
+        SortedSet upstreamSet = sortByKey(upstream, pool);
+
+        // Cut the upstream order into pieces and find the matching local range of each
+        size_t pieceCount = pool ? pool->getConcurrency() * 4 : 1;
+        std::vector<size_t> upstreamBounds = splitRange(upstream.size(), pieceCount);
+        pieceCount = upstreamBounds.size() - 1;
+        std::vector<size_t> localBounds(pieceCount + 1);
+        localBounds[0] = 0;
+        localBounds[pieceCount] = local.size();
+        auto keyBefore = [&localSet](size_t item, const KeyType& key) { return localSet.keys[item] < key; };
+        for (size_t piece = 1; piece < pieceCount; ++piece)
+        {
+            const KeyType& splitKey = upstreamSet.keys[upstreamSet.order[upstreamBounds[piece]]];
+            localBounds[piece] = static_cast<size_t>(
+                std::lower_bound(localSet.order.begin(), localSet.order.end(), splitKey, keyBefore) -
+                localSet.order.begin());
+        }
+
+        std::vector<Result> partials(pieceCount);
+        auto diffPieces = [&](size_t begin, size_t end)
+        {
+            for (size_t piece = begin; piece < end; ++piece)
+            {
+                diffRange(local, localSet, localBounds[piece], localBounds[piece + 1],
+                          upstream, upstreamSet, upstreamBounds[piece], upstreamBounds[piece + 1],
+                          partials[piece]);
+            }
+        };
+        if (pool)
+        {
+            pool->parallelFor(pieceCount, diffPieces);
+        }
+        else
+        {
+            diffPieces(0, pieceCount);
+        }
+
+        Result result;
+        for (auto& partial : partials)
+        {
+            result.added.insert(result.added.end(), std::make_move_iterator(partial.added.begin()),
+                                std::make_move_iterator(partial.added.end()));
+            result.removed.insert(result.removed.end(), partial.removed.begin(), partial.removed.end());
+            result.changed.insert(result.changed.end(), partial.changed.begin(), partial.changed.end());
+        }
+        std::sort(result.removed.begin(), result.removed.end());
+        return result;
+    }
+
+    /**
+     * Apply a diff to a live controller as one bulk update (a single frame).
+     * Values are set first, then missing items removed, then new items appended, each
+     * as one bulk pass over the controller (O(n) in total, not per changed item);
+     * the selected item stays selected if it still exists.
+     */
+    static void apply(Controller& controller, const Result& diff)
+    {
+        typename Controller::BatchScope batch(controller);
+        controller.setValues(diff.changed);
+        controller.removeItems(diff.removed);
+        controller.appendItems(diff.added);
+    }
+};
+
+#endif // INVENTORYDIFF_H
@@ -0,0 +1,373 @@
+#include "ItemQuery.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+    struct Token
+    {
+        enum class Type { End, Word, Number, String, Operator, OpenParen, CloseParen };
+
+        Type type;
+        std::string text;
+        double number;
+        size_t position;
+    };
+
+    std::invalid_argument syntaxError(const std::string& message, size_t position)
+    {
+        return std::invalid_argument("Query syntax error at " + std::to_string(position) + ": " + message);
+    }
+
+    std::vector<Token> tokenize(const std::string& text)
+    {
+        std::vector<Token> tokens;
+        size_t i = 0;
+        while (i < text.size())
+        {
+            char c = text[i];
+            if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                ++i;
+                continue;
+            }
+
+            Token token{Token::Type::End, std::string(), 0.0, i};
+            if (c == '(' || c == ')')
+            {
+                token.type = (c == '(') ? Token::Type::OpenParen : Token::Type::CloseParen;
+                ++i;
+            }
+            else if (c == '<' || c == '>' || c == '=' || c == '!')
+            {
+                token.type = Token::Type::Operator;
+                token.text = c;
+                ++i;
+                if (i < text.size() && text[i] == '=')
+                {
+                    token.text += '=';
+                    ++i;
+                }
+                if (token.text == "!")
+                {
+                    throw syntaxError("expected '!='", token.position);
+                }
+                if (token.text == "==")
+                {
+                    token.text = "=";
+                }
+            }
+            else if (c == '"')
+            {
+                token.type = Token::Type::String;
+                ++i;
+                while (i < text.size() && text[i] != '"')
+                {
+                    if (text[i] == '\\' && i + 1 < text.size())
+                    {
+                        ++i;
+                    }
+                    token.text += text[i++];
+                }
+                if (i == text.size())
+                {
+                    throw syntaxError("unterminated string", token.position);
+                }
+                ++i;
+            }
+            else if (std::isdigit(static_cast<unsigned char>(c)) || c == '-' || c == '+' || c == '.')
+            {
+                const char* start = text.c_str() + i;
+                char* end = nullptr;
+                token.type = Token::Type::Number;
+                token.number = std::strtod(start, &end);
+                if (end == start)
+                {
+                    throw syntaxError("invalid number", token.position);
+                }
+                i += static_cast<size_t>(end - start);
+            }
+            else if (std::isalpha(static_cast<unsigned char>(c)))
+            {
+                token.type = Token::Type::Word;
+                while (i < text.size() && std::isalpha(static_cast<unsigned char>(text[i])))
+                {
+                    token.text += static_cast<char>(std::tolower(static_cast<unsigned char>(text[i++])));
+                }
+            }
+            else
+            {
+                throw syntaxError(std::string("unexpected '") + c + "'", token.position);
+            }
+            tokens.push_back(std::move(token));
+        }
+        tokens.push_back(Token{Token::Type::End, std::string(), 0.0, text.size()});
+        return tokens;
+    }
+
+    /**
+     * Recursive-descent parser emitting the postfix program.
+     */
+    class Parser
+    {
+    public:
+        Parser(const std::vector<Token>& tokens, std::vector<ItemQuery::Instruction>& program)
+            : m_tokens(tokens), m_program(program), m_next(0)
+        {
+        }
+
+        void parse()
+        {
+            parseOr();
+            if (peek().type != Token::Type::End)
+            {
+                throw syntaxError("unexpected input", peek().position);
+            }
+        }
+
+    private:
+        const std::vector<Token>& m_tokens;
+        std::vector<ItemQuery::Instruction>& m_program;
+        size_t m_next;
+
+        const Token& peek() const
+        {
+            return m_tokens[m_next];
+        }
+
+        bool acceptWord(const char* word)
+        {
+            if (peek().type == Token::Type::Word && peek().text == word)
+            {
+                ++m_next;
+                return true;
+            }
+            return false;
+        }
+
+        void emit(ItemQuery::Op op, double number = 0.0, std::string text = std::string())
+        {
+            m_program.push_back(ItemQuery::Instruction{op, number, std::move(text)});
+        }
+
+        void parseOr()
+        {
+            parseAnd();
+            while (acceptWord("or"))
+            {
+                parseAnd();
+                emit(ItemQuery::Op::Or);
+            }
+        }
+
+        void parseAnd()
+        {
+            parseNot();
+            while (acceptWord("and"))
+            {
+                parseNot();
+                emit(ItemQuery::Op::And);
+            }
+        }
+
+        void parseNot()
+        {
+            if (acceptWord("not"))
+            {
+                parseNot();
+                emit(ItemQuery::Op::Not);
+            }
+            else if (peek().type == Token::Type::OpenParen)
+            {
+                ++m_next;
+                parseOr();
+                if (peek().type != Token::Type::CloseParen)
+                {
+                    throw syntaxError("expected ')'", peek().position);
+                }
+                ++m_next;
+            }
+            else
+            {
+                parseComparison();
+            }
+        }
+
+        void parseComparison()
+        {
+            struct OperatorName
+            {
+                Token::Type type;
+                const char* text;
+                ItemQuery::Op op;
+            };
+            static const OperatorName valueOperators[] = {
+                {Token::Type::Operator, "<", ItemQuery::Op::ValueLess},
+                {Token::Type::Operator, "<=", ItemQuery::Op::ValueLessEqual},
+                {Token::Type::Operator, ">", ItemQuery::Op::ValueGreater},
+                {Token::Type::Operator, ">=", ItemQuery::Op::ValueGreaterEqual},
+                {Token::Type::Operator, "=", ItemQuery::Op::ValueEqual},
+                {Token::Type::Operator, "!=", ItemQuery::Op::ValueNotEqual}};
+            static const OperatorName keyOperators[] = {
+                {Token::Type::Word, "contains", ItemQuery::Op::KeyContains},
+                {Token::Type::Word, "startswith", ItemQuery::Op::KeyStartsWith},
+                {Token::Type::Operator, "=", ItemQuery::Op::KeyEquals},
+                {Token::Type::Operator, "!=", ItemQuery::Op::KeyNotEquals}};
+
+            size_t position = peek().position;
+            bool isValue = acceptWord("value");
+            if (!isValue && !acceptWord("key"))
+            {
+                throw syntaxError("expected value, key, NOT or '('", position);
+            }
+
+            const Token& op = peek();
+            const OperatorName* first = isValue ? std::begin(valueOperators) : std::begin(keyOperators);
+            const OperatorName* last = isValue ? std::end(valueOperators) : std::end(keyOperators);
+            const OperatorName* match = std::find_if(first, last, [&op](const OperatorName& name)
+            {
+                return name.type == op.type && op.text == name.text;
+            });
+            if (match == last)
+            {
+                throw syntaxError(isValue ? "expected <, <=, >, >=, = or !="
+                                          : "expected contains, startswith, = or !=", op.position);
+            }
+            ++m_next;
+
+            const Token& operand = peek();
+            if (operand.type != (isValue ? Token::Type::Number : Token::Type::String))
+            {
+                throw syntaxError(isValue ? "expected number" : "expected quoted text", operand.position);
+            }
+            ++m_next;
+            emit(match->op, operand.number, operand.text);
+        }
+    };
+}
+
+ItemQuery::ItemQuery()
+    : m_text(), m_program{Instruction{Op::All, 0.0, std::string()}}, m_stackDepth(1)
+{
+}
+
+ItemQuery::ItemQuery(const std::string& text)
+    : m_text(text), m_program(), m_stackDepth(0)
+{
+    std::vector<Token> tokens = tokenize(text);
+    if (tokens.size() == 1)
+    {
+        m_program.push_back(Instruction{Op::All, 0.0, std::string()});
+    }
+    else
+    {
+        Parser(tokens, m_program).parse();
+    }
+
+    size_t depth = 0;
+    for (const auto& instruction : m_program)
+    {
+        if (instruction.op == Op::And || instruction.op == Op::Or)
+        {
+            --depth;
+        }
+        else if (instruction.op != Op::Not)
+        {
+            m_stackDepth = std::max(m_stackDepth, ++depth);
+        }
+    }
+    if (m_stackDepth > maxStackDepth)
+    {
+        throw std::invalid_argument("Query is nested too deeply");
+    }
+}
+
+const std::string& ItemQuery::getText() const
+{
+    return m_text;
+}
+
+const std::vector<ItemQuery::Instruction>& ItemQuery::getProgram() const
+{
+    return m_program;
+}
+
+size_t ItemQuery::getScratchWords() const
+{
+    return m_stackDepth * tileWords;
+}
+
+bool ItemQuery::compareValue(Op op, double value, double operand)
+{
+    switch (op)
+    {
+        case Op::ValueLess: return value < operand;
+        case Op::ValueLessEqual: return value <= operand;
+        case Op::ValueGreater: return value > operand;
+        case Op::ValueGreaterEqual: return value >= operand;
+        case Op::ValueEqual: return value == operand;
+        case Op::ValueNotEqual: return value != operand;
+        default: return false;
+    }
+}
+
+bool ItemQuery::compareKey(Op op, std::string_view key, const std::string& operand)
+{
+    switch (op)
+    {
+        case Op::KeyContains: return key.find(operand) != std::string_view::npos;
+        case Op::KeyStartsWith: return key.substr(0, operand.size()) == operand;
+        case Op::KeyEquals: return key == operand;
+        case Op::KeyNotEquals: return key != operand;
+        default: return false;
+    }
+}
+
+void ItemQuery::containsKernel(const char* keyText, const uint32_t* keyOffsets, size_t count,
+                               const std::string& operand, uint64_t* out)
+{
+    // One pass over the tile's flat key buffer instead of a search per key; a hit that
+    // runs past the end of its key spans two keys and does not count
+    size_t words = (count + 63) / 64;
+    for (size_t w = 0; w < words; ++w)
+    {
+        out[w] = 0;
+    }
+    if (operand.empty())
+    {
+        for (size_t w = 0; w < words; ++w)
+        {
+            out[w] = ~uint64_t(0);
+        }
+        return;
+    }
+
+    std::string_view text(keyText + keyOffsets[0], keyOffsets[count] - keyOffsets[0]);
+    auto keyEnd = [keyOffsets](size_t item) { return size_t(keyOffsets[item + 1] - keyOffsets[0]); };
+    size_t item = 0;
+    size_t position = 0;
+    for (;;)
+    {
+        size_t hit = text.find(operand, position);
+        if (hit == std::string_view::npos)
+        {
+            break;
+        }
+        while (keyEnd(item) <= hit)
+        {
+            ++item;
+        }
+        if (hit + operand.size() <= keyEnd(item))
+        {
+            out[item / 64] |= uint64_t(1) << (item % 64);
+            position = keyEnd(item);
+        }
+        else
+        {
+            position = hit + 1;
+        }
+    }
+}
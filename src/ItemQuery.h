@@ -0,0 +1,256 @@
+#ifndef ITEMQUERY_H
+#define ITEMQUERY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Compiled item filter such as `value < 5 AND key contains "BOLT"`.
+ *
+ * Grammar (keywords are case-insensitive):
+ *
+ *     query      := or
+ *     or         := and ("OR" and)*
+ *     and        := not ("AND" not)*
+ *     not        := "NOT" not | "(" or ")" | comparison
+ *     comparison := "value" ("<" | "<=" | ">" | ">=" | "=" | "!=") number
+ *                 | "key" ("contains" | "startswith" | "=" | "!=") "quoted text"
+ *
+ * The query is compiled into a postfix program of column kernels. evaluateTile() runs the
+ * program over a tile of up to tileItems items stored as columns (a contiguous value array
+ * and a flat key buffer): each comparison fills a bitmap with a branchless loop the
+ * compiler vectorizes, and AND/OR/NOT combine bitmaps a 64-bit word at a time.
+ * An empty query matches every item. Throws std::invalid_argument on syntax errors and
+ * on queries nested deeper than maxStackDepth.
+ */
+class ItemQuery
+{
+public:
+    enum class Op
+    {
+        All,
+        ValueLess,
+        ValueLessEqual,
+        ValueGreater,
+        ValueGreaterEqual,
+        ValueEqual,
+        ValueNotEqual,
+        KeyContains,
+        KeyStartsWith,
+        KeyEquals,
+        KeyNotEquals,
+        And,
+        Or,
+        Not
+    };
+
+    struct Instruction
+    {
+        Op op;
+        double number;      // Operand of value comparisons
+        std::string text;   // Operand of key comparisons
+    };
+
+    static constexpr size_t tileWords = 64;
+    static constexpr size_t tileItems = tileWords * 64;
+    static constexpr size_t maxStackDepth = 32;
+
+    ItemQuery();
+    explicit ItemQuery(const std::string& text);
+
+    const std::string& getText() const;
+    const std::vector<Instruction>& getProgram() const;
+
+    /**
+     * Scratch words evaluateTile() needs (one tile bitmap per stack slot).
+     */
+    size_t getScratchWords() const;
+
+    /**
+     * Evaluate the query for a single item (used for incremental updates).
+     */
+    template<typename TValue>
+    bool matches(TValue value, std::string_view key) const;
+
+    /**
+     * Evaluate the query for items [first, first + count) of a column store.
+     * Item i has value values[i] and key keyText[keyOffsets[i], keyOffsets[i + 1]).
+     *
+     * @param count Number of items, at most tileItems
+     * @param out Receives (count + 63) / 64 bitmap words; bits past count are zero
+     * @param scratch getScratchWords() words of working storage
+     */
+    template<typename TValue>
+    void evaluateTile(const TValue* values, const char* keyText, const uint32_t* keyOffsets,
+                      size_t first, size_t count, uint64_t* out, uint64_t* scratch) const;
+
+private:
+    std::string m_text;
+    std::vector<Instruction> m_program;     // Postfix order
+    size_t m_stackDepth;
+
+    static bool compareValue(Op op, double value, double operand);
+    static bool compareKey(Op op, std::string_view key, const std::string& operand);
+
+    template<typename TValue, typename TCompare>
+    static void valueKernel(const TValue* values, size_t count, uint64_t* out, TCompare compare);
+
+    static void containsKernel(const char* keyText, const uint32_t* keyOffsets, size_t count,
+                               const std::string& operand, uint64_t* out);
+};
+
+template<typename TValue>
+bool ItemQuery::matches(TValue value, std::string_view key) const
+{
+    bool stack[maxStackDepth];
+    size_t depth = 0;
+    for (const auto& instruction : m_program)
+    {
+        bool result;
+        switch (instruction.op)
+        {
+            case Op::All:
+                result = true;
+                break;
+            case Op::And:
+                depth -= 2;
+                result = stack[depth] && stack[depth + 1];
+                break;
+            case Op::Or:
+                depth -= 2;
+                result = stack[depth] || stack[depth + 1];
+                break;
+            case Op::Not:
+                result = !stack[--depth];
+                break;
+            case Op::KeyContains:
+            case Op::KeyStartsWith:
+            case Op::KeyEquals:
+            case Op::KeyNotEquals:
+                result = compareKey(instruction.op, key, instruction.text);
+                break;
+            default:
+                result = compareValue(instruction.op, static_cast<double>(value), instruction.number);
+                break;
+        }
+        stack[depth++] = result;
+    }
+    return stack[0];
+}
+
+template<typename TValue, typename TCompare>
+void ItemQuery::valueKernel(const TValue* values, size_t count, uint64_t* out, TCompare compare)
+{
+    size_t word = 0;
+    for (size_t base = 0; base < count; base += 64, ++word)
+    {
+        size_t length = (count - base < 64) ? count - base : 64;
+        uint64_t bits = 0;
+        for (size_t bit = 0; bit < length; ++bit)
+        {
+            bits |= static_cast<uint64_t>(compare(static_cast<double>(values[base + bit]))) << bit;
+        }
+        out[word] = bits;
+    }
+}
+
+template<typename TValue>
+void ItemQuery::evaluateTile(const TValue* values, const char* keyText, const uint32_t* keyOffsets,
+                             size_t first, size_t count, uint64_t* out, uint64_t* scratch) const
+{
+    if (count == 0)
+    {
+        return;
+    }
+    size_t words = (count + 63) / 64;
+    uint64_t tailMask = (count % 64 == 0) ? ~uint64_t(0) : (uint64_t(1) << (count % 64)) - 1;
+    values += first;
+    size_t depth = 0;
+
+    for (const auto& instruction : m_program)
+    {
+        uint64_t* top = scratch + depth * tileWords;
+        double operand = instruction.number;
+        switch (instruction.op)
+        {
+            case Op::All:
+                for (size_t w = 0; w < words; ++w)
+                {
+                    top[w] = ~uint64_t(0);
+                }
+                break;
+            case Op::ValueLess:
+                valueKernel(values, count, top, [operand](double v) { return v < operand; });
+                break;
+            case Op::ValueLessEqual:
+                valueKernel(values, count, top, [operand](double v) { return v <= operand; });
+                break;
+            case Op::ValueGreater:
+                valueKernel(values, count, top, [operand](double v) { return v > operand; });
+                break;
+            case Op::ValueGreaterEqual:
+                valueKernel(values, count, top, [operand](double v) { return v >= operand; });
+                break;
+            case Op::ValueEqual:
+                valueKernel(values, count, top, [operand](double v) { return v == operand; });
+                break;
+            case Op::ValueNotEqual:
+                valueKernel(values, count, top, [operand](double v) { return v != operand; });
+                break;
+            case Op::KeyContains:
+                containsKernel(keyText, keyOffsets + first, count, instruction.text, top);
+                break;
+            case Op::KeyStartsWith:
+            case Op::KeyEquals:
+            case Op::KeyNotEquals:
+                for (size_t w = 0; w < words; ++w)
+                {
+                    top[w] = 0;
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    std::string_view key(keyText + keyOffsets[first + i],
+                                         keyOffsets[first + i + 1] - keyOffsets[first + i]);
+                    top[i / 64] |= static_cast<uint64_t>(compareKey(instruction.op, key, instruction.text))
+                                   << (i % 64);
+                }
+                break;
+            case Op::And:
+                top -= 2 * tileWords;
+                depth -= 2;
+                for (size_t w = 0; w < words; ++w)
+                {
+                    top[w] &= top[w + tileWords];
+                }
+                break;
+            case Op::Or:
+                top -= 2 * tileWords;
+                depth -= 2;
+                for (size_t w = 0; w < words; ++w)
+                {
+                    top[w] |= top[w + tileWords];
+                }
+                break;
+            case Op::Not:
+                top -= tileWords;
+                --depth;
+                for (size_t w = 0; w < words; ++w)
+                {
+                    top[w] = ~top[w];
+                }
+                break;
+        }
+        ++depth;
+    }
+
+    for (size_t w = 0; w < words; ++w)
+    {
+        out[w] = scratch[w];
+    }
+    out[words - 1] &= tailMask;
+}
+
+#endif // ITEMQUERY_H
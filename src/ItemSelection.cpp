@@ -0,0 +1,178 @@
+#include "ItemSelection.h"
+#include <algorithm>
+#include <stdexcept>
+
+ItemSelection::ItemSelection(size_t itemCount)
+    : m_words((itemCount + 63) / 64, 0), m_itemCount(itemCount), m_count(0)
+{
+}
+
+size_t ItemSelection::size() const
+{
+    return m_itemCount;
+}
+
+size_t ItemSelection::count() const
+{
+    return m_count;
+}
+
+bool ItemSelection::empty() const
+{
+    return m_count == 0;
+}
+
+bool ItemSelection::test(size_t itemIndex) const
+{
+    return itemIndex < m_itemCount && ((m_words[itemIndex / 64] >> (itemIndex % 64)) & 1) != 0;
+}
+
+void ItemSelection::set(size_t itemIndex, bool selected)
+{
+    validateItemIndex(itemIndex);
+    if (test(itemIndex) != selected)
+    {
+        toggle(itemIndex);
+    }
+}
+
+void ItemSelection::toggle(size_t itemIndex)
+{
+    validateItemIndex(itemIndex);
+    uint64_t bit = uint64_t(1) << (itemIndex % 64);
+    m_words[itemIndex / 64] ^= bit;
+    if (m_words[itemIndex / 64] & bit)
+    {
+        ++m_count;
+    }
+    else
+    {
+        --m_count;
+    }
+}
+
+void ItemSelection::setRange(size_t firstItem, size_t endItem, bool selected)
+{
+    if (firstItem > endItem || endItem > m_itemCount)
+    {
+        throw std::out_of_range("Item range out of range");
+    }
+    size_t item = firstItem;
+    while (item < endItem)
+    {
+        size_t word = item / 64;
+        size_t bitCount = std::min<size_t>(64 - item % 64, endItem - item);
+        uint64_t mask = (bitCount == 64) ? ~uint64_t(0) : ((uint64_t(1) << bitCount) - 1) << (item % 64);
+        m_count -= popCount(m_words[word] & mask);
+        if (selected)
+        {
+            m_words[word] |= mask;
+            m_count += bitCount;
+        }
+        else
+        {
+            m_words[word] &= ~mask;
+        }
+        item += bitCount;
+    }
+}
+
+void ItemSelection::clear()
+{
+    std::fill(m_words.begin(), m_words.end(), 0);
+    m_count = 0;
+}
+
+void ItemSelection::insertItem(size_t itemIndex)
+{
+    if (itemIndex > m_itemCount)
+    {
+        throw std::out_of_range("Item index out of range");
+    }
+    ++m_itemCount;
+    if (m_itemCount > m_words.size() * 64)
+    {
+        m_words.push_back(0);
+    }
+
+    size_t word = itemIndex / 64;
+    uint64_t below = (uint64_t(1) << (itemIndex % 64)) - 1;
+    uint64_t old = m_words[word];
+    m_words[word] = (old & below) | ((old & ~below) << 1);
+    uint64_t carry = old >> 63;
+    for (size_t w = word + 1; w < m_words.size(); ++w)
+    {
+        old = m_words[w];
+        m_words[w] = (old << 1) | carry;
+        carry = old >> 63;
+    }
+}
+
+void ItemSelection::removeItem(size_t itemIndex)
+{
+    validateItemIndex(itemIndex);
+    if (test(itemIndex))
+    {
+        --m_count;
+    }
+
+    size_t word = itemIndex / 64;
+    uint64_t below = (uint64_t(1) << (itemIndex % 64)) - 1;
+    for (size_t w = word; w < m_words.size(); ++w)
+    {
+        uint64_t next = (w + 1 < m_words.size()) ? m_words[w + 1] & 1 : 0;
+        uint64_t shifted = (m_words[w] >> 1) | (next << 63);
+        m_words[w] = (w == word) ? (m_words[w] & below) | (shifted & ~below) : shifted;
+    }
+    --m_itemCount;
+    m_words.resize((m_itemCount + 63) / 64);
+}
+
+void ItemSelection::removeItems(const std::vector<size_t>& itemIndices)
+{
+    if (itemIndices.empty())
+    {
+        return;
+    }
+    validateItemIndex(itemIndices.back());
+
+    std::vector<uint64_t> words((m_itemCount - itemIndices.size() + 63) / 64, 0);
+    size_t count = 0;
+    size_t removedBelow = 0;
+    forEach([&](size_t itemIndex)
+    {
+        while (removedBelow < itemIndices.size() && itemIndices[removedBelow] < itemIndex)
+        {
+            ++removedBelow;
+        }
+        if (removedBelow < itemIndices.size() && itemIndices[removedBelow] == itemIndex)
+        {
+            return;
+        }
+        size_t target = itemIndex - removedBelow;
+        words[target / 64] |= uint64_t(1) << (target % 64);
+        ++count;
+    });
+    m_words.swap(words);
+    m_itemCount -= itemIndices.size();
+    m_count = count;
+}
+
+void ItemSelection::appendItems(size_t count)
+{
+    m_itemCount += count;
+    m_words.resize((m_itemCount + 63) / 64, 0);
+}
+
+const std::vector<uint64_t>& ItemSelection::getWords() const
+{
+    return m_words;
+}
+
+void ItemSelection::validateItemIndex(size_t itemIndex) const
+{
+    if (itemIndex >= m_itemCount)
+    {
+        throw std::out_of_range("Item index out of range");
+    }
+}
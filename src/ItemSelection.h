@@ -0,0 +1,100 @@
+#ifndef ITEMSELECTION_H
+#define ITEMSELECTION_H
+
+#include "BitOps.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Set of selected (marked) items stored as a bitset, one bit per item.
+ *
+ * Ranges are set or cleared a 64-bit word at a time, and forEach() visits the selected
+ * items by scanning words and skipping empty ones, so sparse and dense selections over
+ * large lists both cost about one word operation per 64 items plus the selected items.
+ */
+class ItemSelection
+{
+public:
+    explicit ItemSelection(size_t itemCount = 0);
+
+    /**
+     * Get the number of items the selection covers.
+     */
+    size_t size() const;
+
+    /**
+     * Get the number of selected items. O(1).
+     */
+    size_t count() const;
+
+    bool empty() const;
+    /**
+     * Check whether an item is selected (false past the end).
+     */
+    bool test(size_t itemIndex) const;
+    void set(size_t itemIndex, bool selected = true);
+    void toggle(size_t itemIndex);
+
+    /**
+     * Select or deselect the items in [firstItem, endItem).
+     */
+    void setRange(size_t firstItem, size_t endItem, bool selected = true);
+
+    void clear();
+
+    /**
+     * Keep the selection in step with an item inserted at itemIndex (not selected).
+     */
+    void insertItem(size_t itemIndex);
+
+    /**
+     * Keep the selection in step with the item at itemIndex being removed.
+     */
+    void removeItem(size_t itemIndex);
+
+    /**
+     * Keep the selection in step with several items being removed (ascending indices),
+     * in one pass over the selected items.
+     */
+    void removeItems(const std::vector<size_t>& itemIndices);
+
+    /**
+     * Keep the selection in step with items appended at the end (not selected).
+     */
+    void appendItems(size_t count);
+
+    /**
+     * Call function(itemIndex) for every selected item, in item order.
+     */
+    template<typename TFunction>
+    void forEach(TFunction function) const;
+
+    /**
+     * Get the bitset words (bit i of word i / 64 is item i).
+     */
+    const std::vector<uint64_t>& getWords() const;
+
+private:
+    std::vector<uint64_t> m_words;
+    size_t m_itemCount;
+    size_t m_count;
+
+    void validateItemIndex(size_t itemIndex) const;
+};
+
+template<typename TFunction>
+void ItemSelection::forEach(TFunction function) const
+{
+    for (size_t word = 0; word < m_words.size(); ++word)
+    {
+        uint64_t bits = m_words[word];
+        while (bits != 0)
+        {
+            function(word * 64 + countTrailingZeros(bits));
+            bits &= bits - 1;
+        }
+    }
+}
+
+#endif // ITEMSELECTION_H
@@ -0,0 +1,158 @@
+#ifndef ITEMTEXTCACHE_H
+#define ITEMTEXTCACHE_H
+
+#include "IKeyColumn.h"
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+/**
+ * Small direct-mapped cache of the unformatted key/value text of recently rendered items.
+ *
+ * Converting keys and values to text is the expensive part of formatting a row, so the
+ * text is cached once per item and fitted to each geometry's widths when a row is built.
+ * Every viewport of a controller shares the same cache, and its size depends only on the
+ * number of visible rows, never on the number of items or geometries.
+ *
+ * Each entry keeps the key and value its text was made from and is only used while the
+ * item still has them, so items edited in place (e.g., through the controller's mutable
+ * getItems()) are never shown with stale text. Checking costs a key and value comparison
+ * per row instead of a conversion to text.
+ *
+ * @tparam TDisplayItem The DisplayItem type whose text is cached
+ */
+template<typename TDisplayItem>
+class ItemTextCache
+{
+private:
+    using KeyType = decltype(std::declval<const TDisplayItem&>().getKey());
+    using ValueType = decltype(std::declval<const TDisplayItem&>().getValue());
+
+    static constexpr size_t emptySlot = static_cast<size_t>(-1);
+
+    struct Entry
+    {
+        size_t itemIndex = emptySlot;
+        KeyType key = KeyType();        // Key and value the text was made from
+        ValueType value = ValueType();
+        std::string keyText;
+        std::string valueText;
+    };
+
+    std::vector<Entry> entries;     // Size is always a power of two
+    size_t mask;
+    const IKeyColumn* keyColumn;    // Key text source replacing item keys (optional)
+
+public:
+    explicit ItemTextCache(size_t minimumCapacity = 8)
+        : mask(0), keyColumn(nullptr)
+    {
+        reserve(minimumCapacity);
+    }
+
+    /**
+     * Grow the cache so that at least the given number of items fit without evicting each other.
+     */
+    void reserve(size_t minimumCapacity)
+    {
+        size_t capacity = 1;
+        while (capacity < minimumCapacity)
+        {
+            capacity <<= 1;
+        }
+        if (capacity > entries.size())
+        {
+            entries.assign(capacity, Entry());
+            mask = capacity - 1;
+        }
+    }
+
+    /**
+     * Get the cached entry for an item, converting its key and value to text on a miss.
+     */
+    const std::string& getKeyText(size_t itemIndex, const TDisplayItem& item)
+    {
+        return fetch(itemIndex, item).keyText;
+    }
+
+    const std::string& getValueText(size_t itemIndex, const TDisplayItem& item)
+    {
+        return fetch(itemIndex, item).valueText;
+    }
+
+    /**
+     * Drop the cached text of one item (call after its key or value changes).
+     */
+    void invalidate(size_t itemIndex)
+    {
+        Entry& entry = entries[itemIndex & mask];
+        if (entry.itemIndex == itemIndex)
+        {
+            entry.itemIndex = emptySlot;
+        }
+    }
+
+    /**
+     * Drop all cached text (call after items are modified in bulk).
+     */
+    void clear()
+    {
+        for (auto& entry : entries)
+        {
+            entry.itemIndex = emptySlot;
+        }
+    }
+
+    /**
+     * Take key text from a key column instead of the items (nullptr to use item keys).
+     * The column must outlive its use by the cache.
+     */
+    void setKeyColumn(const IKeyColumn* column)
+    {
+        keyColumn = column;
+        clear();
+    }
+
+    size_t capacity() const
+    {
+        return entries.size();
+    }
+
+private:
+    Entry& fetch(size_t itemIndex, const TDisplayItem& item)
+    {
+        Entry& entry = entries[itemIndex & mask];
+        if (entry.itemIndex != itemIndex)
+        {
+            entry.itemIndex = itemIndex;
+            if (keyColumn)
+            {
+                keyColumn->getKey(itemIndex, entry.keyText);
+            }
+            else
+            {
+                entry.key = item.getKey();
+                entry.keyText = item.getKeyText();
+            }
+            entry.value = item.getValue();
+            entry.valueText = item.getValueText();
+            return entry;
+        }
+
+        // Items may have been edited in place since the text was made
+        if (!keyColumn && !(entry.key == item.getKey()))
+        {
+            entry.key = item.getKey();
+            entry.keyText = item.getKeyText();
+        }
+        if (!(entry.value == item.getValue()))
+        {
+            entry.value = item.getValue();
+            entry.valueText = item.getValueText();
+        }
+        return entry;
+    }
+};
+
+#endif // ITEMTEXTCACHE_H
@@ -0,0 +1,49 @@
+#ifndef KeyBindings_h
+#define KeyBindings_h
+
+#include "IInputListener.h"
+#include <ostream>
+
+// Default single-key bindings shared by the console-style input listeners
+inline NavigationCommand keyToCommand(char c)
+{
+    switch (c)
+    {
+    case 'w':
+    case 'W':
+        return NavigationCommand::Up;
+    case 's':
+    case 'S':
+        return NavigationCommand::Down;
+    case 'e':
+    case 'E':
+        return NavigationCommand::Select;
+    case 'q':
+    case 'Q':
+        return NavigationCommand::Deselect;
+    case 'd':
+    case 'D':
+        return NavigationCommand::Increment;
+    case 'a':
+    case 'A':
+        return NavigationCommand::Decrement;
+    default:
+        return NavigationCommand::None;
+    }
+}
+
+// Print the default key bindings
+inline void printKeyBindings(std::ostream& out)
+{
+    out << "\n=== Navigation Controls ===" << std::endl;
+    out << "  w / W  : Navigate Up" << std::endl;
+    out << "  s / S  : Navigate Down" << std::endl;
+    out << "  e / E  : Select Item" << std::endl;
+    out << "  q / Q  : Deselect Item" << std::endl;
+    out << "  d / D  : Increment Value" << std::endl;
+    out << "  a / A  : Decrement Value" << std::endl;
+    out << "  x / X  : Exit" << std::endl;
+    out << "===========================\n" << std::endl;
+}
+
+#endif // KeyBindings_h
@@ -0,0 +1,234 @@
+#ifndef KEYSEARCHVIEW_H
+#define KEYSEARCHVIEW_H
+
+#include "IItemView.h"
+#include "FixedWidthKeyScanner.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/**
+ * Item view listing the items whose key contains a search pattern (type-ahead search).
+ *
+ * Keys are copied into a FixedWidthKeyScanner. The search runs incrementally: step()
+ * scans the next slice of keys and appends matches, so the UI loop can show the first
+ * hits immediately and keep the display responsive on large catalogs. Setting a new
+ * pattern cancels the running search. When the new pattern contains the previous one
+ * (the user typed more), the items already found are re-checked instead of scanned again
+ * and the search resumes where it stopped.
+ *
+ * Call the controller's refreshView() when setPattern() or step() report changed rows.
+ *
+ * @tparam TDisplayItem The DisplayItem type
+ */
+template<typename TDisplayItem>
+class KeySearchView : public IItemView
+{
+public:
+    /**
+     * @param items Items of the controller the view is installed on
+     */
+    explicit KeySearchView(const std::vector<TDisplayItem>& items)
+        : items(&items), scanner(TDisplayItem::getKeyWidth()), scanned(0)
+    {
+        for (const auto& item : items)
+        {
+            scanner.append(item.getKeyText());
+        }
+        scanned = scanner.getKeyCount();
+        for (size_t i = 0; i < scanned; ++i)
+        {
+            matches.push_back(i);
+        }
+    }
+
+    /**
+     * Start searching for a pattern (an empty pattern matches every item).
+     * @return true if the rows of the view changed
+     */
+    bool setPattern(const std::string& newPattern)
+    {
+        if (newPattern == pattern)
+        {
+            return false;
+        }
+        size_t previousCount = matches.size();
+        bool narrowing = !pattern.empty() && newPattern.find(pattern) != std::string::npos;
+        if (narrowing)
+        {
+            // Only items that matched so far can still match
+            matches.erase(std::remove_if(matches.begin(), matches.end(),
+                                         [this, &newPattern](size_t itemIndex)
+                                         {
+                                             return !scanner.contains(itemIndex, newPattern);
+                                         }),
+                          matches.end());
+        }
+        else
+        {
+            matches.clear();
+            scanned = 0;
+        }
+        pattern = newPattern;
+        return matches.size() != previousCount;
+    }
+
+    const std::string& getPattern() const
+    {
+        return pattern;
+    }
+
+    /**
+     * Scan up to itemBudget more keys for the current pattern.
+     * @return true if matches were added (the rows of the view changed)
+     */
+    bool step(size_t itemBudget)
+    {
+        size_t last = std::min(scanner.getKeyCount(), scanned + std::max<size_t>(itemBudget, 1));
+        size_t found = scanner.scan(pattern, scanned, last, matches);
+        scanned = last;
+        return found > 0;
+    }
+
+    /**
+     * Check if every key has been scanned for the current pattern.
+     */
+    bool isComplete() const
+    {
+        return scanned == scanner.getKeyCount();
+    }
+
+    /**
+     * Get the number of matches found so far.
+     */
+    size_t getMatchCount() const
+    {
+        return matches.size();
+    }
+
+    size_t getRowCount() const override
+    {
+        return matches.size();
+    }
+
+    size_t getItemAtRow(size_t row) const override
+    {
+        return (row < matches.size()) ? matches[row] : noItem;
+    }
+
+    size_t getRowOfItem(size_t itemIndex) const override
+    {
+        auto it = std::lower_bound(matches.begin(), matches.end(), itemIndex);
+        return (it != matches.end() && *it == itemIndex) ? static_cast<size_t>(it - matches.begin()) : noItem;
+    }
+
+    std::string getRowLabel(size_t row) const override
+    {
+        (void)row;
+        return std::string();
+    }
+
+    bool activateRow(size_t row) override
+    {
+        (void)row;
+        return false;
+    }
+
+    void itemInserted(size_t itemIndex) override
+    {
+        scanner.insert(itemIndex, (*items)[itemIndex].getKeyText());
+        auto it = std::lower_bound(matches.begin(), matches.end(), itemIndex);
+        for (auto shifted = it; shifted != matches.end(); ++shifted)
+        {
+            ++*shifted;
+        }
+        if (itemIndex < scanned || scanned == scanner.getKeyCount() - 1)
+        {
+            // Behind the scan position: check it now; otherwise the scan will reach it
+            ++scanned;
+            if (scanner.contains(itemIndex, pattern))
+            {
+                matches.insert(it, itemIndex);
+            }
+        }
+    }
+
+    void itemRemoved(size_t itemIndex) override
+    {
+        scanner.remove(itemIndex);
+        auto it = std::lower_bound(matches.begin(), matches.end(), itemIndex);
+        if (it != matches.end() && *it == itemIndex)
+        {
+            it = matches.erase(it);
+        }
+        for (; it != matches.end(); ++it)
+        {
+            --*it;
+        }
+        if (itemIndex < scanned)
+        {
+            --scanned;
+        }
+    }
+
+    /**
+     * The remaining keys are copied into a new scanner and the matches renumbered, in one pass.
+     */
+    void itemsRemoved(const std::vector<size_t>& itemIndices) override
+    {
+        FixedWidthKeyScanner kept(TDisplayItem::getKeyWidth());
+        size_t next = 0;
+        for (size_t i = 0; i < scanner.getKeyCount(); ++i)
+        {
+            if (next < itemIndices.size() && itemIndices[next] == i)
+            {
+                ++next;
+                continue;
+            }
+            kept.append(scanner.getKey(i));
+        }
+        scanner = std::move(kept);
+
+        size_t row = 0;
+        next = 0;
+        for (size_t itemIndex : matches)
+        {
+            while (next < itemIndices.size() && itemIndices[next] < itemIndex)
+            {
+                ++next;
+            }
+            if (next < itemIndices.size() && itemIndices[next] == itemIndex)
+            {
+                continue;
+            }
+            matches[row++] = itemIndex - next;
+        }
+        matches.resize(row);
+        scanned -= static_cast<size_t>(
+            std::lower_bound(itemIndices.begin(), itemIndices.end(), scanned) - itemIndices.begin());
+    }
+
+    void itemsAppended(size_t firstIndex, size_t count) override
+    {
+        bool complete = isComplete();
+        for (size_t i = firstIndex; i < firstIndex + count; ++i)
+        {
+            scanner.append((*items)[i].getKeyText());
+        }
+        if (complete)
+        {
+            // A finished search checks the new keys now; otherwise the scan will reach them
+            scanner.scan(pattern, scanned, scanner.getKeyCount(), matches);
+            scanned = scanner.getKeyCount();
+        }
+    }
+
+private:
+    const std::vector<TDisplayItem>* items;
+    FixedWidthKeyScanner scanner;
+    std::string pattern;
+    std::vector<size_t> matches;    // Matching item indices in item order
+    size_t scanned;                 // Keys [0, scanned) have been checked for the pattern
+};
+
+#endif // KEYSEARCHVIEW_H
@@ -4,10 +4,29 @@
 #include "DisplayItem.h"
 #include "DisplayConfig.h"
 #include "IRenderer.h"
+#include "IDisplayPage.h"
+#include "IItemView.h"
+#include "ItemTextCache.h"
+#include "ValueHistory.h"
+#include "BarGlyphs.h"
+#include "ValueFilter.h"
+#include "DerivedValueGraph.h"
+#include "PositionIndicator.h"
+#include "IKeyColumn.h"
+#include "ConcurrentKeyIndex.h"
+#include "ItemSelection.h"
+#include "IStructureListener.h"
 #include <vector>
 #include <memory>
 #include <stdexcept>
 #include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <unordered_map>
+#include <chrono>
+#include <exception>
+#include <atomic>
+#include <cstdint>
 
 /**
  * Generic LCD Display Controller using templates with scrolling support.
@@ -24,15 +43,66 @@
  * @tparam TDisplayItem The DisplayItem type (includes key type, value type, and widths)
  */
 template<typename TDisplayItem>
-class LCDDisplayController
+class LCDDisplayController : public IDisplayPage
 {
+public:
+    using ValueType = decltype(std::declval<const TDisplayItem&>().getValue());
+    using KeyType = decltype(std::declval<const TDisplayItem&>().getKey());
+    using Clock = std::chrono::steady_clock;
+    using ValueUpdate = std::pair<size_t, ValueType>;   // (item index, new value)
+
 private:
+    /**
+     * A secondary geometry showing the same items and selection as the primary display.
+     * Holds only its own window position and line buffers; items and cached text are shared.
+     */
+    struct Viewport
+    {
+        std::shared_ptr<IRenderer> renderer;
+        DisplayConfig config;
+        size_t keyWidth;
+        size_t valueWidth;
+        size_t windowStartRow;
+        std::vector<std::string> frameLines;
+        PositionIndicator indicator;
+    };
+
     DisplayConfig config;
     std::vector<TDisplayItem> items;
     std::shared_ptr<IRenderer> renderer;
-    size_t selectedItemIndex;   // Index into items vector (0 to items.size()-1)
-    size_t windowStartIndex;    // Index of first visible item in the window
+    std::shared_ptr<IItemView> view;    // Optional row mapping (null: row N shows item N)
+    size_t selectedRow;         // Row of the navigator (0 to getRowCount()-1)
+    size_t selectedItemIndex;   // Item shown on the selected row (IItemView::noItem for headers)
+    size_t windowStartRow;      // First row visible in the window
     bool isSelected;
+    bool visible;               // False while the backlight is off or the page is not shown
+    bool dirty;                 // True when the model changed since the last rendered frame
+    size_t batchDepth;          // Nesting depth of beginBatch()/endBatch()
+    bool batchRenderPending;    // A render was requested inside the current batch
+    std::vector<std::string> frameLines;    // Frame buffer reused between renders
+    std::vector<Viewport> viewports;        // Secondary geometries driven by the same model
+    ItemTextCache<TDisplayItem> textCache;  // Item text shared by all geometries
+    std::shared_ptr<const IKeyColumn> keyColumn;    // Optional key text replacing item keys
+    std::shared_ptr<ConcurrentKeyIndex<KeyType>> keyIndex;  // Optional key-to-item index
+    std::unique_ptr<ValueHistory<>> history;    // Optional per-item value history
+    size_t sparklineWidth;                      // Sparkline columns after the value (0 = none)
+    BarGlyphs sparklineGlyphs;
+
+    // Noise filters for live values, keyed by item index (only sensor-fed items have one)
+    using FilterType = ValueFilter<typename std::conditional<
+        std::is_arithmetic<ValueType>::value, ValueType, double>::type>;
+    std::unordered_map<size_t, FilterType> valueFilters;
+
+    DerivedValueGraph<ValueType> derivedValues;     // Items computed from other items
+
+    bool positionIndicatorEnabled;          // Scroll position shown in the last column
+    PositionIndicator positionIndicator;    // Indicator of the primary display
+
+    ItemSelection markedItems;  // Multi-selection for bulk operations
+    char markChar;              // Navigator column glyph of marked rows
+
+    std::vector<IStructureListener*> structureListeners;    // Notified of inserts and removals
+    std::atomic<uint64_t> structureGeneration;  // Bumped whenever existing items change index
 
     /**
      * Get the row position of the selected item within the visible window.
@@ -40,46 +110,106 @@ private:
      */
     size_t getNavigatorRowInWindow() const
     {
-        return selectedItemIndex - windowStartIndex;
+        return selectedRow - windowStartRow;
     }
 
     /**
-     * Format a single row for display.
-     * @param rowIndex The row index within the visible window (0 to config.rows-1)
+     * Get number of navigable rows (items, plus header rows of a view).
      */
-    std::string formatRow(size_t rowIndex) const
+    size_t rowCount() const
     {
-        std::string line;
-        size_t itemIndex = windowStartIndex + rowIndex;
-        
-        // Add navigator character (only on selected row)
-        line += (rowIndex == getNavigatorRowInWindow()) ? config.navigatorChar : ' ';
+        return view ? view->getRowCount() : items.size();
+    }
+
+    /**
+     * Get the item shown on a row, or IItemView::noItem.
+     */
+    size_t itemAtRow(size_t row) const
+    {
+        if (view)
+        {
+            return (row < view->getRowCount()) ? view->getItemAtRow(row) : IItemView::noItem;
+        }
+        return (row < items.size()) ? row : IItemView::noItem;
+    }
+
+    /**
+     * Get the row showing an item, or IItemView::noItem.
+     */
+    size_t rowOfItem(size_t itemIndex) const
+    {
+        if (view)
+        {
+            return view->getRowOfItem(itemIndex);
+        }
+        return (itemIndex < items.size()) ? itemIndex : IItemView::noItem;
+    }
+
+    /**
+     * Move the navigator to a row and keep every window around it.
+     */
+    void moveSelection(size_t row)
+    {
+        selectedRow = row;
+        selectedItemIndex = view ? itemAtRow(row) : row;
+        adjustWindow();
+    }
+
+    /**
+     * Format a single row for display into a reusable line buffer.
+     * @param geometry Configuration of the display being rendered
+     * @param windowStart Index of the first item visible on that display
+     * @param keyWidth Width of the key field on that display
+     * @param valueWidth Width of the value field on that display
+     * @param indicator Position indicator drawn in the last column (nullptr for none)
+     * @param rowIndex The row index within the visible window (0 to geometry.rows-1)
+     * @param line Line buffer to overwrite (its capacity is reused between frames)
+     */
+    void formatRow(const DisplayConfig& geometry, size_t windowStart, size_t keyWidth,
+                   size_t valueWidth, const PositionIndicator* indicator,
+                   size_t rowIndex, std::string& line)
+    {
+        size_t contentColumns = indicator ? geometry.columns - 1 : geometry.columns;
+        line.clear();
+        size_t row = windowStart + rowIndex;
         
-        // Add key and value with separator
-        if (itemIndex < items.size())
+        // Add navigator character (only on selected row); other marked rows show the mark
+        size_t itemIndex = itemAtRow(row);
+        if (row == selectedRow)
         {
-            line += items[itemIndex].getFormattedKey();
-            line += config.separatorChar;
-            line += items[itemIndex].getFormattedValue();
+            line += geometry.navigatorChar;
         }
         else
         {
-            // Fill empty rows with spaces (no item at this row)
-            size_t remainingSpace = (config.columns > 1) ? config.columns - 1 : 0;
-            line += std::string(remainingSpace, ' ');
+            line += markedItems.test(itemIndex) ? markChar : ' ';
         }
         
-        // Ensure exact column width (pad or truncate)
-        if (line.length() < config.columns)
+        // Add key and value with separator
+        if (itemIndex < items.size())
         {
-            line += std::string(config.columns - line.length(), ' ');
+            const TDisplayItem& item = items[itemIndex];
+            TDisplayItem::appendToWidth(line, textCache.getKeyText(itemIndex, item), keyWidth);
+            line += geometry.separatorChar;
+            TDisplayItem::appendToWidth(line, textCache.getValueText(itemIndex, item), valueWidth);
+
+            // Sparkline goes in the spare columns of geometries that have room for it
+            if (history && sparklineWidth > 0 && line.length() + sparklineWidth <= contentColumns)
+            {
+                history->appendSparkline(itemIndex, sparklineWidth, sparklineGlyphs, line);
+            }
         }
-        else if (line.length() > config.columns)
+        else if (view && row < view->getRowCount())
         {
-            line = line.substr(0, config.columns);
+            // Rows that are not items (section headers) show the view's label
+            line += view->getRowLabel(row);
         }
         
-        return line;
+        // Ensure exact column width (pad empty space or truncate)
+        line.resize(contentColumns, ' ');
+        if (indicator)
+        {
+            line += indicator->glyphAt(rowIndex);
+        }
     }
 
     /**
@@ -94,27 +224,235 @@ private:
     }
 
     /**
-     * Adjust the visible window to ensure the selected item is visible.
+     * Move a window so that the selected row is visible within the given number of rows.
+     */
+    void adjustWindowStart(size_t& windowStart, size_t rows) const
+    {
+        // If selected row is above the window, scroll up
+        if (selectedRow < windowStart)
+        {
+            windowStart = selectedRow;
+        }
+        // If selected row is below the window, scroll down
+        else if (selectedRow >= windowStart + rows)
+        {
+            windowStart = selectedRow - rows + 1;
+        }
+    }
+
+    /**
+     * Adjust the visible windows to ensure the selected item is visible on every geometry.
      * This implements the scrolling behavior.
      */
     void adjustWindow()
     {
-        if (items.empty())
+        if (rowCount() == 0)
+        {
+            windowStartRow = 0;
+            for (auto& viewport : viewports)
+            {
+                viewport.windowStartRow = 0;
+            }
+            return;
+        }
+
+        adjustWindowStart(windowStartRow, config.rows);
+        for (auto& viewport : viewports)
+        {
+            adjustWindowStart(viewport.windowStartRow, viewport.config.rows);
+        }
+    }
+
+    /**
+     * Store a new value for an item and update everything derived from it (no rendering).
+     * @return true if the rows of the view changed (the selection has been re-synchronized)
+     */
+    bool applyValue(size_t itemIndex, const ValueType& newValue)
+    {
+        items[itemIndex].setValue(newValue);
+        textCache.invalidate(itemIndex);
+        recordHistory(itemIndex);
+        derivedValues.markChanged(itemIndex);
+        if (view && view->itemChanged(itemIndex))
+        {
+            syncSelectionToView();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Keep the selected item selected after the rows of the view changed, or keep the
+     * navigator on the same row (clamped) if the item is no longer shown.
+     */
+    void syncSelectionToView()
+    {
+        size_t row = (selectedItemIndex != IItemView::noItem) ? rowOfItem(selectedItemIndex)
+                                                              : IItemView::noItem;
+        if (row == IItemView::noItem)
+        {
+            size_t count = rowCount();
+            row = (selectedRow < count) ? selectedRow : (count > 0 ? count - 1 : 0);
+        }
+        moveSelection(row);
+    }
+
+    /**
+     * Recompute derived values affected by the changes since the last frame.
+     */
+    void propagateDerivedValues()
+    {
+        if (derivedValues.hasPending())
+        {
+            derivedValues.propagate(
+                [this](size_t itemIndex) { return items[itemIndex].getValue(); },
+                [this](size_t itemIndex, const ValueType& value) { applyValue(itemIndex, value); });
+        }
+    }
+
+    /**
+     * Record the current value of an item in its history (numeric values only).
+     */
+    void recordHistory(size_t itemIndex)
+    {
+        if constexpr (std::is_arithmetic<ValueType>::value)
+        {
+            if (history && itemIndex < history->getItemCount())
+            {
+                history->record(itemIndex, static_cast<int64_t>(items[itemIndex].getValue()));
+            }
+        }
+    }
+
+    /**
+     * Validate that a geometry can show the navigator, key, separator and value fields.
+     */
+    static void validateGeometry(const DisplayConfig& geometry, size_t keyWidth, size_t valueWidth)
+    {
+        size_t requiredWidth = 1 + keyWidth + 1 + valueWidth;
+        if (geometry.columns < requiredWidth)
+        {
+            throw std::invalid_argument(
+                "DisplayConfig columns (" + std::to_string(geometry.columns) + 
+                ") is too small for DisplayItem width requirements (" + 
+                std::to_string(requiredWidth) + " = 1 navigator + " +
+                std::to_string(keyWidth) + " key + 1 separator + " +
+                std::to_string(valueWidth) + " value)");
+        }
+    }
+
+    /**
+     * Check whether a geometry has a spare column for the position indicator.
+     */
+    static bool hasIndicatorColumn(const DisplayConfig& geometry, size_t keyWidth, size_t valueWidth)
+    {
+        return 1 + keyWidth + 1 + valueWidth < geometry.columns;
+    }
+
+    /**
+     * Check that item keys are the keys shown (no key column replaces them).
+     */
+    void validateItemKeys() const
+    {
+        if (keyColumn)
+        {
+            throw std::logic_error("Item keys are not used while a key column is set");
+        }
+    }
+
+    /**
+     * Check that items can be inserted or removed.
+     */
+    void validateStructureChange() const
+    {
+        if (derivedValues.getDerivedCount() > 0)
+        {
+            throw std::logic_error("Cannot insert or remove items while derived values are defined");
+        }
+        if (keyColumn)
+        {
+            throw std::logic_error("Cannot insert or remove items while a key column is set");
+        }
+    }
+
+    /**
+     * Re-key the value filters of items at or after firstIndex by delta.
+     */
+    void shiftValueFilters(size_t firstIndex, std::ptrdiff_t delta)
+    {
+        if (valueFilters.empty())
+        {
+            return;
+        }
+        std::unordered_map<size_t, FilterType> shifted;
+        shifted.reserve(valueFilters.size());
+        for (auto& filter : valueFilters)
+        {
+            size_t itemIndex = filter.first;
+            if (itemIndex >= firstIndex)
+            {
+                itemIndex += static_cast<size_t>(delta);
+            }
+            shifted.emplace(itemIndex, std::move(filter.second));
+        }
+        valueFilters.swap(shifted);
+    }
+
+    /**
+     * Drop the value filters of removed items (ascending indices) and re-key the others.
+     */
+    void compactValueFilters(const std::vector<size_t>& itemIndices)
+    {
+        if (valueFilters.empty())
         {
-            windowStartIndex = 0;
             return;
         }
+        std::unordered_map<size_t, FilterType> kept;
+        kept.reserve(valueFilters.size());
+        for (auto& filter : valueFilters)
+        {
+            auto position = std::lower_bound(itemIndices.begin(), itemIndices.end(), filter.first);
+            if (position == itemIndices.end() || *position != filter.first)
+            {
+                kept.emplace(filter.first - static_cast<size_t>(position - itemIndices.begin()),
+                             std::move(filter.second));
+            }
+        }
+        valueFilters.swap(kept);
+    }
+
+    void notifyItemsInserted(size_t firstIndex, size_t count)
+    {
+        if (firstIndex + count < items.size())
+        {
+            structureGeneration.fetch_add(1, std::memory_order_release);
+        }
+        for (IStructureListener* listener : structureListeners)
+        {
+            listener->itemsInserted(firstIndex, count);
+        }
+    }
 
-        // If selected item is above the window, scroll up
-        if (selectedItemIndex < windowStartIndex)
+    void notifyItemsRemoved(const std::vector<size_t>& itemIndices)
+    {
+        structureGeneration.fetch_add(1, std::memory_order_release);
+        for (IStructureListener* listener : structureListeners)
         {
-            windowStartIndex = selectedItemIndex;
+            listener->itemsRemoved(itemIndices);
         }
-        // If selected item is below the window, scroll down
-        else if (selectedItemIndex >= windowStartIndex + config.rows)
+    }
+
+    /**
+     * Size the shared text cache so every visible row of every geometry fits.
+     */
+    void reserveTextCache()
+    {
+        size_t visibleRows = config.rows;
+        for (const auto& viewport : viewports)
         {
-            windowStartIndex = selectedItemIndex - config.rows + 1;
+            visibleRows += viewport.config.rows;
         }
+        textCache.reserve(visibleRows * 2);
     }
 
 public:
@@ -131,7 +469,10 @@ LCDDisplayController(
     std::shared_ptr<IRenderer> renderer,
     const DisplayConfig& config = DisplayConfig())
     : config(config), items(std::move(items)), 
-      renderer(renderer), selectedItemIndex(0), windowStartIndex(0), isSelected(false)
+      renderer(renderer), selectedRow(0), selectedItemIndex(0), windowStartRow(0), isSelected(false),
+      visible(true), dirty(true), batchDepth(0), batchRenderPending(false), sparklineWidth(0), sparklineGlyphs(BarGlyphs::ascii()),
+      positionIndicatorEnabled(false), markedItems(this->items.size()), markChar('*'),
+      structureGeneration(0)
 {
     // Compile-time validation: Ensure item widths fit within display columns
     // Format: [navigator(1)] + [key(KeyWidth)] + [separator(1)] + [value(ValueWidth)]
@@ -151,155 +492,1305 @@ LCDDisplayController(
         throw std::invalid_argument("Renderer cannot be null");
     }
         
-    if (config.columns < requiredWidth)
-    {
-        throw std::invalid_argument(
-            "DisplayConfig columns (" + std::to_string(config.columns) + 
-            ") is too small for DisplayItem width requirements (" + 
-            std::to_string(requiredWidth) + " = 1 navigator + " +
-            std::to_string(keyWidth) + " key + 1 separator + " +
-            std::to_string(valueWidth) + " value)");
-    }
+    validateGeometry(config, keyWidth, valueWidth);
+    reserveTextCache();
 }
 
     /**
      * Render the current display state.
+     * While the display is hidden no formatting is done; the display is only marked dirty
+     * so that a single catch-up frame is produced when it becomes visible again.
      */
-    void render()
+    void render() override
     {
-        std::vector<std::string> lines;
-        lines.reserve(config.rows);
-        
+        if (batchDepth > 0)
+        {
+            dirty = true;
+            batchRenderPending = true;
+            return;
+        }
+
+        // Derived values are brought up to date once per frame, even while hidden
+        propagateDerivedValues();
+        if (!visible)
+        {
+            dirty = true;
+            return;
+        }
+
+        const PositionIndicator* indicator = nullptr;
+        if (positionIndicatorEnabled)
+        {
+            positionIndicator.update(selectedRow, rowCount(), config.rows);
+            indicator = &positionIndicator;
+        }
+        frameLines.resize(config.rows);
         for (size_t i = 0; i < config.rows; ++i)
         {
-            lines.push_back(formatRow(i));
+            formatRow(config, windowStartRow, TDisplayItem::getKeyWidth(),
+                      TDisplayItem::getValueWidth(), indicator, i, frameLines[i]);
         }
-        
-        renderer->render(lines, config.columns);
+        renderer->render(frameLines, config.columns);
+
+        for (auto& viewport : viewports)
+        {
+            const PositionIndicator* viewportIndicator = nullptr;
+            if (positionIndicatorEnabled &&
+                hasIndicatorColumn(viewport.config, viewport.keyWidth, viewport.valueWidth))
+            {
+                viewport.indicator.update(selectedRow, rowCount(), viewport.config.rows);
+                viewportIndicator = &viewport.indicator;
+            }
+            viewport.frameLines.resize(viewport.config.rows);
+            for (size_t i = 0; i < viewport.config.rows; ++i)
+            {
+                formatRow(viewport.config, viewport.windowStartRow, viewport.keyWidth,
+                          viewport.valueWidth, viewportIndicator, i, viewport.frameLines[i]);
+            }
+            viewport.renderer->render(viewport.frameLines, viewport.config.columns);
+        }
+        dirty = false;
     }
 
     /**
-     * Navigate to previous item (scrolls if necessary).
-     * @return true if navigation occurred, false if already at top
+     * Add a secondary viewport that renders the same items and selection at another geometry
+     * (e.g., a 4x20 wall unit mirroring a 2x16 handheld). The viewport keeps its own window
+     * position but shares the items and formatted text with the primary display.
+     *
+     * @param viewportRenderer Renderer for the secondary display
+     * @param viewportConfig Geometry of the secondary display
+     * @param keyWidth Key field width on the secondary display
+     * @param valueWidth Value field width on the secondary display
+     * @return Index of the new viewport (0-based, the primary display is not counted)
      */
-    bool navigateUp()
+    size_t addViewport(std::shared_ptr<IRenderer> viewportRenderer,
+                       const DisplayConfig& viewportConfig,
+                       size_t keyWidth, size_t valueWidth)
     {
-        if (selectedItemIndex > 0)
+        if (!viewportRenderer)
         {
-            --selectedItemIndex;
-            adjustWindow();
-            render();
-            return true;
+            throw std::invalid_argument("Renderer cannot be null");
         }
-        return false;
+        validateGeometry(viewportConfig, keyWidth, valueWidth);
+
+        Viewport viewport{viewportRenderer, viewportConfig, keyWidth, valueWidth, 0, {},
+                          positionIndicator};
+        adjustWindowStart(viewport.windowStartRow, viewport.config.rows);
+        viewports.push_back(std::move(viewport));
+        reserveTextCache();
+        return viewports.size() - 1;
     }
 
     /**
-     * Navigate to next item (scrolls if necessary).
-     * @return true if navigation occurred, false if already at bottom
+     * Enable per-item value history, optionally rendered as a sparkline after the value.
+     * Every value change made through the controller is recorded in O(1); memory is
+     * bounded to samplesPerItem * 2 bytes (plus a small header) per item.
+     * The current values are recorded as the first samples.
+     *
+     * @param samplesPerItem Ring capacity per item
+     * @param sparklineColumns Sparkline width in columns (0 to record history without showing it)
+     * @param glyphs Bar glyphs (BarGlyphs::cgram() on displays with custom characters)
+     * @throws std::invalid_argument if the sparkline does not fit, or if both the sparkline
+     *         and the position indicator would use CGRAM glyphs (they share the codes)
      */
-    bool navigateDown()
+    void enableHistory(size_t samplesPerItem, size_t sparklineColumns = 0,
+                       const BarGlyphs& glyphs = BarGlyphs::ascii())
     {
-        if (!items.empty() && selectedItemIndex < items.size() - 1)
+        static_assert(std::is_arithmetic<ValueType>::value, "Value history requires numeric values");
+
+        constexpr size_t rowWidth = 1 + TDisplayItem::getKeyWidth() + 1 + TDisplayItem::getValueWidth();
+        size_t indicatorColumns = positionIndicatorEnabled ? 1 : 0;
+        if (rowWidth + sparklineColumns + indicatorColumns > config.columns)
         {
-            ++selectedItemIndex;
-            adjustWindow();
-            render();
-            return true;
+            throw std::invalid_argument("DisplayConfig columns too small for a sparkline of " +
+                                        std::to_string(sparklineColumns) + " columns");
         }
-        return false;
+        if (sparklineColumns > 0 && glyphs.usesCgram() && positionIndicatorEnabled &&
+            positionIndicator.getGlyphs().usesCgram())
+        {
+            throw std::invalid_argument("Sparkline and position indicator cannot both use CGRAM glyphs");
+        }
+
+        history.reset(new ValueHistory<>(items.size(), samplesPerItem));
+        sparklineWidth = sparklineColumns;
+        sparklineGlyphs = glyphs;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            recordHistory(i);
+        }
+        render();
     }
 
     /**
-     * Mark current item as selected.
-     * @return true if state changed, false if already selected
+     * Show a scroll position indicator in the last column of every geometry with a spare
+     * column. The thumb follows the selected row; its glyphs are only rebuilt when the
+     * quantized position changes, so navigating within one step costs nothing extra.
+     * Nothing is drawn while all rows fit on the display.
+     *
+     * @param glyphs Indicator glyphs (PositionGlyphs::cgram() on displays with custom characters)
+     * @throws std::invalid_argument if there is no spare column, or if both the indicator and
+     *         the sparkline would use CGRAM glyphs (they share the codes)
      */
-    bool selectItem()
+    void enablePositionIndicator(const PositionGlyphs& glyphs = PositionGlyphs::ascii())
     {
-        if (!isSelected)
+        constexpr size_t rowWidth = 1 + TDisplayItem::getKeyWidth() + 1 + TDisplayItem::getValueWidth();
+        if (rowWidth + sparklineWidth + 1 > config.columns)
         {
-            isSelected = true;
-            render();
-            return true;
+            throw std::invalid_argument("DisplayConfig columns too small for a position indicator");
         }
-        return false;
+        if (glyphs.usesCgram() && sparklineWidth > 0 && sparklineGlyphs.usesCgram())
+        {
+            throw std::invalid_argument("Position indicator and sparkline cannot both use CGRAM glyphs");
+        }
+
+        positionIndicatorEnabled = true;
+        positionIndicator = PositionIndicator(glyphs);
+        for (auto& viewport : viewports)
+        {
+            viewport.indicator = PositionIndicator(glyphs);
+        }
+        render();
     }
 
     /**
-     * Mark current item as deselected.
-     * @return true if state changed, false if already deselected
+     * Remove the scroll position indicator.
      */
-    bool deselectItem()
+    void disablePositionIndicator()
     {
-        if (isSelected)
+        positionIndicatorEnabled = false;
+        render();
+    }
+
+    /**
+     * Get the indicator of the primary display (nullptr if not enabled).
+     */
+    const PositionIndicator* getPositionIndicator() const
+    {
+        return positionIndicatorEnabled ? &positionIndicator : nullptr;
+    }
+
+    /**
+     * Show keys from a key column (e.g., a FrontCodedKeyStore) instead of the items' own
+     * keys, so large catalogs can keep their keys compressed. Only the visible rows are
+     * decoded when rendering. Pass nullptr to show item keys again.
+     *
+     * The column only replaces the displayed text: key lookups (findItem(), the key index,
+     * key-based views, InventoryDiff, DeltaImporter) read item keys and are rejected while
+     * a column is set. Resolve keys through the column instead (jumpToKey(column, key)).
+     *
+     * @throws std::invalid_argument if the column does not have one key per item
+     * @throws std::logic_error if the key index is enabled
+     */
+    void setKeyColumn(std::shared_ptr<const IKeyColumn> column)
+    {
+        if (column && column->getKeyCount() != items.size())
         {
-            isSelected = false;
-            render();
-            return true;
+            throw std::invalid_argument("Key column must have one key per item");
         }
-        return false;
+        if (column && keyIndex)
+        {
+            throw std::logic_error("Cannot set a key column while the key index is enabled");
+        }
+        keyColumn = std::move(column);
+        textCache.setKeyColumn(keyColumn.get());
+        render();
     }
 
     /**
-     * Set the value of the currently selected item.
+     * Get the key column (nullptr when item keys are shown).
      */
-    template<typename TValue>
-    void setCurrentValue(const TValue& newValue)
+    std::shared_ptr<const IKeyColumn> getKeyColumn() const
     {
-        validateItemIndex(selectedItemIndex);
-        items[selectedItemIndex].setValue(newValue);
-        render();
+        return keyColumn;
     }
 
     /**
-     * Get the value of the currently selected item.
+     * Get the value history (nullptr if history is not enabled).
      */
-    auto getCurrentValue() const
+    const ValueHistory<>* getHistory() const
     {
-        validateItemIndex(selectedItemIndex);
-        return items[selectedItemIndex].getValue();
+        return history.get();
     }
 
     /**
-     * Get the key of the currently selected item.
+     * Get number of secondary viewports.
      */
-    auto getCurrentKey() const
+    size_t getViewportCount() const
     {
-        validateItemIndex(selectedItemIndex);
-        return items[selectedItemIndex].getKey();
+        return viewports.size();
     }
 
     /**
-     * Get current selected item index (0-based, in the full items list).
+     * Get the index of the first visible item in a secondary viewport.
      */
-    size_t getSelectedItemIndex() const
+    size_t getViewportWindowStartIndex(size_t viewportIndex) const
     {
-        return selectedItemIndex;
+        if (viewportIndex >= viewports.size())
+        {
+            throw std::out_of_range("Viewport index out of range");
+        }
+        return viewports[viewportIndex].windowStartRow;
     }
 
     /**
-     * Get the index of the first visible item in the window.
+     * Start a batch of mutations: renders requested until the matching endBatch()
+     * are coalesced into a single frame. Batches may be nested.
      */
-    size_t getWindowStartIndex() const
+    void beginBatch()
     {
-        return windowStartIndex;
+        ++batchDepth;
     }
 
     /**
-     * Get current navigator position within the visible window.
-     * @return Row index (0 to config.rows-1) where the cursor appears
+     * End a batch of mutations, rendering once if anything inside it requested a frame.
      */
-    size_t getNavigatorRow() const
+    void endBatch()
     {
-        return getNavigatorRowInWindow();
+        if (batchDepth == 0)
+        {
+            throw std::logic_error("endBatch() called without matching beginBatch()");
+        }
+        if (--batchDepth == 0 && batchRenderPending)
+        {
+            batchRenderPending = false;
+            render();
+        }
     }
 
     /**
-     * Get total number of items.
+     * RAII helper that keeps a batch open for the lifetime of the scope.
+     * When the scope is left by an exception, the half-applied batch is not rendered;
+     * the display is only marked dirty so the next frame shows the model as it is.
+     * Renderer errors at the end of the batch never escape the destructor.
      */
-    size_t getItemCount() const
+    class BatchScope
     {
-        return items.size();
+    public:
+        explicit BatchScope(LCDDisplayController& controller)
+            : controller(controller), uncaughtExceptions(std::uncaught_exceptions())
+        {
+            controller.beginBatch();
+        }
+
+        ~BatchScope()
+        {
+            if (std::uncaught_exceptions() > uncaughtExceptions)
+            {
+                --controller.batchDepth;
+                if (controller.batchDepth == 0)
+                {
+                    controller.batchRenderPending = false;
+                }
+                controller.dirty = true;
+                return;
+            }
+            try
+            {
+                controller.endBatch();
+            }
+            catch (...)
+            {
+                // The frame was not drawn; the display stays dirty for the next render
+                controller.dirty = true;
+            }
+        }
+
+        BatchScope(const BatchScope&) = delete;
+        BatchScope& operator=(const BatchScope&) = delete;
+
+    private:
+        LCDDisplayController& controller;
+        int uncaughtExceptions;     // In flight when the scope was entered
+    };
+
+    /**
+     * Show or hide the display (e.g., backlight switched off, tab not shown).
+     * Mutations while hidden only update the model and mark the display dirty.
+     * Becoming visible renders exactly one catch-up frame if anything changed.
+     * @return true if visibility changed
+     */
+    bool setVisible(bool shouldBeVisible) override
+    {
+        if (visible == shouldBeVisible)
+        {
+            return false;
+        }
+
+        visible = shouldBeVisible;
+        if (visible && dirty)
+        {
+            render();
+        }
+        return true;
+    }
+
+    /**
+     * Check if the display is currently visible.
+     */
+    bool isVisible() const override
+    {
+        return visible;
+    }
+
+    /**
+     * Check if the model changed since the last rendered frame.
+     */
+    bool isDirty() const override
+    {
+        return dirty;
+    }
+
+    /**
+     * Mark the display dirty without rendering, e.g. when something else has drawn
+     * over the physical display or items were modified through getItems(), and the next
+     * show must repaint it.
+     */
+    void invalidate() override
+    {
+        dirty = true;
+    }
+
+    /**
+     * Navigate to previous item (scrolls if necessary).
+     * @return true if navigation occurred, false if already at top
+     */
+    bool navigateUp()
+    {
+        if (selectedRow > 0)
+        {
+            moveSelection(selectedRow - 1);
+            render();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Navigate to next item (scrolls if necessary).
+     * @return true if navigation occurred, false if already at bottom
+     */
+    bool navigateDown()
+    {
+        if (selectedRow + 1 < rowCount())
+        {
+            moveSelection(selectedRow + 1);
+            render();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Move the navigator one page (the primary display's row count) up.
+     * @return true if navigation occurred, false if already at top
+     */
+    bool pageUp()
+    {
+        if (selectedRow == 0)
+        {
+            return false;
+        }
+        moveSelection(selectedRow > config.rows ? selectedRow - config.rows : 0);
+        render();
+        return true;
+    }
+
+    /**
+     * Move the navigator one page (the primary display's row count) down.
+     * @return true if navigation occurred, false if already at bottom
+     */
+    bool pageDown()
+    {
+        size_t count = rowCount();
+        if (selectedRow + 1 >= count)
+        {
+            return false;
+        }
+        moveSelection(selectedRow + config.rows < count ? selectedRow + config.rows : count - 1);
+        render();
+        return true;
+    }
+
+    /**
+     * Move the navigator to the first row.
+     * @return true if navigation occurred
+     */
+    bool navigateToFirst()
+    {
+        if (selectedRow == 0 || rowCount() == 0)
+        {
+            return false;
+        }
+        moveSelection(0);
+        render();
+        return true;
+    }
+
+    /**
+     * Move the navigator to the last row.
+     * @return true if navigation occurred
+     */
+    bool navigateToLast()
+    {
+        size_t count = rowCount();
+        if (selectedRow + 1 >= count)
+        {
+            return false;
+        }
+        moveSelection(count - 1);
+        render();
+        return true;
+    }
+
+    /**
+     * Mark current item as selected.
+     * On a row that is not an item (e.g., a section header) the view handles the
+     * selection instead, typically by collapsing or expanding the section.
+     * @return true if state changed, false if already selected
+     */
+    bool selectItem()
+    {
+        if (view && selectedItemIndex == IItemView::noItem)
+        {
+            if (view->activateRow(selectedRow))
+            {
+                refreshView();
+                return true;
+            }
+            return false;
+        }
+        if (!isSelected)
+        {
+            isSelected = true;
+            render();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Mark current item as deselected.
+     * @return true if state changed, false if already deselected
+     */
+    bool deselectItem()
+    {
+        if (isSelected)
+        {
+            isSelected = false;
+            render();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Set the value of the currently selected item.
+     */
+    template<typename TValue>
+    void setCurrentValue(const TValue& newValue)
+    {
+        validateItemIndex(selectedItemIndex);
+        applyValue(selectedItemIndex, static_cast<ValueType>(newValue));
+        render();
+    }
+
+    /**
+     * Update the value of any item from a live source (sensor, feed).
+     * The item's noise filter, if any, decides whether the value changed; rejected
+     * samples and unchanged values neither mark the display dirty nor render.
+     *
+     * @param itemIndex Index of the item to update
+     * @param newValue Raw value from the source
+     * @param now Time of the sample (used by rate limiting)
+     * @return true if the displayed value changed
+     */
+    bool updateValue(size_t itemIndex, const ValueType& newValue, Clock::time_point now = Clock::now())
+    {
+        validateItemIndex(itemIndex);
+        const ValueType& current = items[itemIndex].getValue();
+        ValueType accepted = newValue;
+
+        if constexpr (std::is_arithmetic<ValueType>::value)
+        {
+            auto filter = valueFilters.find(itemIndex);
+            if (filter != valueFilters.end())
+            {
+                if (!filter->second.apply(newValue, current, now, accepted))
+                {
+                    return false;
+                }
+            }
+        }
+        if (accepted == current)
+        {
+            return false;
+        }
+
+        applyValue(itemIndex, accepted);
+        render();
+        return true;
+    }
+
+    /**
+     * Apply many live value updates as one bulk update, producing at most one frame.
+     * Each update goes through the item's noise filter exactly like updateValue().
+     *
+     * @param updates (item index, value) pairs
+     * @param now Time of the samples
+     * @return Number of items whose displayed value changed
+     */
+    size_t applyUpdates(const std::vector<ValueUpdate>& updates, Clock::time_point now = Clock::now())
+    {
+        BatchScope batch(*this);
+        size_t changedCount = 0;
+        for (const auto& update : updates)
+        {
+            if (updateValue(update.first, update.second, now))
+            {
+                ++changedCount;
+            }
+        }
+        return changedCount;
+    }
+
+    /**
+     * Set the values of many items as one bulk update, producing at most one frame.
+     * Unlike applyUpdates(), values are not filtered (like user edits, they are authoritative).
+     * No frame is drawn when every changed item is off screen.
+     *
+     * @param updates (item index, value) pairs
+     * @return Number of items whose value changed
+     */
+    size_t setValues(const std::vector<ValueUpdate>& updates)
+    {
+        BatchScope batch(*this);
+        size_t changedCount = 0;
+        bool affectsScreen = !visible || derivedValues.getDerivedCount() > 0;
+        for (const auto& update : updates)
+        {
+            validateItemIndex(update.first);
+            if (!(items[update.first].getValue() == update.second))
+            {
+                bool rowsChanged = applyValue(update.first, update.second);
+                ++changedCount;
+                affectsScreen = affectsScreen || rowsChanged || isItemVisible(update.first);
+            }
+        }
+        if (changedCount > 0 && affectsScreen)
+        {
+            render();
+        }
+        return changedCount;
+    }
+
+    /**
+     * Mark or unmark an item for bulk operations.
+     */
+    void markItem(size_t itemIndex, bool marked = true)
+    {
+        validateItemIndex(itemIndex);
+        if (markedItems.test(itemIndex) != marked)
+        {
+            markedItems.set(itemIndex, marked);
+            render();
+        }
+    }
+
+    /**
+     * Mark or unmark the items in [firstItem, endItem), producing one frame.
+     */
+    void markRange(size_t firstItem, size_t endItem, bool marked = true)
+    {
+        markedItems.setRange(firstItem, endItem, marked);
+        render();
+    }
+
+    /**
+     * Toggle the mark of the item on the navigator row.
+     */
+    void toggleMark()
+    {
+        if (selectedItemIndex < items.size())
+        {
+            markedItems.toggle(selectedItemIndex);
+            render();
+        }
+    }
+
+    void clearMarks()
+    {
+        if (!markedItems.empty())
+        {
+            markedItems.clear();
+            render();
+        }
+    }
+
+    const ItemSelection& getMarkedItems() const
+    {
+        return markedItems;
+    }
+
+    /**
+     * Set the navigator-column glyph shown on marked rows (default '*').
+     */
+    void setMarkChar(char glyph)
+    {
+        markChar = glyph;
+        render();
+    }
+
+    /**
+     * Replace the value of every marked item with operation(value), as one bulk update
+     * producing at most one frame (none if no changed item is on screen). Values are not
+     * filtered, like user edits.
+     *
+     * @param operation Callable (const ValueType&) -> ValueType
+     * @return Number of items whose value changed
+     */
+    template<typename TOperation>
+    size_t applyToMarked(TOperation operation)
+    {
+        BatchScope batch(*this);
+        size_t changedCount = 0;
+        bool affectsScreen = !visible || derivedValues.getDerivedCount() > 0;
+        markedItems.forEach([&](size_t itemIndex)
+        {
+            const ValueType current = items[itemIndex].getValue();
+            const ValueType updated = operation(current);
+            if (!(updated == current))
+            {
+                bool rowsChanged = applyValue(itemIndex, updated);
+                ++changedCount;
+                affectsScreen = affectsScreen || rowsChanged || isItemVisible(itemIndex);
+            }
+        });
+        if (changedCount > 0 && affectsScreen)
+        {
+            render();
+        }
+        return changedCount;
+    }
+
+    /**
+     * Apply live value updates addressed by key, as one bulk update.
+     * Keys are resolved through a key index (e.g., StaticKeyIndex, FrontCodedKeyStore);
+     * keys the index does not know are skipped.
+     *
+     * @tparam TKeyIndex Type with size_t find(key) returning the item index, or an
+     *         out-of-range index for unknown keys
+     * @param keyIndex Key-to-item index
+     * @param updates (key, value) pairs
+     * @param now Time of the samples
+     * @return Number of items whose displayed value changed
+     */
+    template<typename TKeyIndex, typename TKey>
+    size_t applyUpdatesByKey(const TKeyIndex& keyIndex,
+                             const std::vector<std::pair<TKey, ValueType>>& updates,
+                             Clock::time_point now = Clock::now())
+    {
+        BatchScope batch(*this);
+        size_t changedCount = 0;
+        for (const auto& update : updates)
+        {
+            size_t itemIndex = keyIndex.find(update.first);
+            if (itemIndex < items.size() && updateValue(itemIndex, update.second, now))
+            {
+                ++changedCount;
+            }
+        }
+        return changedCount;
+    }
+
+    /**
+     * Move the navigator to the row showing an item.
+     * @return true if the current view shows the item (it is now the selected row)
+     */
+    bool jumpToItem(size_t itemIndex)
+    {
+        validateItemIndex(itemIndex);
+        size_t row = rowOfItem(itemIndex);
+        if (row == IItemView::noItem)
+        {
+            return false;
+        }
+        if (row != selectedRow || selectedItemIndex != itemIndex)
+        {
+            moveSelection(row);
+            render();
+        }
+        return true;
+    }
+
+    /**
+     * Move the navigator to the item with a key, resolved through a key index.
+     * @return true if the key is known and its item is shown by the current view
+     */
+    template<typename TKeyIndex, typename TKey>
+    bool jumpToKey(const TKeyIndex& keyIndex, const TKey& key)
+    {
+        size_t itemIndex = keyIndex.find(key);
+        return itemIndex < items.size() && jumpToItem(itemIndex);
+    }
+
+    /**
+     * Build a concurrent key-to-item index so that findItem(), jumpToKey() and
+     * updateValueByKey() are O(1). The index is kept up to date by insertItem() and
+     * removeItem(); producer threads may resolve keys through getKeyIndex() without locks.
+     * Call again after changing keys through getItems().
+     *
+     * @param pool Optional worker pool to build the index on all cores (large imports)
+     * @throws std::logic_error if a key column is set (the index is built from item keys)
+     * @throws std::invalid_argument if two items have the same key (the index is not enabled)
+     */
+    void enableKeyIndex(WorkerPool* pool = nullptr)
+    {
+        validateItemKeys();
+        auto index = std::make_shared<ConcurrentKeyIndex<KeyType>>();
+        size_t inserted = 0;
+        if (pool)
+        {
+            inserted = index->build(items.size(), [this](size_t i) { return items[i].getKey(); }, *pool);
+        }
+        else
+        {
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                inserted += index->insert(items[i].getKey(), i) ? 1 : 0;
+            }
+        }
+        if (inserted != items.size())
+        {
+            throw std::invalid_argument("Item keys must be unique to enable the key index");
+        }
+        keyIndex = std::move(index);
+    }
+
+    /**
+     * Get the key index (nullptr if not enabled).
+     */
+    std::shared_ptr<const ConcurrentKeyIndex<KeyType>> getKeyIndex() const
+    {
+        return keyIndex;
+    }
+
+    /**
+     * Get the index of the item with a key, or IItemView::noItem.
+     * O(1) with the key index enabled, a linear scan otherwise.
+     * @throws std::logic_error if a key column is set (item keys are not the shown keys)
+     */
+    size_t findItem(const KeyType& key) const
+    {
+        validateItemKeys();
+        if (keyIndex)
+        {
+            return keyIndex->find(key);
+        }
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (items[i].getKey() == key)
+            {
+                return i;
+            }
+        }
+        return IItemView::noItem;
+    }
+
+    /**
+     * Move the navigator to the item with a key.
+     * @return true if the key is known and its item is shown by the current view
+     */
+    bool jumpToKey(const KeyType& key)
+    {
+        size_t itemIndex = findItem(key);
+        return itemIndex < items.size() && jumpToItem(itemIndex);
+    }
+
+    /**
+     * Update the value of the item with a key, like updateValue().
+     * @return true if the key is known and the displayed value changed
+     */
+    bool updateValueByKey(const KeyType& key, const ValueType& newValue, Clock::time_point now = Clock::now())
+    {
+        size_t itemIndex = findItem(key);
+        return itemIndex < items.size() && updateValue(itemIndex, newValue, now);
+    }
+
+    /**
+     * Insert an item before position (items.size() to append).
+     * The selected item stays selected; per-item state (filters, history, key index, view)
+     * moves with the items. Not available while derived values or a key column are in use,
+     * since both address items by fixed index.
+     * @throws std::invalid_argument if the key index is enabled and already has the item's key
+     */
+    void insertItem(size_t position, const TDisplayItem& item)
+    {
+        if (position > items.size())
+        {
+            throw std::out_of_range("Item index out of range");
+        }
+        validateStructureChange();
+        if (keyIndex && keyIndex->find(item.getKey()) != ConcurrentKeyIndex<KeyType>::notFound)
+        {
+            throw std::invalid_argument("An item with this key already exists");
+        }
+
+        items.insert(items.begin() + position, item);
+        markedItems.insertItem(position);
+        if (view)
+        {
+            try
+            {
+                view->itemInserted(position);
+            }
+            catch (...)
+            {
+                items.erase(items.begin() + position);
+                markedItems.removeItem(position);
+                throw;
+            }
+        }
+        textCache.clear();
+        shiftValueFilters(position, 1);
+        if (history)
+        {
+            history->insertItem(position);
+            recordHistory(position);
+        }
+        if (keyIndex)
+        {
+            keyIndex->shiftIndices(position, 1);
+            keyIndex->insert(item.getKey(), position);
+        }
+
+        if (selectedItemIndex != IItemView::noItem && selectedItemIndex >= position &&
+            selectedItemIndex < items.size() - 1)
+        {
+            ++selectedItemIndex;
+        }
+        notifyItemsInserted(position, 1);
+        refreshView();
+    }
+
+    /**
+     * Remove an item. If it was selected, the navigator stays on the same row
+     * (clamped to the new row count) and edit mode ends.
+     */
+    void removeItem(size_t itemIndex)
+    {
+        validateItemIndex(itemIndex);
+        validateStructureChange();
+
+        if (view)
+        {
+            view->itemRemoved(itemIndex);
+        }
+        if (keyIndex)
+        {
+            keyIndex->remove(items[itemIndex].getKey());
+            keyIndex->shiftIndices(itemIndex + 1, -1);
+        }
+        items.erase(items.begin() + itemIndex);
+        markedItems.removeItem(itemIndex);
+        textCache.clear();
+        valueFilters.erase(itemIndex);
+        shiftValueFilters(itemIndex + 1, -1);
+        if (history)
+        {
+            history->removeItem(itemIndex);
+        }
+
+        if (selectedItemIndex == itemIndex)
+        {
+            selectedItemIndex = IItemView::noItem;
+            isSelected = false;
+        }
+        else if (selectedItemIndex != IItemView::noItem && selectedItemIndex > itemIndex)
+        {
+            --selectedItemIndex;
+        }
+        notifyItemsRemoved(std::vector<size_t>{itemIndex});
+        refreshView();
+    }
+
+    /**
+     * Remove many items as one bulk update producing a single frame. Items, value filters,
+     * history, marks, the key index and the view are each compacted in one pass, so
+     * removing r of n items costs O(n) rather than r separate O(n) removals.
+     * The selection behaves as with removeItem().
+     *
+     * @param itemIndices Items to remove, in ascending order
+     */
+    void removeItems(const std::vector<size_t>& itemIndices)
+    {
+        for (size_t i = 0; i < itemIndices.size(); ++i)
+        {
+            validateItemIndex(itemIndices[i]);
+            if (i > 0 && itemIndices[i] <= itemIndices[i - 1])
+            {
+                throw std::invalid_argument("Item indices must be unique and in ascending order");
+            }
+        }
+        validateStructureChange();
+        if (itemIndices.empty())
+        {
+            return;
+        }
+
+        if (view)
+        {
+            view->itemsRemoved(itemIndices);
+        }
+        if (keyIndex)
+        {
+            for (size_t itemIndex : itemIndices)
+            {
+                keyIndex->remove(items[itemIndex].getKey());
+            }
+            keyIndex->compactIndices(itemIndices);
+        }
+        size_t kept = 0;
+        size_t next = 0;
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (next < itemIndices.size() && itemIndices[next] == i)
+            {
+                ++next;
+                continue;
+            }
+            if (kept != i)
+            {
+                items[kept] = std::move(items[i]);
+            }
+            ++kept;
+        }
+        items.erase(items.begin() + kept, items.end());
+        markedItems.removeItems(itemIndices);
+        textCache.clear();
+        compactValueFilters(itemIndices);
+        if (history)
+        {
+            history->removeItems(itemIndices);
+        }
+
+        if (selectedItemIndex != IItemView::noItem)
+        {
+            auto position = std::lower_bound(itemIndices.begin(), itemIndices.end(), selectedItemIndex);
+            if (position != itemIndices.end() && *position == selectedItemIndex)
+            {
+                selectedItemIndex = IItemView::noItem;
+                isSelected = false;
+            }
+            else
+            {
+                selectedItemIndex -= static_cast<size_t>(position - itemIndices.begin());
+            }
+        }
+        notifyItemsRemoved(itemIndices);
+        refreshView();
+    }
+
+    /**
+     * Append many items as one bulk update producing a single frame. Existing items keep
+     * their indices, so only the new items are indexed and the view extends itself once.
+     *
+     * @throws std::invalid_argument if the key index is enabled and a new key is already
+     *         present (nothing is appended)
+     */
+    void appendItems(const std::vector<TDisplayItem>& newItems)
+    {
+        validateStructureChange();
+        if (newItems.empty())
+        {
+            return;
+        }
+
+        size_t firstIndex = items.size();
+        auto unindex = [this, &newItems](size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                keyIndex->remove(newItems[i].getKey());
+            }
+        };
+        if (keyIndex)
+        {
+            for (size_t i = 0; i < newItems.size(); ++i)
+            {
+                if (!keyIndex->insert(newItems[i].getKey(), firstIndex + i))
+                {
+                    unindex(i);
+                    throw std::invalid_argument("An item with this key already exists");
+                }
+            }
+        }
+        items.insert(items.end(), newItems.begin(), newItems.end());
+        if (view)
+        {
+            try
+            {
+                view->itemsAppended(firstIndex, newItems.size());
+            }
+            catch (...)
+            {
+                items.erase(items.begin() + firstIndex, items.end());
+                if (keyIndex)
+                {
+                    unindex(newItems.size());
+                }
+                throw;
+            }
+        }
+        markedItems.appendItems(newItems.size());
+        if (history)
+        {
+            history->appendItems(newItems.size());
+            for (size_t i = firstIndex; i < items.size(); ++i)
+            {
+                recordHistory(i);
+            }
+        }
+        notifyItemsInserted(firstIndex, newItems.size());
+        refreshView();
+    }
+
+    /**
+     * Notify a listener of every later item insertion and removal, so that it can keep
+     * item indices it holds in step. The listener must be removed before it is destroyed.
+     */
+    void addStructureListener(IStructureListener* listener)
+    {
+        if (!listener)
+        {
+            throw std::invalid_argument("Structure listener cannot be null");
+        }
+        structureListeners.push_back(listener);
+    }
+
+    void removeStructureListener(IStructureListener* listener)
+    {
+        structureListeners.erase(std::remove(structureListeners.begin(), structureListeners.end(), listener),
+                                 structureListeners.end());
+    }
+
+    /**
+     * Check if an item is currently shown on any geometry of a visible display.
+     */
+    bool isItemVisible(size_t itemIndex) const
+    {
+        size_t row = visible ? rowOfItem(itemIndex) : IItemView::noItem;
+        if (row == IItemView::noItem)
+        {
+            return false;
+        }
+        if (row >= windowStartRow && row < windowStartRow + config.rows)
+        {
+            return true;
+        }
+        for (const auto& viewport : viewports)
+        {
+            if (row >= viewport.windowStartRow &&
+                row < viewport.windowStartRow + viewport.config.rows)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Define an item whose value is computed from other items (e.g., a category total).
+     * Only derived items affected by a change are recomputed, once per frame, in dependency
+     * order; inside a batch this happens when the batch ends.
+     * Throws std::invalid_argument if the definition would create a cycle.
+     *
+     * @param targetIndex Item receiving the computed value
+     * @param inputIndices Items the value depends on, passed to compute in this order
+     * @param compute Function (const std::vector<ValueType>& inputs) -> ValueType
+     */
+    void defineDerivedValue(size_t targetIndex, std::vector<size_t> inputIndices,
+                            typename DerivedValueGraph<ValueType>::ComputeFunction compute)
+    {
+        validateItemIndex(targetIndex);
+        for (size_t input : inputIndices)
+        {
+            validateItemIndex(input);
+        }
+        derivedValues.define(targetIndex, std::move(inputIndices), std::move(compute));
+        render();
+    }
+
+    /**
+     * Turn a derived item back into a plain item (its current value is kept).
+     * @return true if the item was derived
+     */
+    bool removeDerivedValue(size_t targetIndex)
+    {
+        return derivedValues.remove(targetIndex);
+    }
+
+    /**
+     * Check if an item's value is derived from other items.
+     */
+    bool isDerivedValue(size_t itemIndex) const
+    {
+        return derivedValues.isDerived(itemIndex);
+    }
+
+    /**
+     * Attach a noise filter (deadband, minimum update interval, moving average)
+     * to an item. The filter applies to updateValue() only; user edits are never filtered.
+     */
+    void setValueFilter(size_t itemIndex, const ValueFilterConfig& filterConfig)
+    {
+        static_assert(std::is_arithmetic<ValueType>::value, "Value filters require numeric values");
+        validateItemIndex(itemIndex);
+        valueFilters.erase(itemIndex);
+        valueFilters.emplace(itemIndex, FilterType(filterConfig));
+    }
+
+    /**
+     * Remove the noise filter of an item.
+     * @return true if the item had a filter
+     */
+    bool clearValueFilter(size_t itemIndex)
+    {
+        return valueFilters.erase(itemIndex) > 0;
+    }
+
+    /**
+     * Get the value of the currently selected item.
+     */
+    auto getCurrentValue() const
+    {
+        validateItemIndex(selectedItemIndex);
+        return items[selectedItemIndex].getValue();
+    }
+
+    /**
+     * Get the key of the currently selected item.
+     * @throws std::logic_error if a key column is set (use getCurrentKeyText())
+     */
+    auto getCurrentKey() const
+    {
+        validateItemIndex(selectedItemIndex);
+        validateItemKeys();
+        return items[selectedItemIndex].getKey();
+    }
+
+    /**
+     * Get the key text shown for the currently selected item (from the key column, if set).
+     */
+    std::string getCurrentKeyText() const
+    {
+        validateItemIndex(selectedItemIndex);
+        if (!keyColumn)
+        {
+            return items[selectedItemIndex].getKeyText();
+        }
+        std::string key;
+        keyColumn->getKey(selectedItemIndex, key);
+        return key;
+    }
+
+    /**
+     * Get current selected item index (0-based, in the full items list).
+     * Returns IItemView::noItem while a row that is not an item (header) is selected.
+     */
+    size_t getSelectedItemIndex() const
+    {
+        return selectedItemIndex;
+    }
+
+    /**
+     * Check if the selected row shows an item (false on section headers or empty lists).
+     */
+    bool hasCurrentItem() const
+    {
+        return selectedItemIndex < items.size();
+    }
+
+    /**
+     * Get the row of the navigator (equals the selected item index when no view is set).
+     */
+    size_t getSelectedRow() const
+    {
+        return selectedRow;
+    }
+
+    /**
+     * Get the index of the first visible row in the window
+     * (equals the first visible item index when no view is set).
+     */
+    size_t getWindowStartIndex() const
+    {
+        return windowStartRow;
+    }
+
+    /**
+     * Get number of navigable rows (items plus any rows a view adds, minus hidden items).
+     */
+    size_t getRowCount() const
+    {
+        return rowCount();
+    }
+
+    /**
+     * Set the view that maps rows to items (sections, filters, sorted orders).
+     * The selected item stays selected if the new view shows it.
+     * @param newView View to use, or nullptr to show all items in order
+     */
+    void setView(std::shared_ptr<IItemView> newView)
+    {
+        view = std::move(newView);
+        refreshView();
+    }
+
+    /**
+     * Get the current view (nullptr when rows map directly to items).
+     */
+    std::shared_ptr<IItemView> getView() const
+    {
+        return view;
+    }
+
+    /**
+     * Re-synchronize selection and windows after the rows of the view changed
+     * (e.g., a section was collapsed). The selected item stays selected if it is still
+     * shown; otherwise the navigator stays on the same row, clamped to the new row count.
+     */
+    void refreshView()
+    {
+        syncSelectionToView();
+        render();
+    }
+
+    /**
+     * Get current navigator position within the visible window.
+     * @return Row index (0 to config.rows-1) where the cursor appears
+     */
+    size_t getNavigatorRow() const
+    {
+        return getNavigatorRowInWindow();
+    }
+
+    /**
+     * Get total number of items.
+     */
+    size_t getItemCount() const
+    {
+        return items.size();
+    }
+
+    /**
+     * Get the structure generation, bumped whenever an insert or removal moves existing
+     * items to other indices (appends do not). Safe to read from any thread; an item index
+     * resolved after reading generation G still addresses the same item while the
+     * generation is G.
+     */
+    uint64_t getStructureGeneration() const
+    {
+        return structureGeneration.load(std::memory_order_acquire);
     }
 
     /**
@@ -307,7 +1798,7 @@ LCDDisplayController(
      */
     bool canScroll() const
     {
-        return items.size() > config.rows;
+        return rowCount() > config.rows;
     }
 
     /**
@@ -320,6 +1811,8 @@ LCDDisplayController(
 
     /**
      * Get reference to items for advanced manipulation.
+     * Cached item text is checked against the items when rows are built, so the next
+     * frame shows any edits made through this reference.
      */
     std::vector<TDisplayItem>& getItems()
     {
@@ -4,6 +4,8 @@
 #include "LCDDisplayController.h"
 #include "DisplayItem.h"
 #include "IInventoryController.h"
+#include "IDisplayPage.h"
+#include "IInputListener.h"
 #include <type_traits>
 
 /**
@@ -13,12 +15,15 @@
  * @tparam TDisplayItem The DisplayItem type (must have arithmetic value type)
  */
 template<typename TDisplayItem>
-class LCDInventoryController : public IInventoryController
+class LCDInventoryController : public IInventoryController, public IDisplayPage
 {
 private:
     LCDDisplayController<TDisplayItem> displayController;
 
 public:
+    using KeyType = typename LCDDisplayController<TDisplayItem>::KeyType;
+    using ValueType = typename LCDDisplayController<TDisplayItem>::ValueType;
+
     /**
      * Constructor with dependency injection.
      */
@@ -40,6 +45,26 @@ public:
         displayController.navigateDown();
     }
 
+    void pageUp()
+    {
+        displayController.pageUp();
+    }
+
+    void pageDown()
+    {
+        displayController.pageDown();
+    }
+
+    void navigateToFirst()
+    {
+        displayController.navigateToFirst();
+    }
+
+    void navigateToLast()
+    {
+        displayController.navigateToLast();
+    }
+
     void selectItem() override
     {
         displayController.selectItem();
@@ -52,24 +77,204 @@ public:
 
     void incrementValue() override
     {
+        if (!displayController.hasCurrentItem())
+        {
+            return;
+        }
         auto currentValue = displayController.getCurrentValue();
         displayController.setCurrentValue(currentValue + 1);
     }
 
     void decrementValue() override
     {
+        if (!displayController.hasCurrentItem())
+        {
+            return;
+        }
         auto currentValue = displayController.getCurrentValue();
         displayController.setCurrentValue(currentValue - 1);
     }
 
+    /**
+     * Mark or unmark the item on the navigator row for bulk operations.
+     */
+    void toggleMark()
+    {
+        displayController.toggleMark();
+    }
+
+    /**
+     * Mark or unmark the items in [firstItem, endItem).
+     */
+    void markRange(size_t firstItem, size_t endItem, bool marked = true)
+    {
+        displayController.markRange(firstItem, endItem, marked);
+    }
+
+    void clearMarks()
+    {
+        displayController.clearMarks();
+    }
+
+    const ItemSelection& getMarkedItems() const
+    {
+        return displayController.getMarkedItems();
+    }
+
+    /**
+     * Add step to every marked item, producing a single frame.
+     * @return Number of items whose value changed
+     */
+    size_t incrementMarked(ValueType step = 1)
+    {
+        return displayController.applyToMarked(
+            [step](ValueType value) { return static_cast<ValueType>(value + step); });
+    }
+
+    /**
+     * Subtract step from every marked item, producing a single frame.
+     */
+    size_t decrementMarked(ValueType step = 1)
+    {
+        return displayController.applyToMarked(
+            [step](ValueType value) { return static_cast<ValueType>(value - step); });
+    }
+
+    /**
+     * Set every marked item to a value, producing a single frame.
+     */
+    size_t setMarked(ValueType newValue)
+    {
+        return displayController.applyToMarked([newValue](ValueType) { return newValue; });
+    }
+
+    /**
+     * Set every marked item to zero, producing a single frame.
+     */
+    size_t zeroMarked()
+    {
+        return setMarked(ValueType(0));
+    }
+
+    /**
+     * Jump to the item with a key (e.g., a scanned code) and optionally increment it,
+     * producing a single frame. Enable the key index on the display controller to make
+     * the lookup O(1).
+     * @return false if no item with the key is shown
+     */
+    bool selectByKey(const KeyType& key, bool increment = false)
+    {
+        typename LCDDisplayController<TDisplayItem>::BatchScope batch(displayController);
+        if (!displayController.jumpToKey(key))
+        {
+            return false;
+        }
+        if (increment)
+        {
+            incrementValue();
+        }
+        return true;
+    }
+
+    /**
+     * Apply one navigation command.
+     * SelectByKey carries no key here and is ignored; use selectByKey() for it.
+     * @return false for commands that were ignored
+     */
+    bool applyCommand(NavigationCommand command)
+    {
+        switch (command)
+        {
+        case NavigationCommand::Up:
+            navigateUp();
+            return true;
+        case NavigationCommand::Down:
+            navigateDown();
+            return true;
+        case NavigationCommand::Select:
+            selectItem();
+            return true;
+        case NavigationCommand::Deselect:
+            deselectItem();
+            return true;
+        case NavigationCommand::Increment:
+            incrementValue();
+            return true;
+        case NavigationCommand::Decrement:
+            decrementValue();
+            return true;
+        case NavigationCommand::PageUp:
+            pageUp();
+            return true;
+        case NavigationCommand::PageDown:
+            pageDown();
+            return true;
+        case NavigationCommand::First:
+            navigateToFirst();
+            return true;
+        case NavigationCommand::Last:
+            navigateToLast();
+            return true;
+        case NavigationCommand::SelectByKey:
+        case NavigationCommand::None:
+            break;
+        }
+        return false;
+    }
+
+    /**
+     * Apply a batch of commands (e.g., from a piped script) as one bulk update:
+     * the display is rendered once at the end, not once per command.
+     * @return Number of commands applied
+     */
+    size_t applyCommands(const std::vector<NavigationCommand>& commands)
+    {
+        typename LCDDisplayController<TDisplayItem>::BatchScope batch(displayController);
+        size_t appliedCount = 0;
+        for (NavigationCommand command : commands)
+        {
+            if (applyCommand(command))
+            {
+                ++appliedCount;
+            }
+        }
+        return appliedCount;
+    }
+
     /**
      * Render the display.
      */
-    void render()
+    void render() override
     {
         displayController.render();
     }
 
+    /**
+     * Show or hide the display. See LCDDisplayController::setVisible.
+     */
+    bool setVisible(bool shouldBeVisible) override
+    {
+        return displayController.setVisible(shouldBeVisible);
+    }
+
+    /**
+     * Check if the display is currently visible.
+     */
+    bool isVisible() const override
+    {
+        return displayController.isVisible();
+    }
+
+    bool isDirty() const override
+    {
+        return displayController.isDirty();
+    }
+
+    void invalidate() override
+    {
+        displayController.invalidate();
+    }
+
     /**
      * Get access to the underlying display controller for advanced operations.
      */
@@ -0,0 +1,119 @@
+#include "NaturalSortKey.h"
+#include <cstdint>
+
+namespace
+{
+    constexpr unsigned char keyEnd = 0x00;
+    constexpr unsigned char numberMarker = 0x01;
+
+    bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    unsigned char foldByte(char c)
+    {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (byte >= 'A' && byte <= 'Z')
+        {
+            return static_cast<unsigned char>(byte - 'A' + 'a');
+        }
+        return (byte <= numberMarker) ? numberMarker + 1 : byte;
+    }
+
+    /**
+     * Find the digit run starting at position: its significant digits and its end.
+     */
+    std::string_view digitRun(std::string_view key, size_t& position)
+    {
+        while (position < key.size() && key[position] == '0')
+        {
+            ++position;
+        }
+        size_t first = position;
+        while (position < key.size() && isDigit(key[position]))
+        {
+            ++position;
+        }
+        return key.substr(first, position - first);
+    }
+}
+
+std::string makeNaturalSortKey(std::string_view key)
+{
+    std::string sortKey;
+    sortKey.reserve(key.size() * 2 + 4);
+    size_t position = 0;
+    while (position < key.size())
+    {
+        if (!isDigit(key[position]))
+        {
+            sortKey += static_cast<char>(foldByte(key[position++]));
+            continue;
+        }
+
+        std::string_view digits = digitRun(key, position);
+        sortKey += static_cast<char>(numberMarker);
+        if (digits.size() < 0xFF)
+        {
+            sortKey += static_cast<char>(digits.size());
+        }
+        else
+        {
+            uint32_t length = static_cast<uint32_t>(digits.size());
+            sortKey += static_cast<char>(0xFF);
+            for (int shift = 24; shift >= 0; shift -= 8)
+            {
+                sortKey += static_cast<char>((length >> shift) & 0xFF);
+            }
+        }
+        sortKey.append(digits.data(), digits.size());
+    }
+    sortKey += static_cast<char>(keyEnd);
+    sortKey.append(key.data(), key.size());
+    return sortKey;
+}
+
+int naturalCompare(std::string_view a, std::string_view b)
+{
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size())
+    {
+        bool digitA = isDigit(a[i]);
+        bool digitB = isDigit(b[j]);
+        if (digitA && digitB)
+        {
+            std::string_view numberA = digitRun(a, i);
+            std::string_view numberB = digitRun(b, j);
+            if (numberA.size() != numberB.size())
+            {
+                return (numberA.size() < numberB.size()) ? -1 : 1;
+            }
+            int order = numberA.compare(numberB);
+            if (order != 0)
+            {
+                return order;
+            }
+        }
+        else if (digitA != digitB)
+        {
+            return digitA ? -1 : 1;
+        }
+        else
+        {
+            unsigned char byteA = foldByte(a[i++]);
+            unsigned char byteB = foldByte(b[j++]);
+            if (byteA != byteB)
+            {
+                return (byteA < byteB) ? -1 : 1;
+            }
+        }
+    }
+    if (i < a.size() || j < b.size())
+    {
+        return (i == a.size()) ? -1 : 1;
+    }
+    int order = a.compare(b);
+    return (order < 0) ? -1 : (order > 0 ? 1 : 0);
+}
@@ -0,0 +1,31 @@
+#ifndef NATURALSORTKEY_H
+#define NATURALSORTKEY_H
+
+#include <string>
+#include <string_view>
+
+/**
+ * Natural ("human") ordering of keys: "Item2" < "Item10", case-insensitive.
+ *
+ * makeNaturalSortKey() encodes a key once into a byte string whose plain byte-wise
+ * comparison (memcmp, std::string::compare) gives the natural order, so sorts and sorted
+ * indices never run the expensive natural comparison per comparison:
+ *
+ *  - letters are folded to lower case (ASCII);
+ *  - each run of digits becomes 0x01, the number of significant digits (one byte below
+ *    255, else 0xFF and four big-endian bytes) and the digits without leading zeros, so
+ *    shorter numbers sort first and numbers sort before text;
+ *  - 0x00 and the original key follow, so keys that differ only in case or leading zeros
+ *    still have a stable order.
+ *
+ * Bytes 0x00 and 0x01 in keys compare like 0x02.
+ */
+std::string makeNaturalSortKey(std::string_view key);
+
+/**
+ * Compare two keys in natural order without building sort keys.
+ * @return Negative, zero or positive, consistent with comparing their sort keys
+ */
+int naturalCompare(std::string_view a, std::string_view b);
+
+#endif // NATURALSORTKEY_H
@@ -0,0 +1,185 @@
+#ifndef NATURALSORTEDVIEW_H
+#define NATURALSORTEDVIEW_H
+
+#include "IItemView.h"
+#include "NaturalSortKey.h"
+#include "ParallelAlgorithms.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+/**
+ * Item view showing all items in natural key order ("Item2" before "Item10").
+ *
+ * A natural sort key is precomputed for every item and kept alongside the items, so the
+ * sort and later insertions compare plain byte strings. Rows map to items through the
+ * sorted order and items to rows through its inverse, both O(1).
+ *
+ * @tparam TDisplayItem The DisplayItem type
+ */
+template<typename TDisplayItem>
+class NaturalSortedView : public IItemView
+{
+public:
+    /**
+     * @param items Items of the controller the view is installed on
+     * @param pool Optional worker pool for building and sorting large lists
+     */
+    explicit NaturalSortedView(const std::vector<TDisplayItem>& items, WorkerPool* pool = nullptr)
+        : items(&items), sortKeys(items.size()), order(items.size())
+    {
+        auto buildKeys = [this](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                sortKeys[i] = makeNaturalSortKey((*this->items)[i].getKeyText());
+                order[i] = i;
+            }
+        };
+        auto bySortKey = [this](size_t a, size_t b) { return sortKeys[a] < sortKeys[b]; };
+        if (pool)
+        {
+            pool->parallelFor(items.size(), buildKeys, 4096);
+            parallelSort(*pool, order.begin(), order.end(), bySortKey);
+        }
+        else
+        {
+            buildKeys(0, items.size());
+            std::sort(order.begin(), order.end(), bySortKey);
+        }
+        rebuildRows();
+    }
+
+    /**
+     * Get the precomputed sort key of an item.
+     */
+    const std::string& getSortKey(size_t itemIndex) const
+    {
+        return sortKeys.at(itemIndex);
+    }
+
+    size_t getRowCount() const override
+    {
+        return order.size();
+    }
+
+    size_t getItemAtRow(size_t row) const override
+    {
+        return (row < order.size()) ? order[row] : noItem;
+    }
+
+    size_t getRowOfItem(size_t itemIndex) const override
+    {
+        return (itemIndex < rows.size()) ? rows[itemIndex] : noItem;
+    }
+
+    std::string getRowLabel(size_t row) const override
+    {
+        (void)row;
+        return std::string();
+    }
+
+    bool activateRow(size_t row) override
+    {
+        (void)row;
+        return false;
+    }
+
+    /**
+     * The item is placed at its sorted row (after equal keys). O(n) like the insertion.
+     */
+    void itemInserted(size_t itemIndex) override
+    {
+        sortKeys.insert(sortKeys.begin() + itemIndex, makeNaturalSortKey((*items)[itemIndex].getKeyText()));
+        for (auto& item : order)
+        {
+            item += (item >= itemIndex) ? 1 : 0;
+        }
+        auto position = std::upper_bound(order.begin(), order.end(), itemIndex,
+                                         [this](size_t a, size_t b) { return sortKeys[a] < sortKeys[b]; });
+        order.insert(position, itemIndex);
+        rebuildRows();
+    }
+
+    void itemRemoved(size_t itemIndex) override
+    {
+        order.erase(order.begin() + rows[itemIndex]);
+        for (auto& item : order)
+        {
+            item -= (item > itemIndex) ? 1 : 0;
+        }
+        sortKeys.erase(sortKeys.begin() + itemIndex);
+        rebuildRows();
+    }
+
+    void itemsRemoved(const std::vector<size_t>& itemIndices) override
+    {
+        std::vector<size_t> newIndex(sortKeys.size());
+        size_t kept = 0;
+        size_t next = 0;
+        for (size_t i = 0; i < sortKeys.size(); ++i)
+        {
+            if (next < itemIndices.size() && itemIndices[next] == i)
+            {
+                newIndex[i] = noItem;
+                ++next;
+                continue;
+            }
+            if (kept != i)
+            {
+                sortKeys[kept] = std::move(sortKeys[i]);
+            }
+            newIndex[i] = kept++;
+        }
+        sortKeys.resize(kept);
+
+        size_t row = 0;
+        for (size_t item : order)
+        {
+            if (newIndex[item] != noItem)
+            {
+                order[row++] = newIndex[item];
+            }
+        }
+        order.resize(row);
+        rebuildRows();
+    }
+
+    /**
+     * The new items are sorted among themselves and merged into the order (after equal
+     * keys). O(n + k log k) for k appended items.
+     */
+    void itemsAppended(size_t firstIndex, size_t count) override
+    {
+        auto bySortKey = [this](size_t a, size_t b) { return sortKeys[a] < sortKeys[b]; };
+        sortKeys.resize(firstIndex + count);
+        for (size_t i = firstIndex; i < firstIndex + count; ++i)
+        {
+            sortKeys[i] = makeNaturalSortKey((*items)[i].getKeyText());
+            order.push_back(i);
+        }
+        auto appended = order.end() - static_cast<std::ptrdiff_t>(count);
+        std::stable_sort(appended, order.end(), bySortKey);
+        std::inplace_merge(order.begin(), appended, order.end(), bySortKey);
+        rebuildRows();
+    }
+
+private:
+    const std::vector<TDisplayItem>* items;
+    std::vector<std::string> sortKeys;  // Natural sort key of each item
+    std::vector<size_t> order;          // Item shown on each row
+    std::vector<size_t> rows;           // Row of each item
+
+    void rebuildRows()
+    {
+        rows.resize(order.size());
+        for (size_t row = 0; row < order.size(); ++row)
+        {
+            rows[order[row]] = row;
+        }
+    }
+};
+
+#endif // NATURALSORTEDVIEW_H
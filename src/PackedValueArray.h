@@ -0,0 +1,217 @@
+#ifndef PACKEDVALUEARRAY_H
+#define PACKEDVALUEARRAY_H
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Bit-packed column of small unsigned values (flags, 0-15 counts, ...).
+ *
+ * Values are packed Bits at a time into 64-bit words and never straddle a word, so every
+ * update is a single compare-and-swap on one word and concurrent writers to neighbouring
+ * values never lose each other's updates. 10M one-bit flags take 1.25 MB.
+ *
+ * @tparam Bits Bits per value (1 to 32)
+ */
+template<unsigned Bits>
+class PackedValueArray
+{
+    static_assert(Bits >= 1 && Bits <= 32, "PackedValueArray supports 1 to 32 bits per value");
+
+public:
+    using Word = uint64_t;
+    static constexpr size_t valuesPerWord = 64 / Bits;
+    static constexpr Word maxValue = (Word(1) << Bits) - 1;
+
+private:
+    size_t count;
+    size_t wordCount;
+    std::unique_ptr<std::atomic<Word>[]> words;
+
+    static constexpr unsigned shiftOf(size_t index)
+    {
+        return static_cast<unsigned>((index % valuesPerWord) * Bits);
+    }
+
+    void validateIndex(size_t index) const
+    {
+        if (index >= count)
+        {
+            throw std::out_of_range("Packed value index out of range");
+        }
+    }
+
+    /**
+     * Atomically replace one value with update(oldValue); returns the old value.
+     */
+    template<typename TUpdate>
+    Word modify(size_t index, TUpdate update)
+    {
+        validateIndex(index);
+        std::atomic<Word>& word = words[index / valuesPerWord];
+        unsigned shift = shiftOf(index);
+        Word current = word.load(std::memory_order_relaxed);
+        Word oldValue;
+        Word replacement;
+        do
+        {
+            oldValue = (current >> shift) & maxValue;
+            replacement = (current & ~(maxValue << shift)) | ((update(oldValue) & maxValue) << shift);
+        } while (!word.compare_exchange_weak(current, replacement, std::memory_order_acq_rel,
+                                             std::memory_order_relaxed));
+        return oldValue;
+    }
+
+public:
+    /**
+     * @param count Number of values (all start at zero)
+     */
+    explicit PackedValueArray(size_t count)
+        : count(count), wordCount((count + valuesPerWord - 1) / valuesPerWord),
+          words(new std::atomic<Word>[wordCount])
+    {
+        for (size_t i = 0; i < wordCount; ++i)
+        {
+            words[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * Get the storage size in bytes.
+     */
+    size_t getByteSize() const
+    {
+        return wordCount * sizeof(Word);
+    }
+
+    Word get(size_t index) const
+    {
+        validateIndex(index);
+        return (words[index / valuesPerWord].load(std::memory_order_acquire) >> shiftOf(index)) & maxValue;
+    }
+
+    /**
+     * Store a value (thread-safe).
+     * @throws std::out_of_range if the value does not fit in Bits
+     */
+    void set(size_t index, Word value)
+    {
+        if (value > maxValue)
+        {
+            throw std::out_of_range("Value does not fit the packed column width");
+        }
+        modify(index, [value](Word) { return value; });
+    }
+
+    /**
+     * Increment a value, saturating at maxValue (thread-safe).
+     * @return The new value
+     */
+    Word increment(size_t index)
+    {
+        Word oldValue = modify(index, [](Word v) { return v < maxValue ? v + 1 : v; });
+        return oldValue < maxValue ? oldValue + 1 : oldValue;
+    }
+
+    /**
+     * Decrement a value, saturating at zero (thread-safe).
+     * @return The new value
+     */
+    Word decrement(size_t index)
+    {
+        Word oldValue = modify(index, [](Word v) { return v > 0 ? v - 1 : v; });
+        return oldValue > 0 ? oldValue - 1 : oldValue;
+    }
+
+    /**
+     * Atomically set a value only if it still equals expected (thread-safe).
+     * @return true if the value was replaced
+     */
+    bool compareExchange(size_t index, Word expected, Word desired)
+    {
+        if (desired > maxValue)
+        {
+            throw std::out_of_range("Value does not fit the packed column width");
+        }
+        bool replaced = false;
+        modify(index, [&](Word v)
+        {
+            replaced = (v == expected);
+            return replaced ? desired : v;
+        });
+        return replaced;
+    }
+
+    /**
+     * Unpack a range of values (e.g., the visible window) into a plain array.
+     * Whole words are unpacked with a fixed shift pattern that the compiler vectorizes.
+     *
+     * @param first Index of the first value
+     * @param length Number of values to unpack
+     * @param out Destination (length elements)
+     */
+    template<typename TOut>
+    void unpack(size_t first, size_t length, TOut* out) const
+    {
+        if (first > count || length > count - first)
+        {
+            throw std::out_of_range("Packed value range out of range");
+        }
+
+        size_t index = first;
+        size_t end = first + length;
+
+        // Leading values up to a word boundary
+        while (index < end && index % valuesPerWord != 0)
+        {
+            *out++ = static_cast<TOut>((words[index / valuesPerWord].load(std::memory_order_acquire)
+                                        >> shiftOf(index)) & maxValue);
+            ++index;
+        }
+
+        // Whole words
+        for (; index + valuesPerWord <= end; index += valuesPerWord)
+        {
+            Word word = words[index / valuesPerWord].load(std::memory_order_acquire);
+            for (size_t k = 0; k < valuesPerWord; ++k)
+            {
+                out[k] = static_cast<TOut>((word >> (k * Bits)) & maxValue);
+            }
+            out += valuesPerWord;
+        }
+
+        // Trailing values
+        if (index < end)
+        {
+            Word word = words[index / valuesPerWord].load(std::memory_order_acquire);
+            for (size_t k = 0; index < end; ++k, ++index)
+            {
+                *out++ = static_cast<TOut>((word >> (k * Bits)) & maxValue);
+            }
+        }
+    }
+};
+
+/**
+ * Number of bits needed to store values 0..maxValue.
+ */
+constexpr unsigned packedBitsFor(uint64_t maxValue)
+{
+    return (maxValue <= 1) ? 1 : 1 + packedBitsFor(maxValue >> 1);
+}
+
+/**
+ * Packed column sized from a compile-time value range, e.g. PackedRangeArray<15> uses 4 bits.
+ */
+template<uint64_t MaxValue>
+using PackedRangeArray = PackedValueArray<packedBitsFor(MaxValue)>;
+
+#endif // PACKEDVALUEARRAY_H
@@ -0,0 +1,104 @@
+#include "PagedDisplay.h"
+#include <stdexcept>
+
+PagedDisplay::PagedDisplay()
+    : m_activePage(0), m_visible(true)
+{
+}
+
+size_t PagedDisplay::addPage(std::shared_ptr<IDisplayPage> page)
+{
+    if (!page)
+    {
+        throw std::invalid_argument("Page cannot be null");
+    }
+
+    bool isFirstPage = m_pages.empty();
+    page->setVisible(isFirstPage && m_visible);
+    m_pages.push_back(std::move(page));
+    return m_pages.size() - 1;
+}
+
+bool PagedDisplay::showPage(size_t pageIndex)
+{
+    if (pageIndex >= m_pages.size())
+    {
+        throw std::out_of_range("Page index out of range");
+    }
+    if (pageIndex == m_activePage)
+    {
+        return false;
+    }
+
+    m_pages[m_activePage]->setVisible(false);
+    m_activePage = pageIndex;
+
+    // The physical display still shows the old page, so the new one must repaint
+    // even if none of its items changed while it was hidden.
+    IDisplayPage& page = *m_pages[m_activePage];
+    page.invalidate();
+    page.setVisible(m_visible);
+    return true;
+}
+
+bool PagedDisplay::nextPage()
+{
+    if (m_pages.empty())
+    {
+        return false;
+    }
+    return showPage((m_activePage + 1) % m_pages.size());
+}
+
+bool PagedDisplay::previousPage()
+{
+    if (m_pages.empty())
+    {
+        return false;
+    }
+    return showPage((m_activePage + m_pages.size() - 1) % m_pages.size());
+}
+
+bool PagedDisplay::setVisible(bool shouldBeVisible)
+{
+    if (m_visible == shouldBeVisible)
+    {
+        return false;
+    }
+
+    m_visible = shouldBeVisible;
+    if (!m_pages.empty())
+    {
+        m_pages[m_activePage]->setVisible(m_visible);
+    }
+    return true;
+}
+
+bool PagedDisplay::isVisible() const
+{
+    return m_visible;
+}
+
+size_t PagedDisplay::getActivePageIndex() const
+{
+    return m_activePage;
+}
+
+size_t PagedDisplay::getPageCount() const
+{
+    return m_pages.size();
+}
+
+IDisplayPage& PagedDisplay::getActivePage()
+{
+    return getPage(m_activePage);
+}
+
+IDisplayPage& PagedDisplay::getPage(size_t pageIndex)
+{
+    if (pageIndex >= m_pages.size())
+    {
+        throw std::out_of_range("Page index out of range");
+    }
+    return *m_pages[pageIndex];
+}
@@ -0,0 +1,63 @@
+#ifndef PAGEDDISPLAY_H
+#define PAGEDDISPLAY_H
+
+#include "IDisplayPage.h"
+#include <memory>
+#include <vector>
+
+/**
+ * Container that cycles one physical display between several logical pages
+ * (e.g., inventory, alerts, totals), each backed by its own controller.
+ *
+ * Only the active page is visible and therefore formatted; inactive pages keep
+ * accepting mutations but only accumulate a dirty flag. Switching pages hides the
+ * old page and shows the new one, which costs exactly one frame.
+ */
+class PagedDisplay
+{
+public:
+    PagedDisplay();
+
+    /**
+     * Add a page. The first page added becomes the active page; all others are hidden.
+     * @return Index of the new page
+     */
+    size_t addPage(std::shared_ptr<IDisplayPage> page);
+
+    /**
+     * Make the given page active and render it with a single frame.
+     * @return true if the active page changed
+     */
+    bool showPage(size_t pageIndex);
+
+    /**
+     * Cycle to the next page (wraps around).
+     * @return true if the active page changed
+     */
+    bool nextPage();
+
+    /**
+     * Cycle to the previous page (wraps around).
+     * @return true if the active page changed
+     */
+    bool previousPage();
+
+    /**
+     * Show or hide the whole display (e.g., backlight). Only the active page is affected.
+     * @return true if visibility changed
+     */
+    bool setVisible(bool shouldBeVisible);
+
+    bool isVisible() const;
+    size_t getActivePageIndex() const;
+    size_t getPageCount() const;
+    IDisplayPage& getActivePage();
+    IDisplayPage& getPage(size_t pageIndex);
+
+private:
+    std::vector<std::shared_ptr<IDisplayPage>> m_pages;
+    size_t m_activePage;
+    bool m_visible;
+};
+
+#endif // PAGEDDISPLAY_H
@@ -0,0 +1,114 @@
+#ifndef PARALLELALGORITHMS_H
+#define PARALLELALGORITHMS_H
+
+#include "WorkerPool.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+/**
+ * Parallel building blocks for start-up work on large item sets (sorted orders, aggregates).
+ * Each splits its input into one piece per pool thread; results are identical to the
+ * serial algorithms, only the time to produce them shrinks with the core count.
+ */
+
+/**
+ * Get the boundaries of pieceCount near-equal pieces of [0, count).
+ */
+inline std::vector<size_t> splitRange(size_t count, size_t pieceCount)
+{
+    pieceCount = std::max<size_t>(1, std::min(pieceCount, count));
+    std::vector<size_t> bounds(pieceCount + 1);
+    for (size_t i = 0; i <= pieceCount; ++i)
+    {
+        bounds[i] = count * i / pieceCount;
+    }
+    return bounds;
+}
+
+/**
+ * Sort a random-access range: pieces are sorted in parallel, then merged pairwise in
+ * parallel rounds. Not stable.
+ *
+ * @param pool Worker pool providing the threads
+ * @param minPiece Ranges shorter than this per thread are sorted serially
+ */
+template<typename TIterator, typename TCompare = std::less<typename std::iterator_traits<TIterator>::value_type>>
+void parallelSort(WorkerPool& pool, TIterator first, TIterator last, TCompare compare = TCompare(),
+                  size_t minPiece = 4096)
+{
+    size_t count = static_cast<size_t>(last - first);
+    size_t pieceCount = std::min(pool.getConcurrency(), count / std::max<size_t>(minPiece, 1));
+    if (pieceCount <= 1)
+    {
+        std::sort(first, last, compare);
+        return;
+    }
+
+    std::vector<size_t> bounds = splitRange(count, pieceCount);
+    pool.parallelFor(pieceCount, [&](size_t begin, size_t end)
+    {
+        for (size_t piece = begin; piece < end; ++piece)
+        {
+            std::sort(first + bounds[piece], first + bounds[piece + 1], compare);
+        }
+    });
+
+    // Merge neighbouring runs until one remains; the merges of a round are independent
+    for (size_t width = 1; width < pieceCount; width *= 2)
+    {
+        size_t mergeCount = (pieceCount + 2 * width - 1) / (2 * width);
+        pool.parallelFor(mergeCount, [&](size_t begin, size_t end)
+        {
+            for (size_t merge = begin; merge < end; ++merge)
+            {
+                size_t left = merge * 2 * width;
+                size_t middle = std::min(left + width, pieceCount);
+                size_t right = std::min(left + 2 * width, pieceCount);
+                if (middle < right)
+                {
+                    std::inplace_merge(first + bounds[left], first + bounds[middle],
+                                       first + bounds[right], compare);
+                }
+            }
+        });
+    }
+}
+
+/**
+ * Reduce [0, count) in parallel: each piece is reduced by reducePiece(begin, end), and
+ * the partial results are combined in piece order, so combine only needs to be associative.
+ *
+ * @param reducePiece Callable (size_t begin, size_t end) -> T
+ * @param combine Callable (T, T) -> T
+ */
+template<typename T, typename TReducePiece, typename TCombine>
+T parallelReduce(WorkerPool& pool, size_t count, T identity, TReducePiece reducePiece, TCombine combine,
+                 size_t minPiece = 4096)
+{
+    size_t pieceCount = std::min(pool.getConcurrency(), count / std::max<size_t>(minPiece, 1));
+    if (pieceCount <= 1)
+    {
+        return count > 0 ? combine(identity, reducePiece(0, count)) : identity;
+    }
+
+    std::vector<size_t> bounds = splitRange(count, pieceCount);
+    std::vector<T> partials(pieceCount, identity);
+    pool.parallelFor(pieceCount, [&](size_t begin, size_t end)
+    {
+        for (size_t piece = begin; piece < end; ++piece)
+        {
+            partials[piece] = reducePiece(bounds[piece], bounds[piece + 1]);
+        }
+    });
+
+    T result = identity;
+    for (const T& partial : partials)
+    {
+        result = combine(result, partial);
+    }
+    return result;
+}
+
+#endif // PARALLELALGORITHMS_H
@@ -0,0 +1,394 @@
+#ifndef PERIODICSAMPLER_H
+#define PERIODICSAMPLER_H
+
+#include "LCDDisplayController.h"
+#include "IStructureListener.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+/**
+ * Batched periodic sampling of value sources (sysfs/proc files, sensors, counters).
+ *
+ * Sources are grouped by sampling period. On every tick all due sources are read in one
+ * batch - slow sources in parallel on an optional WorkerPool - and the results are applied
+ * to the controller as a single bulk update, so a tick costs at most one frame.
+ * Sources whose rows are not visible (scrolled away, or display hidden) are sampled only
+ * every hiddenDivisor-th period.
+ *
+ * Ticks come from a timerfd on Linux (see getTimerFd() to integrate with an existing poll
+ * loop, or run() for a dedicated loop); tick() can also be called directly by the host.
+ * All controller access happens on the thread that calls tick().
+ *
+ * Sources follow their items when items are inserted or removed through the controller;
+ * the sources of removed items are dropped.
+ *
+ * @tparam TDisplayItem The DisplayItem type of the controller being fed
+ */
+template<typename TDisplayItem>
+class PeriodicSampler : public IStructureListener
+{
+public:
+    using Controller = LCDDisplayController<TDisplayItem>;
+    using ValueType = typename Controller::ValueType;
+    using Clock = typename Controller::Clock;
+    using ReadFunction = std::function<ValueType()>;
+
+    /**
+     * Per-source sampling options.
+     */
+    struct SourceOptions
+    {
+        bool slow;                  // Read on the worker pool (blocking or expensive sources)
+        unsigned hiddenDivisor;     // Sample every Nth period while the row is not visible
+
+        SourceOptions(bool slow = false, unsigned hiddenDivisor = 4)
+            : slow(slow), hiddenDivisor(hiddenDivisor)
+        {
+        }
+    };
+
+private:
+    struct Source
+    {
+        size_t itemIndex;
+        ReadFunction read;
+        SourceOptions options;
+        unsigned skippedPeriods;
+    };
+
+    struct Group
+    {
+        std::chrono::milliseconds period;
+        typename Clock::time_point nextDue;
+        std::vector<Source> sources;
+    };
+
+    struct SlowReading
+    {
+        Source* source;
+        ValueType value;
+        bool ok;
+    };
+
+    Controller& controller;
+    std::shared_ptr<WorkerPool> pool;
+    std::vector<Group> groups;
+    std::chrono::milliseconds tickInterval;
+    std::vector<typename Controller::ValueUpdate> updates;  // Reused between ticks
+    std::vector<SlowReading> slowReadings;                  // Reused between ticks
+    std::atomic<bool> running;
+    int timerFd;
+
+    bool isDue(Source& source)
+    {
+        if (source.options.hiddenDivisor <= 1 || controller.isItemVisible(source.itemIndex))
+        {
+            source.skippedPeriods = 0;
+            return true;
+        }
+        if (++source.skippedPeriods >= source.options.hiddenDivisor)
+        {
+            source.skippedPeriods = 0;
+            return true;
+        }
+        return false;
+    }
+
+    void armTimer()
+    {
+#ifdef __linux__
+        if (timerFd < 0)
+        {
+            return;
+        }
+        auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(tickInterval).count();
+        itimerspec spec{};
+        spec.it_interval.tv_sec = static_cast<time_t>(interval / 1000000000);
+        spec.it_interval.tv_nsec = static_cast<long>(interval % 1000000000);
+        spec.it_value = spec.it_interval;
+        timerfd_settime(timerFd, 0, &spec, nullptr);
+#endif
+    }
+
+public:
+    /**
+     * @param controller Controller receiving the sampled values
+     * @param pool Optional worker pool for slow sources (read inline when null)
+     */
+    explicit PeriodicSampler(Controller& controller, std::shared_ptr<WorkerPool> pool = nullptr)
+        : controller(controller), pool(std::move(pool)), tickInterval(0), running(false), timerFd(-1)
+    {
+        controller.addStructureListener(this);
+    }
+
+    ~PeriodicSampler()
+    {
+        controller.removeStructureListener(this);
+#ifdef __linux__
+        if (timerFd >= 0)
+        {
+            ::close(timerFd);
+        }
+#endif
+    }
+
+    PeriodicSampler(const PeriodicSampler&) = delete;
+    PeriodicSampler& operator=(const PeriodicSampler&) = delete;
+
+    /**
+     * Register a source for an item. Sources with the same period are read in the same batch.
+     * @param itemIndex Item receiving the values
+     * @param period Sampling period
+     * @param read Callable returning the current value (may throw to skip a sample)
+     * @param options Slow-source and hidden-row options
+     */
+    void addSource(size_t itemIndex, std::chrono::milliseconds period, ReadFunction read,
+                   const SourceOptions& options = SourceOptions())
+    {
+        if (itemIndex >= controller.getItemCount())
+        {
+            throw std::out_of_range("Item index out of range");
+        }
+        if (period.count() <= 0)
+        {
+            throw std::invalid_argument("Sampling period must be positive");
+        }
+        if (!read)
+        {
+            throw std::invalid_argument("Read function cannot be empty");
+        }
+
+        Source source{itemIndex, std::move(read), options, 0};
+        auto group = std::find_if(groups.begin(), groups.end(),
+                                  [&](const Group& g) { return g.period == period; });
+        if (group == groups.end())
+        {
+            groups.push_back(Group{period, Clock::now(), {}});
+            group = groups.end() - 1;
+        }
+        group->sources.push_back(std::move(source));
+
+        // Ticks happen at the greatest common divisor of all periods
+        tickInterval = std::chrono::milliseconds(std::gcd(tickInterval.count(), period.count()));
+        armTimer();
+    }
+
+    void itemsInserted(size_t firstIndex, size_t count) override
+    {
+        for (auto& group : groups)
+        {
+            for (auto& source : group.sources)
+            {
+                source.itemIndex += (source.itemIndex >= firstIndex) ? count : 0;
+            }
+        }
+    }
+
+    void itemsRemoved(const std::vector<size_t>& itemIndices) override
+    {
+        for (auto& group : groups)
+        {
+            auto removed = std::remove_if(group.sources.begin(), group.sources.end(),
+                [&itemIndices](const Source& source)
+                {
+                    return std::binary_search(itemIndices.begin(), itemIndices.end(), source.itemIndex);
+                });
+            group.sources.erase(removed, group.sources.end());
+            for (auto& source : group.sources)
+            {
+                source.itemIndex -= static_cast<size_t>(
+                    std::lower_bound(itemIndices.begin(), itemIndices.end(), source.itemIndex) -
+                    itemIndices.begin());
+            }
+        }
+    }
+
+    /**
+     * Read every due source and apply the results as one bulk update.
+     * @return Number of sources read
+     */
+    size_t tick(typename Clock::time_point now = Clock::now())
+    {
+        updates.clear();
+        slowReadings.clear();
+        size_t readCount = 0;
+
+        for (auto& group : groups)
+        {
+            if (now < group.nextDue)
+            {
+                continue;
+            }
+            group.nextDue += group.period;
+            if (group.nextDue <= now)
+            {
+                // Fell behind (e.g., host was suspended): resynchronize instead of bursting
+                group.nextDue = now + group.period;
+            }
+
+            for (auto& source : group.sources)
+            {
+                if (!isDue(source))
+                {
+                    continue;
+                }
+                ++readCount;
+                if (source.options.slow)
+                {
+                    slowReadings.push_back(SlowReading{&source, ValueType(), false});
+                    continue;
+                }
+                try
+                {
+                    updates.emplace_back(source.itemIndex, source.read());
+                }
+                catch (const std::exception&)
+                {
+                    // Unreadable source: keep the last displayed value
+                }
+            }
+        }
+
+        auto readSlow = [this](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                try
+                {
+                    slowReadings[i].value = slowReadings[i].source->read();
+                    slowReadings[i].ok = true;
+                }
+                catch (const std::exception&)
+                {
+                }
+            }
+        };
+        if (pool)
+        {
+            pool->parallelFor(slowReadings.size(), readSlow);
+        }
+        else
+        {
+            readSlow(0, slowReadings.size());
+        }
+        for (const auto& reading : slowReadings)
+        {
+            if (reading.ok)
+            {
+                updates.emplace_back(reading.source->itemIndex, reading.value);
+            }
+        }
+
+        if (!updates.empty())
+        {
+            controller.applyUpdates(updates, now);
+        }
+        return readCount;
+    }
+
+    /**
+     * Get a timerfd that becomes readable on every tick (Linux only, -1 elsewhere).
+     * Add it to the host's poll loop and call handleTimer() when it is readable.
+     */
+    int getTimerFd()
+    {
+#ifdef __linux__
+        if (timerFd < 0)
+        {
+            timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+            if (timerFd < 0)
+            {
+                throw std::runtime_error("Cannot create sampler timer");
+            }
+            armTimer();
+        }
+#endif
+        return timerFd;
+    }
+
+    /**
+     * Consume pending timer expirations and run one tick.
+     * @return Number of sources read
+     */
+    size_t handleTimer()
+    {
+#ifdef __linux__
+        uint64_t expirations = 0;
+        if (timerFd >= 0 && ::read(timerFd, &expirations, sizeof(expirations)) <= 0)
+        {
+            return 0;
+        }
+#endif
+        return tick();
+    }
+
+    /**
+     * Sample until stop() is called from another thread.
+     */
+    void run()
+    {
+        running = true;
+#ifdef __linux__
+        pollfd descriptor{getTimerFd(), POLLIN, 0};
+        while (running)
+        {
+            // Bounded wait so that stop() is noticed even with long periods
+            if (::poll(&descriptor, 1, 100) > 0)
+            {
+                handleTimer();
+            }
+        }
+#else
+        while (running)
+        {
+            std::this_thread::sleep_for(tickInterval.count() > 0 ? tickInterval : std::chrono::milliseconds(100));
+            tick();
+        }
+#endif
+    }
+
+    /**
+     * Ask run() to return.
+     */
+    void stop()
+    {
+        running = false;
+    }
+
+    std::chrono::milliseconds getTickInterval() const
+    {
+        return tickInterval;
+    }
+
+    size_t getGroupCount() const
+    {
+        return groups.size();
+    }
+
+    size_t getSourceCount() const
+    {
+        size_t count = 0;
+        for (const auto& group : groups)
+        {
+            count += group.sources.size();
+        }
+        return count;
+    }
+};
+
+#endif // PERIODICSAMPLER_H
@@ -0,0 +1,166 @@
+#ifndef POSITIONINDICATOR_H
+#define POSITIONINDICATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Glyphs for a scroll position indicator column.
+ *
+ * With CGRAM glyphs each display row is split into eight sub-positions (glyph N draws the
+ * thumb on pixel row N), giving a smooth indicator on a 2-row display. The CGRAM codes are
+ * the same eight user-defined characters used by BarGlyphs::cgram(), so only one of the two
+ * can use CGRAM at a time (the controller rejects the combination); the ASCII fallback
+ * moves one whole row at a time.
+ */
+struct PositionGlyphs
+{
+    static constexpr size_t maxLevels = 8;
+
+    char track;                             // Column background
+    std::array<char, maxLevels> thumbs;     // Thumb at sub-position 0 (top) to levels-1
+    size_t levels;                          // Sub-positions per display row
+
+    static constexpr PositionGlyphs cgram()
+    {
+        return PositionGlyphs{' ', {'\x08', '\x09', '\x0A', '\x0B', '\x0C', '\x0D', '\x0E', '\x0F'}, 8};
+    }
+
+    static constexpr PositionGlyphs ascii()
+    {
+        return PositionGlyphs{'|', {'#', '#', '#', '#', '#', '#', '#', '#'}, 1};
+    }
+
+    /**
+     * Check whether the track or a used thumb is a CGRAM character (codes 0x00-0x0F).
+     */
+    constexpr bool usesCgram() const
+    {
+        if (static_cast<unsigned char>(track) < 0x10)
+        {
+            return true;
+        }
+        for (size_t i = 0; i < levels && i < maxLevels; ++i)
+        {
+            if (static_cast<unsigned char>(thumbs[i]) < 0x10)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Get the 5x8 bitmap row of the CGRAM thumb glyph for a sub-position.
+     * @param level Sub-position (0 = top pixel row)
+     * @param row Pixel row, 0 being the top row
+     */
+    static constexpr uint8_t getCgramPattern(size_t level, size_t row)
+    {
+        return (row == level) ? 0x0E : 0x00;
+    }
+};
+
+/**
+ * Scroll position indicator for one display geometry.
+ *
+ * The thumb position is computed in O(1) from the selected row and the row count, then
+ * quantized to the resolution of the column (rows x glyph levels). The column glyphs are
+ * only rebuilt when the quantized position changes, so most navigation steps reuse them.
+ */
+class PositionIndicator
+{
+public:
+    static constexpr size_t hidden = static_cast<size_t>(-1);
+
+private:
+    PositionGlyphs glyphs;
+    size_t position;        // Quantized thumb position, or hidden
+    size_t rows;
+    std::vector<char> column;
+    size_t rebuildCount;
+
+public:
+    explicit PositionIndicator(const PositionGlyphs& glyphs = PositionGlyphs::ascii())
+        : glyphs(glyphs), position(hidden), rows(0), rebuildCount(0)
+    {
+        if (glyphs.levels == 0 || glyphs.levels > PositionGlyphs::maxLevels)
+        {
+            this->glyphs.levels = 1;
+        }
+    }
+
+    /**
+     * Quantize the selected row to a thumb position in [0, visibleRows * levels).
+     * Returns hidden when everything fits on screen.
+     */
+    static size_t quantize(size_t selectedRow, size_t rowCount, size_t visibleRows, size_t levels)
+    {
+        if (rowCount <= visibleRows || visibleRows == 0)
+        {
+            return hidden;
+        }
+        size_t positions = visibleRows * levels;
+        size_t row = (selectedRow < rowCount) ? selectedRow : rowCount - 1;
+        if (rowCount >= positions)
+        {
+            // Equal share of rows per position
+            return row * positions / rowCount;
+        }
+        // Fewer rows than positions: spread them so the first and last rows hit both ends
+        return row * (positions - 1) / (rowCount - 1);
+    }
+
+    /**
+     * Bring the column up to date for a new selection.
+     * @return true if the column glyphs changed
+     */
+    bool update(size_t selectedRow, size_t rowCount, size_t visibleRows)
+    {
+        size_t newPosition = quantize(selectedRow, rowCount, visibleRows, glyphs.levels);
+        if (newPosition == position && visibleRows == rows)
+        {
+            return false;
+        }
+
+        position = newPosition;
+        rows = visibleRows;
+        column.assign(rows, (position == hidden) ? ' ' : glyphs.track);
+        if (position != hidden)
+        {
+            column[position / glyphs.levels] = glyphs.thumbs[position % glyphs.levels];
+        }
+        ++rebuildCount;
+        return true;
+    }
+
+    /**
+     * Get the glyph for a row of the window (after update()).
+     */
+    char glyphAt(size_t rowIndex) const
+    {
+        return (rowIndex < column.size()) ? column[rowIndex] : ' ';
+    }
+
+    size_t getPosition() const
+    {
+        return position;
+    }
+
+    const PositionGlyphs& getGlyphs() const
+    {
+        return glyphs;
+    }
+
+    /**
+     * Number of times the column was rebuilt (a measure of redraw work).
+     */
+    size_t getRebuildCount() const
+    {
+        return rebuildCount;
+    }
+};
+
+#endif // POSITIONINDICATOR_H
@@ -0,0 +1,338 @@
+#ifndef QUERYVIEW_H
+#define QUERYVIEW_H
+
+#include "IItemView.h"
+#include "ItemQuery.h"
+#include "BitOps.h"
+#include "FenwickTree.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Item view showing the items that match an ItemQuery, in item order.
+ *
+ * Keys and values are copied into columns (a contiguous value array and a flat key
+ * buffer) and the compiled query is evaluated over them tile by tile, optionally on a
+ * WorkerPool, into a match bitmap. Set bits per bitmap word are kept in a Fenwick tree,
+ * so mapping rows to items and back is O(log n) without materializing an index list.
+ *
+ * The view reads the controller's items: construct it from controller.getItems(). Value
+ * changes re-evaluate only the changed item (itemChanged()); insertions and removals
+ * shift the columns and bitmap.
+ *
+ * @tparam TDisplayItem The DisplayItem type (numeric values)
+ */
+template<typename TDisplayItem>
+class QueryView : public IItemView
+{
+public:
+    using ValueType = decltype(std::declval<TDisplayItem>().getValue());
+
+    static_assert(std::is_arithmetic<ValueType>::value, "QueryView requires numeric item values");
+
+    /**
+     * @param items Items of the controller the view is installed on
+     * @param query Filter to apply (matches everything by default)
+     * @param pool Optional worker pool for evaluating large lists
+     */
+    explicit QueryView(const std::vector<TDisplayItem>& items, ItemQuery query = ItemQuery(),
+                       WorkerPool* pool = nullptr)
+        : items(&items), query(std::move(query)), pool(pool)
+    {
+        rebuild();
+    }
+
+    /**
+     * Replace the query and re-evaluate it. Call the controller's refreshView() afterwards.
+     */
+    void setQuery(ItemQuery newQuery)
+    {
+        query = std::move(newQuery);
+        evaluate();
+    }
+
+    const ItemQuery& getQuery() const
+    {
+        return query;
+    }
+
+    /**
+     * Re-read all keys and values from the items and re-evaluate the query
+     * (e.g., after keys were changed through getItems()).
+     */
+    void rebuild()
+    {
+        size_t count = items->size();
+        values.resize(count);
+        keyText.clear();
+        keyOffsets.assign(1, 0);
+        keyOffsets.reserve(count + 1);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = (*items)[i].getValue();
+            keyText += (*items)[i].getKeyText();
+            keyOffsets.push_back(static_cast<uint32_t>(keyText.size()));
+        }
+        evaluate();
+    }
+
+    /**
+     * Get the number of matching items.
+     */
+    size_t getMatchCount() const
+    {
+        return matchCounts.total();
+    }
+
+    /**
+     * Get the match bitmap (bit i of word i / 64 is set if item i matches).
+     */
+    const std::vector<uint64_t>& getBitmap() const
+    {
+        return bitmap;
+    }
+
+    bool isMatch(size_t itemIndex) const
+    {
+        return itemIndex < values.size() && ((bitmap[itemIndex / 64] >> (itemIndex % 64)) & 1) != 0;
+    }
+
+    size_t getRowCount() const override
+    {
+        return matchCounts.total();
+    }
+
+    size_t getItemAtRow(size_t row) const override
+    {
+        if (row >= matchCounts.total())
+        {
+            return noItem;
+        }
+        size_t word = matchCounts.findByPosition(row);
+        size_t rank = row - matchCounts.prefixSum(word);
+        return word * 64 + selectBit(bitmap[word], rank);
+    }
+
+    size_t getRowOfItem(size_t itemIndex) const override
+    {
+        if (!isMatch(itemIndex))
+        {
+            return noItem;
+        }
+        size_t word = itemIndex / 64;
+        uint64_t below = (uint64_t(1) << (itemIndex % 64)) - 1;
+        return matchCounts.prefixSum(word) + popCount(bitmap[word] & below);
+    }
+
+    std::string getRowLabel(size_t row) const override
+    {
+        (void)row;
+        return std::string();
+    }
+
+    bool activateRow(size_t row) override
+    {
+        (void)row;
+        return false;
+    }
+
+    /**
+     * Re-evaluate the query for one item. O(log n).
+     */
+    bool itemChanged(size_t itemIndex) override
+    {
+        values[itemIndex] = (*items)[itemIndex].getValue();
+        bool match = query.matches(values[itemIndex], keyOf(itemIndex));
+        if (match == isMatch(itemIndex))
+        {
+            return false;
+        }
+        bitmap[itemIndex / 64] ^= uint64_t(1) << (itemIndex % 64);
+        if (match)
+        {
+            matchCounts.add(itemIndex / 64, 1);
+        }
+        else
+        {
+            matchCounts.subtract(itemIndex / 64, 1);
+        }
+        return true;
+    }
+
+    /**
+     * Called after the item was inserted into the items. O(n) like the insertion itself.
+     */
+    void itemInserted(size_t itemIndex) override
+    {
+        const TDisplayItem& item = (*items)[itemIndex];
+        std::string key = item.getKeyText();
+        values.insert(values.begin() + itemIndex, item.getValue());
+        keyText.insert(keyOffsets[itemIndex], key);
+        keyOffsets.insert(keyOffsets.begin() + itemIndex + 1, keyOffsets[itemIndex]);
+        for (size_t i = itemIndex + 1; i < keyOffsets.size(); ++i)
+        {
+            keyOffsets[i] += static_cast<uint32_t>(key.size());
+        }
+
+        if (values.size() > bitmap.size() * 64)
+        {
+            bitmap.push_back(0);
+        }
+        uint64_t carry = query.matches(values[itemIndex], keyOf(itemIndex)) ? 1 : 0;
+        size_t word = itemIndex / 64;
+        uint64_t below = (uint64_t(1) << (itemIndex % 64)) - 1;
+        uint64_t old = bitmap[word];
+        bitmap[word] = (old & below) | (carry << (itemIndex % 64)) | ((old & ~below) << 1);
+        carry = old >> 63;
+        for (size_t w = word + 1; w < bitmap.size(); ++w)
+        {
+            old = bitmap[w];
+            bitmap[w] = (old << 1) | carry;
+            carry = old >> 63;
+        }
+        rebuildMatchCounts();
+    }
+
+    /**
+     * Called before the item is removed from the items. O(n) like the removal itself.
+     */
+    void itemRemoved(size_t itemIndex) override
+    {
+        uint32_t keyLength = keyOffsets[itemIndex + 1] - keyOffsets[itemIndex];
+        values.erase(values.begin() + itemIndex);
+        keyText.erase(keyOffsets[itemIndex], keyLength);
+        keyOffsets.erase(keyOffsets.begin() + itemIndex + 1);
+        for (size_t i = itemIndex + 1; i < keyOffsets.size(); ++i)
+        {
+            keyOffsets[i] -= keyLength;
+        }
+
+        size_t word = itemIndex / 64;
+        uint64_t below = (uint64_t(1) << (itemIndex % 64)) - 1;
+        for (size_t w = word; w < bitmap.size(); ++w)
+        {
+            uint64_t next = (w + 1 < bitmap.size()) ? bitmap[w + 1] & 1 : 0;
+            uint64_t shifted = (bitmap[w] >> 1) | (next << 63);
+            bitmap[w] = (w == word) ? (bitmap[w] & below) | (shifted & ~below) : shifted;
+        }
+        bitmap.resize((values.size() + 63) / 64);
+        rebuildMatchCounts();
+    }
+
+    /**
+     * Called before the items are removed. Columns and bitmap are compacted in one pass.
+     */
+    void itemsRemoved(const std::vector<size_t>& itemIndices) override
+    {
+        std::string keptText;
+        keptText.reserve(keyText.size());
+        std::vector<uint32_t> keptOffsets(1, 0);
+        keptOffsets.reserve(values.size() - itemIndices.size() + 1);
+        std::vector<uint64_t> keptBitmap((values.size() - itemIndices.size() + 63) / 64, 0);
+        size_t kept = 0;
+        size_t next = 0;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (next < itemIndices.size() && itemIndices[next] == i)
+            {
+                ++next;
+                continue;
+            }
+            values[kept] = values[i];
+            keptText.append(keyText, keyOffsets[i], keyOffsets[i + 1] - keyOffsets[i]);
+            keptOffsets.push_back(static_cast<uint32_t>(keptText.size()));
+            keptBitmap[kept / 64] |= ((bitmap[i / 64] >> (i % 64)) & 1) << (kept % 64);
+            ++kept;
+        }
+        values.resize(kept);
+        keyText.swap(keptText);
+        keyOffsets.swap(keptOffsets);
+        bitmap.swap(keptBitmap);
+        rebuildMatchCounts();
+    }
+
+    /**
+     * Called after the items were appended. Only the new items are evaluated.
+     */
+    void itemsAppended(size_t firstIndex, size_t count) override
+    {
+        for (size_t i = firstIndex; i < firstIndex + count; ++i)
+        {
+            const TDisplayItem& item = (*items)[i];
+            values.push_back(item.getValue());
+            keyText += item.getKeyText();
+            keyOffsets.push_back(static_cast<uint32_t>(keyText.size()));
+        }
+        bitmap.resize((values.size() + 63) / 64, 0);
+        for (size_t i = firstIndex; i < firstIndex + count; ++i)
+        {
+            if (query.matches(values[i], keyOf(i)))
+            {
+                bitmap[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+        rebuildMatchCounts();
+    }
+
+private:
+    const std::vector<TDisplayItem>* items;
+    ItemQuery query;
+    WorkerPool* pool;
+
+    std::vector<ValueType> values;      // Value column
+    std::string keyText;                // Key column: all keys back to back
+    std::vector<uint32_t> keyOffsets;   // Key i is keyText[keyOffsets[i], keyOffsets[i + 1])
+    std::vector<uint64_t> bitmap;       // Bit per item: matches the query
+    FenwickTree matchCounts;            // Set bits per bitmap word
+
+    std::string_view keyOf(size_t itemIndex) const
+    {
+        return std::string_view(keyText).substr(keyOffsets[itemIndex],
+                                                keyOffsets[itemIndex + 1] - keyOffsets[itemIndex]);
+    }
+
+    void evaluate()
+    {
+        size_t count = values.size();
+        bitmap.assign((count + 63) / 64, 0);
+        size_t tileCount = (count + ItemQuery::tileItems - 1) / ItemQuery::tileItems;
+        auto evaluateTiles = [this, count](size_t begin, size_t end)
+        {
+            std::vector<uint64_t> scratch(query.getScratchWords());
+            for (size_t tile = begin; tile < end; ++tile)
+            {
+                size_t first = tile * ItemQuery::tileItems;
+                size_t itemCount = std::min(ItemQuery::tileItems, count - first);
+                query.evaluateTile(values.data(), keyText.data(), keyOffsets.data(), first, itemCount,
+                                   bitmap.data() + tile * ItemQuery::tileWords, scratch.data());
+            }
+        };
+        if (pool)
+        {
+            pool->parallelFor(tileCount, evaluateTiles, 4);
+        }
+        else
+        {
+            evaluateTiles(0, tileCount);
+        }
+        rebuildMatchCounts();
+    }
+
+    void rebuildMatchCounts()
+    {
+        std::vector<size_t> counts(bitmap.size());
+        for (size_t w = 0; w < bitmap.size(); ++w)
+        {
+            counts[w] = popCount(bitmap[w]);
+        }
+        matchCounts = FenwickTree(counts);
+    }
+};
+
+#endif // QUERYVIEW_H
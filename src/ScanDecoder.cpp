@@ -0,0 +1,100 @@
+#include "ScanDecoder.h"
+
+ScanDecoder::ScanDecoder(std::chrono::milliseconds maxInterKeyGap, size_t minLength)
+    : m_maxGap(maxInterKeyGap), m_minLength(minLength == 0 ? 1 : minLength),
+      m_burst(), m_burstLength(0), m_code(), m_codeLength(0),
+      m_keys(), m_keyHead(0), m_keyCount(0)
+{
+}
+
+bool ScanDecoder::feed(char c, Clock::time_point now)
+{
+    expire(now);
+    m_lastKey = now;
+
+    if (c == '\r' || c == '\n')
+    {
+        if (m_burstLength >= m_minLength)
+        {
+            for (size_t i = 0; i < m_burstLength; ++i)
+            {
+                m_code[i] = m_burst[i];
+            }
+            m_codeLength = m_burstLength;
+            m_burstLength = 0;
+            return true;
+        }
+        releaseBurst();
+        releaseKey(c);
+        return false;
+    }
+
+    if (m_burstLength == maxCodeLength)
+    {
+        // Too long for a code: it was typed or pasted text
+        releaseBurst();
+    }
+    m_burst[m_burstLength++] = c;
+    return false;
+}
+
+void ScanDecoder::expire(Clock::time_point now)
+{
+    if (m_burstLength > 0 && now - m_lastKey > m_maxGap)
+    {
+        releaseBurst();
+    }
+}
+
+void ScanDecoder::flush()
+{
+    releaseBurst();
+}
+
+bool ScanDecoder::takeKey(char& c)
+{
+    if (m_keyCount == 0)
+    {
+        return false;
+    }
+    c = m_keys[m_keyHead];
+    m_keyHead = (m_keyHead + 1) % m_keys.size();
+    --m_keyCount;
+    return true;
+}
+
+std::string_view ScanDecoder::getCode() const
+{
+    return std::string_view(m_code.data(), m_codeLength);
+}
+
+bool ScanDecoder::hasPending() const
+{
+    return m_burstLength > 0;
+}
+
+ScanDecoder::Clock::time_point ScanDecoder::getDeadline() const
+{
+    return m_lastKey + m_maxGap;
+}
+
+void ScanDecoder::releaseBurst()
+{
+    for (size_t i = 0; i < m_burstLength; ++i)
+    {
+        releaseKey(m_burst[i]);
+    }
+    m_burstLength = 0;
+}
+
+void ScanDecoder::releaseKey(char c)
+{
+    if (m_keyCount == m_keys.size())
+    {
+        // Keystrokes were not drained; drop the oldest
+        m_keyHead = (m_keyHead + 1) % m_keys.size();
+        --m_keyCount;
+    }
+    m_keys[(m_keyHead + m_keyCount) % m_keys.size()] = c;
+    ++m_keyCount;
+}
@@ -0,0 +1,89 @@
+#ifndef SCANDECODER_H
+#define SCANDECODER_H
+
+#include <array>
+#include <chrono>
+#include <string_view>
+#include <cstddef>
+
+/**
+ * Separates barcode-scanner input from typed keys on a shared keyboard stream.
+ *
+ * Keyboard-wedge scanners type a whole code within a few milliseconds and end it with
+ * Enter; people type far slower. Characters are held while they keep arriving within the
+ * inter-key gap. A burst of at least minLength characters ending in Enter is a scan;
+ * anything else is released, in order, as ordinary keystrokes. All buffers are fixed-size,
+ * so decoding never allocates.
+ */
+class ScanDecoder
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t maxCodeLength = 64;
+
+    /**
+     * @param maxInterKeyGap Longest pause between two characters of one scan
+     * @param minLength Shortest code accepted as a scan
+     */
+    explicit ScanDecoder(std::chrono::milliseconds maxInterKeyGap = std::chrono::milliseconds(30),
+                         size_t minLength = 3);
+
+    /**
+     * Feed one received character.
+     * @return true if it completed a scan (read it with getCode())
+     */
+    bool feed(char c, Clock::time_point now);
+
+    /**
+     * Release held characters as keystrokes once the burst has gone quiet.
+     * Call when no input arrived before getDeadline().
+     */
+    void expire(Clock::time_point now);
+
+    /**
+     * Release held characters as keystrokes now (e.g., at the end of the input).
+     */
+    void flush();
+
+    /**
+     * Take the next character to treat as an ordinary keystroke.
+     * Drain keystrokes after every feed() or expire().
+     * @return false if there is none
+     */
+    bool takeKey(char& c);
+
+    /**
+     * Get the most recent scanned code (valid until the next scan).
+     */
+    std::string_view getCode() const;
+
+    /**
+     * Check if characters are held waiting to see whether they are a scan.
+     */
+    bool hasPending() const;
+
+    /**
+     * Get the time at which held characters are released as keystrokes.
+     */
+    Clock::time_point getDeadline() const;
+
+private:
+    Clock::duration m_maxGap;
+    size_t m_minLength;
+
+    std::array<char, maxCodeLength> m_burst;    // Characters of the current burst
+    size_t m_burstLength;
+    Clock::time_point m_lastKey;
+
+    std::array<char, maxCodeLength> m_code;
+    size_t m_codeLength;
+
+    std::array<char, 2 * maxCodeLength> m_keys;     // Released keystrokes (ring)
+    size_t m_keyHead;
+    size_t m_keyCount;
+
+    void releaseBurst();
+    void releaseKey(char c);
+};
+
+#endif // SCANDECODER_H
@@ -0,0 +1,131 @@
+#include "ScannerInputListener.h"
+#include "KeyBindings.h"
+#include <iostream>
+
+ScannerInputListener::ScannerInputListener(int fd, std::chrono::milliseconds maxInterKeyGap,
+                                           size_t minCodeLength)
+    : m_listening(false), m_reader(fd), m_decoder(maxInterKeyGap, minCodeLength)
+{
+}
+
+ScannerInputListener::~ScannerInputListener()
+{
+    stopListening();
+}
+
+void ScannerInputListener::startListening()
+{
+    // Characters must arrive as they are typed, or inter-key timing is lost
+    m_reader.enterRawMode();
+    m_listening = true;
+}
+
+void ScannerInputListener::stopListening()
+{
+    m_listening = false;
+    m_reader.restoreMode();
+}
+
+bool ScannerInputListener::isListening() const
+{
+    return m_listening;
+}
+
+void ScannerInputListener::printHelp() const
+{
+    printKeyBindings(std::cout);
+    std::cout << "Scan a barcode to jump to its item and count it in." << std::endl;
+}
+
+std::string_view ScannerInputListener::getScannedCode() const
+{
+    return m_decoder.getCode();
+}
+
+NavigationCommand ScannerInputListener::pollCommand()
+{
+    return nextCommand(0);
+}
+
+NavigationCommand ScannerInputListener::waitForCommand()
+{
+    return nextCommand(-1);
+}
+
+NavigationCommand ScannerInputListener::nextCommand(int timeoutMs)
+{
+    for (;;)
+    {
+        char c;
+        if (m_decoder.takeKey(c))
+        {
+            NavigationCommand command = m_parser.feed(c);
+            if (command != NavigationCommand::None)
+            {
+                return command;
+            }
+            continue;
+        }
+        if (!m_listening)
+        {
+            return m_parser.timeout();
+        }
+
+        if (m_reader.hasInput())
+        {
+            if (m_decoder.feed(m_reader.next(), m_reader.getReadTime()))
+            {
+                return NavigationCommand::SelectByKey;
+            }
+            continue;
+        }
+
+        // Held characters must be released at their deadline even if no more input arrives,
+        // and an incomplete key sequence ends after the escape timeout
+        int waitMs = timeoutMs;
+        if (m_parser.isPending() && !m_decoder.hasPending())
+        {
+            if (m_reader.escapeTimedOut())
+            {
+                NavigationCommand command = m_parser.timeout();
+                if (command != NavigationCommand::None)
+                {
+                    return command;
+                }
+                continue;
+            }
+            waitMs = m_reader.escapeWaitMs(timeoutMs);
+        }
+        else if (m_decoder.hasPending())
+        {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                m_decoder.getDeadline() - ScanDecoder::Clock::now()).count() + 1;
+            int pendingMs = remaining > 0 ? static_cast<int>(remaining) : 0;
+            waitMs = (timeoutMs < 0 || pendingMs < timeoutMs) ? pendingMs : timeoutMs;
+        }
+
+        TerminalReader::ReadResult result = m_reader.fill(waitMs);
+        if (result == TerminalReader::ReadResult::Closed)
+        {
+            m_listening = false;
+        }
+        if (result != TerminalReader::ReadResult::Data)
+        {
+            if (!m_listening)
+            {
+                // End of input: held characters can no longer become a scan
+                m_decoder.flush();
+                continue;
+            }
+            if (m_decoder.hasPending() && ScanDecoder::Clock::now() > m_decoder.getDeadline())
+            {
+                m_decoder.expire(ScanDecoder::Clock::now());
+                continue;
+            }
+            if (timeoutMs >= 0)
+            {
+                return NavigationCommand::None;
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef ScannerInputListener_h
+#define ScannerInputListener_h
+
+#include "IInputListener.h"
+#include "ScanDecoder.h"
+#include "EscapeSequenceParser.h"
+#include "TerminalReader.h"
+#include <atomic>
+#include <chrono>
+#include <string_view>
+
+// Keyboard listener that also accepts a keyboard-wedge barcode scanner on the same input.
+// Scanned codes produce NavigationCommand::SelectByKey (read the code with getScannedCode());
+// everything typed by hand maps to the usual commands, including arrow and paging keys.
+class ScannerInputListener : public IInputListener
+{
+public:
+    // fd: input to read (standard input by default; ignored on Windows, which reads the console)
+    explicit ScannerInputListener(int fd = 0,
+                                  std::chrono::milliseconds maxInterKeyGap = std::chrono::milliseconds(30),
+                                  size_t minCodeLength = 3);
+    ~ScannerInputListener() override;
+
+    ScannerInputListener(const ScannerInputListener&) = delete;
+    ScannerInputListener& operator=(const ScannerInputListener&) = delete;
+
+    void startListening() override;
+    void stopListening() override;
+    NavigationCommand pollCommand() override;
+    NavigationCommand waitForCommand() override;
+    bool isListening() const override;
+
+    // Display the key mappings to the user
+    void printHelp() const;
+
+    // Code of the last SelectByKey command (valid until the next scan)
+    std::string_view getScannedCode() const;
+
+private:
+    std::atomic<bool> m_listening;
+    TerminalReader m_reader;
+    ScanDecoder m_decoder;
+    EscapeSequenceParser m_parser;      // Decodes the keystrokes that were not a scan
+
+    // Next command, waiting up to timeoutMs for input (-1 waits indefinitely)
+    NavigationCommand nextCommand(int timeoutMs);
+};
+
+#endif // ScannerInputListener_h
@@ -0,0 +1,275 @@
+#include "SectionedView.h"
+#include <algorithm>
+#include <stdexcept>
+
+SectionedView::SectionedView(std::vector<Section> sections)
+    : m_sections(std::move(sections)), m_itemCount(0)
+{
+    std::vector<size_t> rowCounts;
+    rowCounts.reserve(m_sections.size());
+    m_firstItem.reserve(m_sections.size());
+    for (const auto& section : m_sections)
+    {
+        m_firstItem.push_back(m_itemCount);
+        m_itemCount += section.itemCount;
+        rowCounts.push_back(rowsOf(section));
+    }
+    m_rowCounts = FenwickTree(rowCounts);
+}
+
+SectionedView SectionedView::fromCategories(const std::vector<std::string>& itemCategories)
+{
+    std::vector<Section> sections;
+    for (const auto& category : itemCategories)
+    {
+        if (sections.empty() || sections.back().title != category)
+        {
+            sections.emplace_back(category, 0);
+        }
+        ++sections.back().itemCount;
+    }
+    return SectionedView(std::move(sections));
+}
+
+size_t SectionedView::rowsOf(const Section& section) const
+{
+    return 1 + (section.collapsed ? 0 : section.itemCount);
+}
+
+void SectionedView::validateSection(size_t sectionIndex) const
+{
+    if (sectionIndex >= m_sections.size())
+    {
+        throw std::out_of_range("Section index out of range");
+    }
+}
+
+size_t SectionedView::getRowCount() const
+{
+    return m_rowCounts.total();
+}
+
+size_t SectionedView::getItemAtRow(size_t row) const
+{
+    size_t sectionIndex = m_rowCounts.findByPosition(row);
+    if (sectionIndex >= m_sections.size())
+    {
+        return noItem;
+    }
+
+    size_t offset = row - m_rowCounts.prefixSum(sectionIndex);
+    if (offset == 0)
+    {
+        return noItem;  // Header row
+    }
+    return m_firstItem[sectionIndex] + offset - 1;
+}
+
+size_t SectionedView::getRowOfItem(size_t itemIndex) const
+{
+    if (itemIndex >= m_itemCount)
+    {
+        return noItem;
+    }
+
+    size_t sectionIndex = getSectionOfItem(itemIndex);
+    if (m_sections[sectionIndex].collapsed)
+    {
+        return noItem;
+    }
+    return m_rowCounts.prefixSum(sectionIndex) + 1 + (itemIndex - m_firstItem[sectionIndex]);
+}
+
+std::string SectionedView::getRowLabel(size_t row) const
+{
+    if (getItemAtRow(row) != noItem || row >= getRowCount())
+    {
+        return std::string();
+    }
+
+    const Section& section = m_sections[m_rowCounts.findByPosition(row)];
+    return (section.collapsed ? "[+] " : "[-] ") + section.title;
+}
+
+bool SectionedView::activateRow(size_t row)
+{
+    if (row >= getRowCount() || getItemAtRow(row) != noItem)
+    {
+        return false;
+    }
+
+    size_t sectionIndex = m_rowCounts.findByPosition(row);
+    return setCollapsed(sectionIndex, !m_sections[sectionIndex].collapsed);
+}
+
+void SectionedView::itemInserted(size_t itemIndex)
+{
+    if (itemIndex > m_itemCount)
+    {
+        throw std::out_of_range("Item index out of range");
+    }
+    if (m_sections.empty())
+    {
+        throw std::logic_error("Sectioned view has no section to insert into");
+    }
+
+    // The new item joins the section of the item it is inserted before (or the last section)
+    size_t sectionIndex = (itemIndex < m_itemCount) ? getSectionOfItem(itemIndex)
+                                                    : m_sections.size() - 1;
+    ++m_sections[sectionIndex].itemCount;
+    ++m_itemCount;
+    for (size_t i = sectionIndex + 1; i < m_firstItem.size(); ++i)
+    {
+        ++m_firstItem[i];
+    }
+    if (!m_sections[sectionIndex].collapsed)
+    {
+        m_rowCounts.add(sectionIndex, 1);
+    }
+}
+
+void SectionedView::itemRemoved(size_t itemIndex)
+{
+    size_t sectionIndex = getSectionOfItem(itemIndex);
+    --m_sections[sectionIndex].itemCount;
+    --m_itemCount;
+    for (size_t i = sectionIndex + 1; i < m_firstItem.size(); ++i)
+    {
+        --m_firstItem[i];
+    }
+    if (!m_sections[sectionIndex].collapsed)
+    {
+        m_rowCounts.subtract(sectionIndex, 1);
+    }
+}
+
+void SectionedView::itemsRemoved(const std::vector<size_t>& itemIndices)
+{
+    if (itemIndices.empty())
+    {
+        return;
+    }
+    if (itemIndices.back() >= m_itemCount)
+    {
+        throw std::out_of_range("Item index out of range");
+    }
+
+    std::vector<size_t> rowCounts;
+    rowCounts.reserve(m_sections.size());
+    size_t next = 0;
+    for (size_t sectionIndex = 0; sectionIndex < m_sections.size(); ++sectionIndex)
+    {
+        Section& section = m_sections[sectionIndex];
+        size_t end = m_firstItem[sectionIndex] + section.itemCount;
+        size_t removedBefore = next;
+        while (next < itemIndices.size() && itemIndices[next] < end)
+        {
+            ++next;
+        }
+        m_firstItem[sectionIndex] -= removedBefore;
+        section.itemCount -= next - removedBefore;
+        rowCounts.push_back(rowsOf(section));
+    }
+    m_itemCount -= itemIndices.size();
+    m_rowCounts = FenwickTree(rowCounts);
+}
+
+void SectionedView::itemsAppended(size_t firstIndex, size_t count)
+{
+    if (firstIndex != m_itemCount)
+    {
+        throw std::out_of_range("Items must be appended after the last item");
+    }
+    if (m_sections.empty())
+    {
+        throw std::logic_error("Sectioned view has no section to insert into");
+    }
+
+    size_t sectionIndex = m_sections.size() - 1;
+    m_sections[sectionIndex].itemCount += count;
+    m_itemCount += count;
+    if (!m_sections[sectionIndex].collapsed)
+    {
+        m_rowCounts.add(sectionIndex, count);
+    }
+}
+
+bool SectionedView::setCollapsed(size_t sectionIndex, bool collapsed)
+{
+    validateSection(sectionIndex);
+    Section& section = m_sections[sectionIndex];
+    if (section.collapsed == collapsed || section.itemCount == 0)
+    {
+        section.collapsed = collapsed;
+        return false;
+    }
+
+    section.collapsed = collapsed;
+    if (collapsed)
+    {
+        m_rowCounts.subtract(sectionIndex, section.itemCount);
+    }
+    else
+    {
+        m_rowCounts.add(sectionIndex, section.itemCount);
+    }
+    return true;
+}
+
+void SectionedView::setAllCollapsed(bool collapsed)
+{
+    std::vector<size_t> rowCounts;
+    rowCounts.reserve(m_sections.size());
+    for (auto& section : m_sections)
+    {
+        section.collapsed = collapsed;
+        rowCounts.push_back(rowsOf(section));
+    }
+    m_rowCounts = FenwickTree(rowCounts);
+}
+
+bool SectionedView::isCollapsed(size_t sectionIndex) const
+{
+    validateSection(sectionIndex);
+    return m_sections[sectionIndex].collapsed;
+}
+
+size_t SectionedView::getSectionCount() const
+{
+    return m_sections.size();
+}
+
+const SectionedView::Section& SectionedView::getSection(size_t sectionIndex) const
+{
+    validateSection(sectionIndex);
+    return m_sections[sectionIndex];
+}
+
+size_t SectionedView::getSectionOfItem(size_t itemIndex) const
+{
+    if (itemIndex >= m_itemCount)
+    {
+        throw std::out_of_range("Item index out of range");
+    }
+
+    // Last section starting at or before the item (never an empty one, since the
+    // section after an empty section starts at the same item)
+    auto next = std::upper_bound(m_firstItem.begin(), m_firstItem.end(), itemIndex);
+    return static_cast<size_t>(next - m_firstItem.begin()) - 1;
+}
+
+size_t SectionedView::getSectionOfRow(size_t row) const
+{
+    size_t sectionIndex = m_rowCounts.findByPosition(row);
+    if (sectionIndex >= m_sections.size())
+    {
+        throw std::out_of_range("Row index out of range");
+    }
+    return sectionIndex;
+}
+
+size_t SectionedView::getHeaderRow(size_t sectionIndex) const
+{
+    validateSection(sectionIndex);
+    return m_rowCounts.prefixSum(sectionIndex);
+}
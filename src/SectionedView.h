@@ -0,0 +1,101 @@
+#ifndef SECTIONEDVIEW_H
+#define SECTIONEDVIEW_H
+
+#include "IItemView.h"
+#include "FenwickTree.h"
+#include <string>
+#include <vector>
+
+/**
+ * Item view that groups consecutive items into collapsible sections with header rows.
+ *
+ * Each section contributes one header row plus its items while expanded. Row counts per
+ * section are kept in a Fenwick tree, so mapping rows to items, items to rows, and
+ * collapsing or expanding a section are all O(log sections) - independent of how many
+ * sections are collapsed or how many items the list holds.
+ */
+class SectionedView : public IItemView
+{
+public:
+    struct Section
+    {
+        std::string title;
+        size_t itemCount;
+        bool collapsed;
+
+        Section(std::string title, size_t itemCount, bool collapsed = false)
+            : title(std::move(title)), itemCount(itemCount), collapsed(collapsed)
+        {
+        }
+    };
+
+    /**
+     * @param sections Sections in item order; section N starts right after section N-1
+     */
+    explicit SectionedView(std::vector<Section> sections);
+
+    /**
+     * Build sections from runs of equal categories, one category per item (in item order).
+     */
+    static SectionedView fromCategories(const std::vector<std::string>& itemCategories);
+
+    size_t getRowCount() const override;
+    size_t getItemAtRow(size_t row) const override;
+    size_t getRowOfItem(size_t itemIndex) const override;
+    std::string getRowLabel(size_t row) const override;
+    bool activateRow(size_t row) override;
+
+    /**
+     * An inserted item joins the section of the item it is inserted before (the last
+     * section when appended). O(sections) for the section start table, O(log sections) rows.
+     */
+    void itemInserted(size_t itemIndex) override;
+    void itemRemoved(size_t itemIndex) override;
+
+    /**
+     * Section sizes and starts are recomputed in one pass over the sections. O(sections + removed).
+     */
+    void itemsRemoved(const std::vector<size_t>& itemIndices) override;
+
+    /**
+     * Appended items join the last section. O(log sections).
+     */
+    void itemsAppended(size_t firstIndex, size_t count) override;
+
+    /**
+     * Collapse or expand a section. O(log sections).
+     * @return true if the state changed
+     */
+    bool setCollapsed(size_t sectionIndex, bool collapsed);
+    void setAllCollapsed(bool collapsed);
+    bool isCollapsed(size_t sectionIndex) const;
+
+    size_t getSectionCount() const;
+    const Section& getSection(size_t sectionIndex) const;
+
+    /**
+     * Get the section containing an item. O(log sections).
+     */
+    size_t getSectionOfItem(size_t itemIndex) const;
+
+    /**
+     * Get the section a row belongs to (its header or one of its items). O(log sections).
+     */
+    size_t getSectionOfRow(size_t row) const;
+
+    /**
+     * Get the header row of a section. O(log sections).
+     */
+    size_t getHeaderRow(size_t sectionIndex) const;
+
+private:
+    std::vector<Section> m_sections;
+    std::vector<size_t> m_firstItem;    // First item index of each section
+    FenwickTree m_rowCounts;            // Rows contributed by each section
+    size_t m_itemCount;
+
+    size_t rowsOf(const Section& section) const;
+    void validateSection(size_t sectionIndex) const;
+};
+
+#endif // SECTIONEDVIEW_H
@@ -0,0 +1,204 @@
+#ifndef STATICKEYINDEX_H
+#define STATICKEYINDEX_H
+
+#include <array>
+#include <string_view>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Perfect hash from a fixed key set to item indices, built entirely at compile time.
+ *
+ * Construction uses hash-and-displace: keys are hashed into buckets, and each bucket
+ * (largest first) gets a displacement that sends all of its keys to free slots of a
+ * power-of-two table. A lookup is one string hash, two table reads and one key compare
+ * (to reject keys outside the set). Declare the index constexpr so that a key set the
+ * generator cannot place, or one with duplicate keys, fails to compile.
+ *
+ * @tparam N Number of keys
+ */
+template<size_t N>
+class StaticKeyIndex
+{
+    static_assert(N > 0, "StaticKeyIndex needs at least one key");
+
+public:
+    static constexpr size_t notFound = static_cast<size_t>(-1);
+
+private:
+    static constexpr size_t powerOfTwoAtLeast(size_t value)
+    {
+        size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    static constexpr size_t bucketCount = powerOfTwoAtLeast(N);
+    static constexpr size_t slotCount = powerOfTwoAtLeast(2 * N);
+    static constexpr uint32_t emptySlot = static_cast<uint32_t>(-1);
+    static constexpr uint32_t maxDisplacement = 1u << 16;
+
+    std::array<std::string_view, N> keys;
+    std::array<uint32_t, bucketCount> displacements;
+    std::array<uint32_t, slotCount> slots;      // Key index per slot, or emptySlot
+
+    static constexpr uint64_t hashKey(std::string_view key)
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : key)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    static constexpr size_t slotOf(uint64_t hash, uint32_t displacement)
+    {
+        // Murmur3 finalizer over the hash perturbed by the bucket's displacement
+        uint64_t mixed = hash ^ (static_cast<uint64_t>(displacement) * 0x9E3779B97F4A7C15ull);
+        mixed ^= mixed >> 33;
+        mixed *= 0xFF51AFD7ED558CCDull;
+        mixed ^= mixed >> 33;
+        return static_cast<size_t>(mixed & (slotCount - 1));
+    }
+
+public:
+    /**
+     * Build the index. Key N maps to item index N.
+     * @throws std::invalid_argument on duplicate keys (a compile error when constexpr)
+     */
+    constexpr explicit StaticKeyIndex(const std::array<std::string_view, N>& keyList)
+        : keys(keyList), displacements(), slots()
+    {
+        std::array<uint64_t, N> hashes{};
+        std::array<size_t, N> bucketOf{};
+        std::array<size_t, bucketCount> bucketSizes{};
+        for (size_t i = 0; i < N; ++i)
+        {
+            hashes[i] = hashKey(keys[i]);
+            bucketOf[i] = static_cast<size_t>(hashes[i] & (bucketCount - 1));
+            ++bucketSizes[bucketOf[i]];
+            for (size_t j = 0; j < i; ++j)
+            {
+                if (keys[j] == keys[i])
+                {
+                    throw std::invalid_argument("Duplicate key in static key set");
+                }
+            }
+        }
+        for (auto& slot : slots)
+        {
+            slot = emptySlot;
+        }
+
+        // Place buckets largest first (insertion sort of bucket numbers by size)
+        std::array<size_t, bucketCount> order{};
+        for (size_t b = 0; b < bucketCount; ++b)
+        {
+            size_t position = b;
+            while (position > 0 && bucketSizes[order[position - 1]] < bucketSizes[b])
+            {
+                order[position] = order[position - 1];
+                --position;
+            }
+            order[position] = b;
+        }
+
+        for (size_t b : order)
+        {
+            if (bucketSizes[b] == 0)
+            {
+                break;
+            }
+
+            bool placed = false;
+            for (uint32_t displacement = 0; !placed && displacement < maxDisplacement; ++displacement)
+            {
+                // Try the displacement: every key of the bucket must land on a free, distinct slot
+                placed = true;
+                for (size_t i = 0; i < N && placed; ++i)
+                {
+                    if (bucketOf[i] != b)
+                    {
+                        continue;
+                    }
+                    size_t slot = slotOf(hashes[i], displacement);
+                    if (slots[slot] != emptySlot)
+                    {
+                        placed = false;
+                    }
+                    else
+                    {
+                        slots[slot] = static_cast<uint32_t>(i);
+                    }
+                }
+
+                if (placed)
+                {
+                    displacements[b] = displacement;
+                }
+                else
+                {
+                    // Undo the keys of this bucket placed with this displacement
+                    for (size_t i = 0; i < N; ++i)
+                    {
+                        if (bucketOf[i] == b)
+                        {
+                            size_t slot = slotOf(hashes[i], displacement);
+                            if (slots[slot] == i)
+                            {
+                                slots[slot] = emptySlot;
+                            }
+                        }
+                    }
+                }
+            }
+            if (!placed)
+            {
+                throw std::logic_error("No perfect hash found for static key set");
+            }
+        }
+    }
+
+    /**
+     * Get the item index of a key, or notFound for keys outside the set.
+     */
+    constexpr size_t find(std::string_view key) const
+    {
+        uint64_t hash = hashKey(key);
+        uint32_t index = slots[slotOf(hash, displacements[hash & (bucketCount - 1)])];
+        return (index != emptySlot && keys[index] == key) ? index : notFound;
+    }
+
+    constexpr bool contains(std::string_view key) const
+    {
+        return find(key) != notFound;
+    }
+
+    static constexpr size_t size()
+    {
+        return N;
+    }
+
+    constexpr std::string_view getKey(size_t index) const
+    {
+        return keys[index];
+    }
+};
+
+/**
+ * Build a StaticKeyIndex from a braced list of keys:
+ *     constexpr auto menu = makeStaticKeyIndex<3>({"BOLT", "NUT", "SCREW"});
+ */
+template<size_t N>
+constexpr StaticKeyIndex<N> makeStaticKeyIndex(const std::array<std::string_view, N>& keys)
+{
+    return StaticKeyIndex<N>(keys);
+}
+
+#endif // STATICKEYINDEX_H
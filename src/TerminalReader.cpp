@@ -0,0 +1,119 @@
+#include "TerminalReader.h"
+#include "EscapeSequenceParser.h"
+
+#ifdef _WIN32
+#include <conio.h>
+#include <thread>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+TerminalReader::TerminalReader(int fd)
+    : m_fd(fd), m_input(), m_inputPos(0), m_inputLength(0)
+#ifndef _WIN32
+      , m_rawMode(false), m_savedMode()
+#endif
+{
+}
+
+TerminalReader::~TerminalReader()
+{
+    restoreMode();
+}
+
+void TerminalReader::enterRawMode()
+{
+#ifndef _WIN32
+    if (!m_rawMode && ::isatty(m_fd) && ::tcgetattr(m_fd, &m_savedMode) == 0)
+    {
+        termios raw = m_savedMode;
+        raw.c_lflag &= static_cast<tcflag_t>(~(ICANON | ECHO));
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        m_rawMode = (::tcsetattr(m_fd, TCSANOW, &raw) == 0);
+    }
+#endif
+}
+
+void TerminalReader::restoreMode()
+{
+#ifndef _WIN32
+    if (m_rawMode)
+    {
+        ::tcsetattr(m_fd, TCSANOW, &m_savedMode);
+        m_rawMode = false;
+    }
+#endif
+}
+
+TerminalReader::ReadResult TerminalReader::fill(int timeoutMs)
+{
+    auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs < 0 ? 0 : timeoutMs);
+#ifdef _WIN32
+    while (!_kbhit())
+    {
+        if (timeoutMs >= 0 && Clock::now() >= deadline)
+        {
+            return ReadResult::Timeout;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    m_inputLength = 0;
+    while (m_inputLength < m_input.size() && _kbhit())
+    {
+        m_input[m_inputLength++] = static_cast<char>(_getch());
+    }
+#else
+    pollfd input{m_fd, POLLIN, 0};
+    int waitMs = timeoutMs;
+    int ready;
+    while ((ready = ::poll(&input, 1, waitMs)) < 0 && errno == EINTR)
+    {
+        // A signal cut the wait short: wait out the rest of it
+        if (timeoutMs >= 0)
+        {
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            waitMs = remaining > 0 ? static_cast<int>(remaining) : 0;
+        }
+    }
+    if (ready == 0)
+    {
+        return ReadResult::Timeout;
+    }
+    if (ready < 0)
+    {
+        // The input can no longer be waited on
+        return ReadResult::Closed;
+    }
+
+    ssize_t bytesRead;
+    do
+    {
+        bytesRead = ::read(m_fd, m_input.data(), m_input.size());
+    } while (bytesRead < 0 && errno == EINTR);
+    if (bytesRead <= 0)
+    {
+        // End of input or a read error: nothing more will arrive
+        return ReadResult::Closed;
+    }
+    m_inputLength = static_cast<size_t>(bytesRead);
+#endif
+    m_inputPos = 0;
+    m_readTime = Clock::now();
+    return ReadResult::Data;
+}
+
+bool TerminalReader::escapeTimedOut() const
+{
+    return Clock::now() - m_readTime >= std::chrono::milliseconds(EscapeSequenceParser::escapeTimeoutMs);
+}
+
+int TerminalReader::escapeWaitMs(int timeoutMs) const
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_readTime).count();
+    int remaining = (elapsed < EscapeSequenceParser::escapeTimeoutMs)
+        ? EscapeSequenceParser::escapeTimeoutMs - static_cast<int>(elapsed) : 0;
+    return (timeoutMs < 0 || remaining < timeoutMs) ? remaining : timeoutMs;
+}
@@ -0,0 +1,70 @@
+#ifndef TerminalReader_h
+#define TerminalReader_h
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+#ifndef _WIN32
+#include <termios.h>
+#endif
+
+// Raw keyboard input shared by the interactive listeners: switches a terminal to unbuffered
+// input without echo, waits for bytes with a timeout, and keeps what was read until it has
+// been decoded. Waits and reads interrupted by a signal are resumed; any other failure ends
+// the input. Also times the escape timeout of incomplete key sequences from the last read.
+class TerminalReader
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class ReadResult
+    {
+        Data,       // New bytes are available
+        Timeout,    // Nothing arrived within the timeout
+        Closed      // End of input, or the input failed: nothing more will arrive
+    };
+
+    // fd: input to read (ignored on Windows, which reads the console)
+    explicit TerminalReader(int fd = 0);
+    ~TerminalReader();
+
+    TerminalReader(const TerminalReader&) = delete;
+    TerminalReader& operator=(const TerminalReader&) = delete;
+
+    // Deliver characters as they are typed, without echo (terminals only; no-op otherwise)
+    void enterRawMode();
+
+    // Restore the terminal mode saved by enterRawMode()
+    void restoreMode();
+
+    // Wait up to timeoutMs (-1 waits indefinitely) for input and read what is available.
+    // Only call once the previous bytes have been consumed.
+    ReadResult fill(int timeoutMs);
+
+    bool hasInput() const { return m_inputPos < m_inputLength; }
+    char next() { return m_input[m_inputPos++]; }
+
+    // Time of the last read that returned data
+    Clock::time_point getReadTime() const { return m_readTime; }
+
+    // True once the escape timeout has passed since the last read
+    bool escapeTimedOut() const;
+
+    // timeoutMs (-1 = indefinitely), shortened to the time left until the escape timeout
+    int escapeWaitMs(int timeoutMs) const;
+
+private:
+    int m_fd;
+    std::array<char, 256> m_input;      // Bytes read but not yet decoded
+    size_t m_inputPos;
+    size_t m_inputLength;
+    Clock::time_point m_readTime;
+
+#ifndef _WIN32
+    bool m_rawMode;
+    termios m_savedMode;
+#endif
+};
+
+#endif // TerminalReader_h
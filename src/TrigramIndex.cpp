@@ -0,0 +1,264 @@
+#include "TrigramIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+TrigramIndex::TrigramIndex()
+    : m_postings(), m_keys(), m_itemOfId(), m_idOfItem()
+{
+}
+
+size_t TrigramIndex::size() const
+{
+    return m_idOfItem.size();
+}
+
+void TrigramIndex::append(std::string_view key)
+{
+    insert(m_idOfItem.size(), key);
+}
+
+void TrigramIndex::insert(size_t itemIndex, std::string_view key)
+{
+    if (itemIndex > m_idOfItem.size())
+    {
+        throw std::out_of_range("Item index out of range");
+    }
+
+    uint32_t id = static_cast<uint32_t>(m_keys.size());
+    m_keys.push_back(fold(key));
+    for (uint32_t trigram : trigrams(m_keys.back()))
+    {
+        m_postings[trigram].push_back(id);
+    }
+
+    if (itemIndex < m_idOfItem.size())
+    {
+        for (auto& item : m_itemOfId)
+        {
+            if (item != removed && item >= itemIndex)
+            {
+                ++item;
+            }
+        }
+    }
+    m_itemOfId.push_back(itemIndex);
+    m_idOfItem.insert(m_idOfItem.begin() + static_cast<std::ptrdiff_t>(itemIndex), id);
+}
+
+void TrigramIndex::remove(size_t itemIndex)
+{
+    if (itemIndex >= m_idOfItem.size())
+    {
+        throw std::out_of_range("Item index out of range");
+    }
+
+    uint32_t id = m_idOfItem[itemIndex];
+    for (uint32_t trigram : trigrams(m_keys[id]))
+    {
+        auto postings = m_postings.find(trigram);
+        auto& ids = postings->second;
+        ids.erase(std::lower_bound(ids.begin(), ids.end(), id));
+        if (ids.empty())
+        {
+            m_postings.erase(postings);
+        }
+    }
+    m_keys[id].clear();
+    m_keys[id].shrink_to_fit();
+    m_itemOfId[id] = removed;
+
+    m_idOfItem.erase(m_idOfItem.begin() + static_cast<std::ptrdiff_t>(itemIndex));
+    for (size_t i = itemIndex; i < m_idOfItem.size(); ++i)
+    {
+        m_itemOfId[m_idOfItem[i]] = i;
+    }
+}
+
+std::vector<TrigramIndex::Match> TrigramIndex::search(std::string_view query, size_t maxResults,
+                                                      size_t maxDistance) const
+{
+    std::vector<Match> matches;
+    std::string folded = fold(query);
+    std::vector<uint32_t> queryTrigrams = trigrams(folded);
+    if (maxResults == 0 || queryTrigrams.empty())
+    {
+        return matches;
+    }
+
+    // Posting lists of the query's trigrams. Lists of very common trigrams (e.g., a prefix
+    // shared by every SKU) are skipped: they barely narrow the search but would dominate it
+    size_t lost = 4 * maxDistance;
+    size_t required = (queryTrigrams.size() > lost) ? queryTrigrams.size() - lost : 1;
+    size_t commonLength = std::max(minCommonLength, size() / 16);
+    std::vector<const std::vector<uint32_t>*> lists;
+    const std::vector<uint32_t>* shortestCommon = nullptr;
+    for (uint32_t trigram : queryTrigrams)
+    {
+        auto postings = m_postings.find(trigram);
+        if (postings == m_postings.end())
+        {
+            continue;
+        }
+        if (postings->second.size() <= commonLength)
+        {
+            lists.push_back(&postings->second);
+        }
+        else
+        {
+            required = (required > 1) ? required - 1 : 1;
+            if (!shortestCommon || postings->second.size() < shortestCommon->size())
+            {
+                shortestCommon = &postings->second;
+            }
+        }
+    }
+    if (lists.empty() && shortestCommon)
+    {
+        lists.push_back(shortestCommon);
+    }
+
+    // Count the query trigrams each key shares (over the remaining lists)
+    std::vector<uint16_t> shared(m_keys.size(), 0);
+    std::vector<uint32_t> candidates;
+    for (const auto* list : lists)
+    {
+        for (uint32_t id : *list)
+        {
+            if (shared[id]++ == 0)
+            {
+                candidates.push_back(id);
+            }
+        }
+    }
+
+    struct Ranked
+    {
+        size_t distance;
+        size_t shared;
+        size_t itemIndex;
+    };
+    std::vector<Ranked> ranked;
+    std::vector<size_t> rows;
+    for (uint32_t id : candidates)
+    {
+        size_t count = shared[id];
+        const std::string& key = m_keys[id];
+        size_t lengthDifference = (key.size() > folded.size()) ? key.size() - folded.size()
+                                                                : folded.size() - key.size();
+        if (count < required || lengthDifference > maxDistance)
+        {
+            continue;
+        }
+        size_t distance = editDistance(key, folded, maxDistance, rows);
+        if (distance <= maxDistance)
+        {
+            ranked.push_back(Ranked{distance, count, m_itemOfId[id]});
+        }
+    }
+
+    auto better = [](const Ranked& a, const Ranked& b)
+    {
+        if (a.distance != b.distance)
+        {
+            return a.distance < b.distance;
+        }
+        if (a.shared != b.shared)
+        {
+            return a.shared > b.shared;
+        }
+        return a.itemIndex < b.itemIndex;
+    };
+    size_t resultCount = std::min(maxResults, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(resultCount),
+                      ranked.end(), better);
+    for (size_t i = 0; i < resultCount; ++i)
+    {
+        matches.push_back(Match{ranked[i].itemIndex, ranked[i].distance});
+    }
+    return matches;
+}
+
+size_t TrigramIndex::editDistance(std::string_view a, std::string_view b, size_t limit)
+{
+    std::vector<size_t> rows;
+    return editDistance(fold(a), fold(b), limit, rows);
+}
+
+size_t TrigramIndex::editDistance(std::string_view a, std::string_view b, size_t limit,
+                                  std::vector<size_t>& rows)
+{
+    // Optimal string alignment distance with three rolling rows, limited to the diagonal
+    // band |i - j| <= limit (cells outside it exceed limit). Once two consecutive rows
+    // exceed limit (transpositions look two rows back), no later cell can get below it
+    size_t width = b.size() + 1;
+    size_t over = limit + 1;
+    rows.assign(3 * width, over);
+    size_t* previous2 = rows.data();
+    size_t* previous = previous2 + width;
+    size_t* current = previous + width;
+    for (size_t j = 0; j < width && j <= limit; ++j)
+    {
+        previous[j] = j;
+    }
+    size_t previousMinimum = 0;
+    for (size_t i = 1; i <= a.size(); ++i)
+    {
+        std::fill(current, current + width, over);
+        current[0] = std::min(i, over);
+        size_t first = (i > limit) ? i - limit : 1;
+        size_t last = std::min(width - 1, i + limit);
+        size_t rowMinimum = current[0];
+        for (size_t j = first; j <= last; ++j)
+        {
+            size_t cost = (a[i - 1] == b[j - 1]) ? 0 : 1;
+            size_t cell = std::min({previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost});
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1])
+            {
+                cell = std::min(cell, previous2[j - 2] + 1);
+            }
+            current[j] = std::min(cell, over);
+            rowMinimum = std::min(rowMinimum, current[j]);
+        }
+        if (rowMinimum > limit && previousMinimum > limit)
+        {
+            return over;
+        }
+        previousMinimum = rowMinimum;
+        size_t* oldest = previous2;
+        previous2 = previous;
+        previous = current;
+        current = oldest;
+    }
+    return previous[b.size()];
+}
+
+std::string TrigramIndex::fold(std::string_view key)
+{
+    std::string folded(key);
+    for (char& c : folded)
+    {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return folded;
+}
+
+std::vector<uint32_t> TrigramIndex::trigrams(const std::string& foldedKey)
+{
+    // Two start markers and one end marker, so short keys and key edges have trigrams
+    std::string padded = "\x01\x01" + foldedKey + "\x02";
+    std::vector<uint32_t> result;
+    if (foldedKey.empty())
+    {
+        return result;
+    }
+    for (size_t i = 0; i + 3 <= padded.size(); ++i)
+    {
+        result.push_back((static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16) |
+                         (static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8) |
+                         static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
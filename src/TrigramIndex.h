@@ -0,0 +1,84 @@
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Trigram index over item keys for approximate (typo-tolerant) key search.
+ *
+ * Keys are case-folded and padded, and every trigram maps to a posting list of the keys
+ * containing it. A search only considers keys that share enough trigrams with the query
+ * (one edit can destroy at most four trigrams, so a key within distance k shares at least
+ * trigrams(query) - 4k of them) and verifies only those candidates with a bounded edit
+ * distance that counts substitutions, insertions, deletions and adjacent transpositions.
+ * Results are ranked by distance. Trigrams found in more than 1/16 of the keys are not
+ * counted (the threshold is lowered by one for each), so keys that share nothing but such
+ * common trigrams with the query are not found.
+ *
+ * Keys get internal ids in insertion order so posting lists stay sorted and untouched when
+ * items shift; insert() and remove() keep the item index of every id up to date.
+ */
+class TrigramIndex
+{
+public:
+    struct Match
+    {
+        size_t itemIndex;
+        size_t distance;
+    };
+
+    TrigramIndex();
+
+    size_t size() const;
+
+    void append(std::string_view key);
+
+    /**
+     * Add the key of an item inserted at itemIndex (later items shift up).
+     */
+    void insert(size_t itemIndex, std::string_view key);
+
+    /**
+     * Drop the key of a removed item (later items shift down).
+     */
+    void remove(size_t itemIndex);
+
+    /**
+     * Find the keys closest to a query, best first (ties by item order).
+     * Keys must share at least one trigram with the query to be found.
+     *
+     * @param maxResults Maximum number of matches returned
+     * @param maxDistance Largest edit distance accepted
+     */
+    std::vector<Match> search(std::string_view query, size_t maxResults, size_t maxDistance = 2) const;
+
+    /**
+     * Case-insensitive edit distance (with adjacent transpositions), or limit + 1 if it
+     * exceeds limit.
+     */
+    static size_t editDistance(std::string_view a, std::string_view b, size_t limit);
+
+private:
+    static constexpr size_t removed = static_cast<size_t>(-1);
+    static constexpr size_t minCommonLength = 1024;    // Shortest posting list treated as common
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings;    // Trigram -> ids (ascending)
+    std::vector<std::string> m_keys;        // Folded key of each id (empty once removed)
+    std::vector<size_t> m_itemOfId;         // Item index of each id, or removed
+    std::vector<uint32_t> m_idOfItem;       // Id of each item
+
+    /**
+     * Edit distance of two folded keys, reusing rows as scratch.
+     */
+    static size_t editDistance(std::string_view a, std::string_view b, size_t limit,
+                               std::vector<size_t>& rows);
+    static std::string fold(std::string_view key);
+    static std::vector<uint32_t> trigrams(const std::string& foldedKey);
+};
+
+#endif // TRIGRAMINDEX_H
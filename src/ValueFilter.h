@@ -0,0 +1,134 @@
+#ifndef VALUEFILTER_H
+#define VALUEFILTER_H
+
+#include <chrono>
+#include <array>
+#include <cstddef>
+#include <cmath>
+#include <type_traits>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Configuration of a noise filter for live (sensor-fed) values.
+ * Filters are applied before a value is considered changed, so noise never marks rows dirty.
+ */
+struct ValueFilterConfig
+{
+    static constexpr size_t maxAverageWindow = 16;
+
+    double deadband;                        // Changes of at most this magnitude are ignored
+    std::chrono::milliseconds minInterval;  // Minimum time between accepted changes
+    size_t averageWindow;                   // Moving average over this many raw samples (1 = off)
+
+    constexpr ValueFilterConfig(double deadband = 0.0,
+                                std::chrono::milliseconds minInterval = std::chrono::milliseconds(0),
+                                size_t averageWindow = 1)
+        : deadband(deadband), minInterval(minInterval), averageWindow(averageWindow)
+    {
+    }
+};
+
+/**
+ * Per-item filter state: moving average, deadband (hysteresis) and rate limiting.
+ *
+ * @tparam TValue Numeric value type of the filtered item
+ */
+template<typename TValue>
+class ValueFilter
+{
+    static_assert(std::is_arithmetic<TValue>::value, "Value filters require numeric values");
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    ValueFilterConfig config;
+    std::array<double, ValueFilterConfig::maxAverageWindow> window;
+    size_t windowCount;
+    size_t windowNext;
+    double windowSum;
+    Clock::time_point lastAccepted;
+    bool hasAccepted;
+
+    double average(double raw)
+    {
+        if (config.averageWindow <= 1)
+        {
+            return raw;
+        }
+
+        if (windowCount == config.averageWindow)
+        {
+            windowSum -= window[windowNext];
+        }
+        else
+        {
+            ++windowCount;
+        }
+        window[windowNext] = raw;
+        windowSum += raw;
+        windowNext = (windowNext + 1) % config.averageWindow;
+        return windowSum / static_cast<double>(windowCount);
+    }
+
+public:
+    explicit ValueFilter(const ValueFilterConfig& config = ValueFilterConfig())
+        : config(config), window{}, windowCount(0), windowNext(0), windowSum(0.0),
+          lastAccepted(), hasAccepted(false)
+    {
+        if (config.averageWindow == 0 || config.averageWindow > ValueFilterConfig::maxAverageWindow)
+        {
+            throw std::invalid_argument("Average window must be between 1 and " +
+                                        std::to_string(ValueFilterConfig::maxAverageWindow));
+        }
+        if (config.deadband < 0.0)
+        {
+            throw std::invalid_argument("Deadband cannot be negative");
+        }
+    }
+
+    /**
+     * Feed a raw sample and decide whether the displayed value should change.
+     * @param raw New raw sample
+     * @param current Currently displayed value
+     * @param now Time of the sample
+     * @param filtered Receives the value to display when the change is accepted
+     * @return true if the displayed value should change
+     */
+    bool apply(TValue raw, TValue current, Clock::time_point now, TValue& filtered)
+    {
+        double candidate = average(static_cast<double>(raw));
+        if constexpr (std::is_integral<TValue>::value)
+        {
+            candidate = std::round(candidate);
+        }
+
+        if (std::fabs(candidate - static_cast<double>(current)) <= config.deadband)
+        {
+            return false;
+        }
+        if (hasAccepted && now - lastAccepted < config.minInterval)
+        {
+            return false;
+        }
+
+        TValue next = static_cast<TValue>(candidate);
+        if (next == current)
+        {
+            return false;
+        }
+
+        filtered = next;
+        lastAccepted = now;
+        hasAccepted = true;
+        return true;
+    }
+
+    const ValueFilterConfig& getConfig() const
+    {
+        return config;
+    }
+};
+
+#endif // VALUEFILTER_H
@@ -0,0 +1,256 @@
+#ifndef VALUEHISTORY_H
+#define VALUEHISTORY_H
+
+#include "BarGlyphs.h"
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <limits>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Fixed-capacity value history for a set of items, stored as delta-encoded rings.
+ *
+ * All items share one contiguous delta array, so the memory cost is exactly
+ * capacity * sizeof(TDelta) bytes per item plus a small per-item header. Recording
+ * a sample is O(1). Deltas that do not fit TDelta are saturated; the reconstructed
+ * value then catches up over the following samples, which is adequate for trends.
+ *
+ * @tparam TDelta Signed integer type of one stored sample (e.g., int8_t, int16_t)
+ */
+template<typename TDelta = int16_t>
+class ValueHistory
+{
+    static_assert(std::numeric_limits<TDelta>::is_signed && std::numeric_limits<TDelta>::is_integer,
+        "TDelta must be a signed integer type");
+
+private:
+    struct Track
+    {
+        int64_t base;       // Value just before the oldest stored sample
+        int64_t newest;     // Reconstructed value of the newest sample
+        uint32_t head;      // Ring slot for the next sample
+        uint32_t count;     // Number of stored samples
+    };
+
+    size_t capacity;
+    std::vector<TDelta> deltas;     // itemCount * capacity samples
+    std::vector<Track> tracks;
+
+    /**
+     * Validate the constructor arguments before any storage is sized.
+     * @return samplesPerItem
+     */
+    static size_t checkedCapacity(size_t itemCount, size_t samplesPerItem)
+    {
+        if (samplesPerItem == 0 || samplesPerItem > std::numeric_limits<uint32_t>::max())
+        {
+            throw std::invalid_argument("History capacity must be between 1 and 2^32-1 samples");
+        }
+        if (itemCount > std::numeric_limits<size_t>::max() / samplesPerItem)
+        {
+            throw std::invalid_argument("History of " + std::to_string(itemCount) + " items x " +
+                                        std::to_string(samplesPerItem) + " samples is too large");
+        }
+        return samplesPerItem;
+    }
+
+    TDelta clampDelta(int64_t delta) const
+    {
+        constexpr int64_t lowest = std::numeric_limits<TDelta>::min();
+        constexpr int64_t highest = std::numeric_limits<TDelta>::max();
+        return static_cast<TDelta>(delta < lowest ? lowest : (delta > highest ? highest : delta));
+    }
+
+public:
+    /**
+     * @param itemCount Number of items to track
+     * @param samplesPerItem Ring capacity per item (memory bound)
+     */
+    ValueHistory(size_t itemCount, size_t samplesPerItem)
+        : capacity(checkedCapacity(itemCount, samplesPerItem)),
+          deltas(itemCount * capacity, 0),
+          tracks(itemCount, Track{0, 0, 0, 0})
+    {
+    }
+
+    /**
+     * Append a sample to an item's history, evicting the oldest one when full. O(1).
+     */
+    void record(size_t itemIndex, int64_t value)
+    {
+        Track& track = tracks.at(itemIndex);
+        TDelta* ring = &deltas[itemIndex * capacity];
+
+        if (track.count == 0)
+        {
+            track.base = value;
+            track.newest = value;
+        }
+        else if (track.count == capacity)
+        {
+            // Evict the oldest sample by folding its delta into the base
+            track.base += ring[track.head];
+            --track.count;
+        }
+
+        TDelta delta = clampDelta(value - track.newest);
+        ring[track.head] = delta;
+        track.newest += delta;
+        track.head = static_cast<uint32_t>((track.head + 1) % capacity);
+        ++track.count;
+    }
+
+    /**
+     * Get number of samples stored for an item.
+     */
+    size_t getSampleCount(size_t itemIndex) const
+    {
+        return tracks.at(itemIndex).count;
+    }
+
+    /**
+     * Copy the most recent samples of an item, oldest first.
+     * @param out Destination for up to maxSamples values
+     * @return Number of samples written
+     */
+    size_t copyRecent(size_t itemIndex, size_t maxSamples, int64_t* out) const
+    {
+        const Track& track = tracks.at(itemIndex);
+        const TDelta* ring = &deltas[itemIndex * capacity];
+        size_t count = (maxSamples < track.count) ? maxSamples : track.count;
+
+        // Walk backwards from the newest sample, undoing one delta per step
+        int64_t value = track.newest;
+        size_t slot = track.head;
+        for (size_t i = count; i > 0; --i)
+        {
+            out[i - 1] = value;
+            slot = (slot + capacity - 1) % capacity;
+            value -= ring[slot];
+        }
+        return count;
+    }
+
+    /**
+     * Append a sparkline of an item's most recent samples to a line.
+     * Samples are scaled between their minimum and maximum; missing samples are blank.
+     */
+    void appendSparkline(size_t itemIndex, size_t width, const BarGlyphs& glyphs, std::string& line) const
+    {
+        int64_t samples[64];
+        if (width > 64)
+        {
+            width = 64;
+        }
+        size_t count = copyRecent(itemIndex, width, samples);
+
+        int64_t lowest = std::numeric_limits<int64_t>::max();
+        int64_t highest = std::numeric_limits<int64_t>::min();
+        for (size_t i = 0; i < count; ++i)
+        {
+            lowest = (samples[i] < lowest) ? samples[i] : lowest;
+            highest = (samples[i] > highest) ? samples[i] : highest;
+        }
+
+        line.append(width - count, ' ');
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t level = 0;
+            if (highest > lowest)
+            {
+                level = static_cast<size_t>((samples[i] - lowest) * static_cast<int64_t>(BarGlyphs::levelCount - 1)
+                                            / (highest - lowest));
+            }
+            line += glyphs.glyph(level);
+        }
+    }
+
+    /**
+     * Insert an empty track before itemIndex (later items shift up). O(items * capacity).
+     */
+    void insertItem(size_t itemIndex)
+    {
+        if (itemIndex > tracks.size())
+        {
+            throw std::out_of_range("History item index out of range");
+        }
+        deltas.insert(deltas.begin() + itemIndex * capacity, capacity, TDelta(0));
+        tracks.insert(tracks.begin() + itemIndex, Track{0, 0, 0, 0});
+    }
+
+    /**
+     * Remove the track of an item (later items shift down). O(items * capacity).
+     */
+    void removeItem(size_t itemIndex)
+    {
+        if (itemIndex >= tracks.size())
+        {
+            throw std::out_of_range("History item index out of range");
+        }
+        auto first = deltas.begin() + itemIndex * capacity;
+        deltas.erase(first, first + capacity);
+        tracks.erase(tracks.begin() + itemIndex);
+    }
+
+    /**
+     * Remove the tracks of several items (ascending indices) in one pass. O(items * capacity).
+     */
+    void removeItems(const std::vector<size_t>& itemIndices)
+    {
+        if (!itemIndices.empty() && itemIndices.back() >= tracks.size())
+        {
+            throw std::out_of_range("History item index out of range");
+        }
+        size_t kept = 0;
+        size_t next = 0;
+        for (size_t i = 0; i < tracks.size(); ++i)
+        {
+            if (next < itemIndices.size() && itemIndices[next] == i)
+            {
+                ++next;
+                continue;
+            }
+            if (kept != i)
+            {
+                tracks[kept] = tracks[i];
+                std::copy(deltas.begin() + i * capacity, deltas.begin() + (i + 1) * capacity,
+                          deltas.begin() + kept * capacity);
+            }
+            ++kept;
+        }
+        tracks.resize(kept);
+        deltas.resize(kept * capacity);
+    }
+
+    /**
+     * Append empty tracks for items added at the end. O(count * capacity).
+     */
+    void appendItems(size_t count)
+    {
+        deltas.resize(deltas.size() + count * capacity, TDelta(0));
+        tracks.resize(tracks.size() + count, Track{0, 0, 0, 0});
+    }
+
+    /**
+     * Get the per-item memory cost in bytes.
+     */
+    size_t getBytesPerItem() const
+    {
+        return capacity * sizeof(TDelta) + sizeof(Track);
+    }
+
+    size_t getCapacity() const
+    {
+        return capacity;
+    }
+
+    size_t getItemCount() const
+    {
+        return tracks.size();
+    }
+};
+
+#endif // VALUEHISTORY_H
@@ -0,0 +1,164 @@
+#ifndef VALUEUPDATECHANNEL_H
+#define VALUEUPDATECHANNEL_H
+
+#include "LCDDisplayController.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Lock-free channel carrying live value updates from many producer threads to the
+ * controller thread.
+ *
+ * Producers call post() from any thread; it never blocks and never fails. The queue is an
+ * intrusive multi-producer/single-consumer list: a post is one atomic exchange on the head
+ * plus one release store, so producers do not contend on a lock or on the controller.
+ * The controller thread calls drain() once per tick. It takes everything posted so far,
+ * keeps only the last update per item (in post order), and applies the result through
+ * applyUpdates() - noise filters included - as a single bulk update producing at most one
+ * frame.
+ *
+ * Each post is stamped with the controller's structure generation. Inserting or removing
+ * items in front of an index bumps it, so drain() drops updates posted before such a change
+ * instead of applying them to whichever item now sits at their index; appends keep pending
+ * updates valid. A post that is still being linked when drain() runs is picked up by the
+ * next drain.
+ *
+ * @tparam TDisplayItem The DisplayItem type of the controller being fed
+ */
+template<typename TDisplayItem>
+class ValueUpdateChannel
+{
+public:
+    using Controller = LCDDisplayController<TDisplayItem>;
+    using ValueType = typename Controller::ValueType;
+    using Clock = typename Controller::Clock;
+
+    /**
+     * Counts of one drain() call.
+     */
+    struct Stats
+    {
+        size_t received = 0;    // Updates taken from the queue
+        size_t applied = 0;     // Distinct items passed to the controller
+        size_t changed = 0;     // Items whose displayed value changed
+        size_t dropped = 0;     // Updates posted before items moved, or for missing items
+    };
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> next;
+        size_t itemIndex;
+        uint64_t generation;    // Structure generation the index was resolved in
+        ValueType value;
+
+        Node(size_t itemIndex, uint64_t generation, const ValueType& value)
+            : next(nullptr), itemIndex(itemIndex), generation(generation), value(value)
+        {
+        }
+    };
+
+    static constexpr size_t noUpdate = std::numeric_limits<size_t>::max();
+
+    Controller& controller;
+    alignas(64) std::atomic<Node*> head;            // Last posted node (producers)
+    alignas(64) Node* tail;                         // Last consumed node (consumer only)
+    std::vector<typename Controller::ValueUpdate> updates;  // Reused between drains
+    std::vector<size_t> updateOf;                   // Item index -> position in updates
+
+public:
+    explicit ValueUpdateChannel(Controller& controller)
+        : controller(controller), tail(new Node(noUpdate, 0, ValueType()))
+    {
+        head.store(tail, std::memory_order_relaxed);
+    }
+
+    ~ValueUpdateChannel()
+    {
+        while (tail)
+        {
+            Node* next = tail->next.load(std::memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+    }
+
+    ValueUpdateChannel(const ValueUpdateChannel&) = delete;
+    ValueUpdateChannel& operator=(const ValueUpdateChannel&) = delete;
+
+    /**
+     * Post a value update stamped with the current structure generation.
+     * Safe to call from any number of threads concurrently.
+     */
+    void post(size_t itemIndex, const ValueType& value)
+    {
+        post(itemIndex, value, controller.getStructureGeneration());
+    }
+
+    /**
+     * Post a value update for an index resolved in the given structure generation.
+     * Producers that look indices up while the controller thread may insert or remove items
+     * read getStructureGeneration() before the lookup and pass it here, so an index resolved
+     * against the old layout is dropped rather than misapplied.
+     */
+    void post(size_t itemIndex, const ValueType& value, uint64_t generation)
+    {
+        Node* node = new Node(itemIndex, generation, value);
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * Apply everything posted so far, one update per item, as one bulk update.
+     * Must be called on the controller thread (the single consumer).
+     */
+    Stats drain(typename Clock::time_point now = Clock::now())
+    {
+        Stats stats;
+        updates.clear();
+        const size_t itemCount = controller.getItemCount();
+        const uint64_t generation = controller.getStructureGeneration();
+        if (updateOf.size() < itemCount)
+        {
+            updateOf.resize(itemCount, noUpdate);
+        }
+
+        Node* next = tail->next.load(std::memory_order_acquire);
+        while (next)
+        {
+            delete tail;
+            tail = next;
+            ++stats.received;
+            if (tail->generation != generation || tail->itemIndex >= itemCount)
+            {
+                ++stats.dropped;
+            }
+            else if (updateOf[tail->itemIndex] == noUpdate)
+            {
+                updateOf[tail->itemIndex] = updates.size();
+                updates.emplace_back(tail->itemIndex, tail->value);
+            }
+            else
+            {
+                updates[updateOf[tail->itemIndex]].second = tail->value;   // Last write wins
+            }
+            next = tail->next.load(std::memory_order_acquire);
+        }
+
+        for (const auto& update : updates)
+        {
+            updateOf[update.first] = noUpdate;
+        }
+        stats.applied = updates.size();
+        if (!updates.empty())
+        {
+            stats.changed = controller.applyUpdates(updates, now);
+        }
+        return stats;
+    }
+};
+
+#endif // VALUEUPDATECHANNEL_H
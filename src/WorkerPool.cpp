@@ -0,0 +1,143 @@
+#include "WorkerPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+WorkerPool::WorkerPool(size_t threadCount)
+    : m_stopping(false)
+{
+    if (threadCount == 0)
+    {
+        size_t hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+    }
+
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_taskAvailable.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_taskAvailable.notify_one();
+}
+
+size_t WorkerPool::getConcurrency() const
+{
+    return m_threads.size() + 1;
+}
+
+void WorkerPool::workerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskAvailable.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty())
+            {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void WorkerPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& body, size_t minChunk)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    size_t chunkCount = std::min(getConcurrency() * 4, (count + minChunk - 1) / std::max<size_t>(minChunk, 1));
+    chunkCount = std::max<size_t>(chunkCount, 1);
+    if (chunkCount == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    // State is shared with the helper tasks: a helper that is dequeued after all chunks
+    // are done only touches this state, never the caller's stack frame or body.
+    struct State
+    {
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<size_t> remainingChunks{0};
+        std::exception_ptr firstError;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto state = std::make_shared<State>();
+    state->remainingChunks = chunkCount;
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    const auto* bodyPtr = &body;
+
+    // Every participant claims chunks until none are left
+    auto drain = [state, bodyPtr, chunkCount, chunkSize, count]()
+    {
+        for (size_t chunk = state->nextChunk++; chunk < chunkCount; chunk = state->nextChunk++)
+        {
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(begin + chunkSize, count);
+            try
+            {
+                if (begin < end)
+                {
+                    (*bodyPtr)(begin, end);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->firstError)
+                {
+                    state->firstError = std::current_exception();
+                }
+            }
+            if (--state->remainingChunks == 0)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->done.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(m_threads.size(), chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        submit(drain);
+    }
+    drain();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->remainingChunks.load() == 0; });
+    if (state->firstError)
+    {
+        std::rethrow_exception(state->firstError);
+    }
+}
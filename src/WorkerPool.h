@@ -0,0 +1,58 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Small fixed-size thread pool for background work (slow sample sources, parallel builds).
+ * Tasks are plain callables; parallelFor() splits an index range into chunks and blocks
+ * until all of them have run, with the calling thread taking part in the work.
+ */
+class WorkerPool
+{
+public:
+    /**
+     * @param threadCount Number of worker threads (0 = one per hardware thread, minus the caller)
+     */
+    explicit WorkerPool(size_t threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Queue a task for asynchronous execution.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Run body(begin, end) over [0, count) split into chunks, and wait for completion.
+     * Exceptions thrown by the body are rethrown on the calling thread.
+     * @param count Size of the index range
+     * @param body Callable processing one chunk [begin, end)
+     * @param minChunk Smallest chunk worth handing to another thread
+     */
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)>& body, size_t minChunk = 1);
+
+    /**
+     * Number of threads that execute parallelFor chunks (workers plus the caller).
+     */
+    size_t getConcurrency() const;
+
+private:
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_taskAvailable;
+    bool m_stopping;
+
+    void workerLoop();
+};
+
+#endif // WORKERPOOL_H
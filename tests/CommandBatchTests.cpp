@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "CommandBatchReader.h"
+#include "LCDInventoryController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include "SignalInterrupter.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDInventoryController<TestDisplayItem>;
+
+class CommandBatchTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::unique_ptr<Controller> controller;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+
+        std::vector<TestDisplayItem> items;
+        for (int i = 0; i < 10; ++i)
+        {
+            items.emplace_back("Item" + std::to_string(i), 0);
+        }
+        controller.reset(new Controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':')));
+    }
+
+    // Read a whole script from a temporary file, one batch per chunk
+    std::vector<std::vector<NavigationCommand>> readScript(const std::string& script)
+    {
+        std::FILE* file = std::tmpfile();
+        std::fwrite(script.data(), 1, script.size(), file);
+        std::fflush(file);
+        std::rewind(file);
+
+        CommandBatchReader reader(fileno(file));
+        std::vector<std::vector<NavigationCommand>> batches;
+        std::vector<NavigationCommand> batch;
+        bool more = true;
+        while (more)
+        {
+            more = reader.readBatch(batch);
+            batches.push_back(batch);
+        }
+        std::fclose(file);
+        return batches;
+    }
+};
+
+TEST_F(CommandBatchTests, FilesAndPipesAreBulkInput)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    EXPECT_TRUE(CommandBatchReader::isBulkInput(fds[0]));
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_F(CommandBatchTests, SignalDuringReadDoesNotEndInput)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    // The command is only written once the blocked read has been interrupted
+    SignalInterrupter interrupter;
+    std::thread writer([&]
+    {
+        EXPECT_TRUE(interrupter.interruptBlockedCall());
+        EXPECT_EQ(::write(fds[1], "s", 1), 1);
+        ::close(fds[1]);
+    });
+
+    CommandBatchReader reader(fds[0]);
+    std::vector<NavigationCommand> batch;
+    EXPECT_TRUE(reader.readBatch(batch));
+    EXPECT_EQ(batch.size(), 1u);
+    EXPECT_FALSE(reader.readBatch(batch));
+
+    writer.join();
+    ::close(fds[0]);
+}
+
+TEST_F(CommandBatchTests, ScriptIsReadInChunks)
+{
+    std::string script(3 * CommandBatchReader::chunkSize, 's');
+    auto batches = readScript(script);
+
+    // Three full chunks, then end of input
+    ASSERT_EQ(batches.size(), 4u);
+    EXPECT_EQ(batches[0].size(), CommandBatchReader::chunkSize);
+    EXPECT_TRUE(batches[3].empty());
+}
+
+TEST_F(CommandBatchTests, SequenceSplitAcrossChunksIsKept)
+{
+    // The Down-arrow sequence straddles the first chunk boundary
+    std::string script(CommandBatchReader::chunkSize - 1, 'x');
+    script += "\x1B[B";
+    auto batches = readScript(script);
+
+    ASSERT_GE(batches.size(), 2u);
+    EXPECT_TRUE(batches[0].empty());
+    ASSERT_EQ(batches[1].size(), 1u);
+    EXPECT_EQ(batches[1][0], NavigationCommand::Down);
+}
+
+TEST_F(CommandBatchTests, BatchRendersOnce)
+{
+    std::string script = "sss";
+    script += std::string(1000, 'd');
+    auto batches = readScript(script);
+    mockRenderer->reset();
+
+    EXPECT_EQ(controller->applyCommands(batches[0]), 1003u);
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(controller->getDisplayController().getCurrentValue(), 1000);
+}
+
+TEST_F(CommandBatchTests, KeylessCommandsAreIgnored)
+{
+    EXPECT_FALSE(controller->applyCommand(NavigationCommand::SelectByKey));
+    EXPECT_FALSE(controller->applyCommand(NavigationCommand::None));
+    EXPECT_TRUE(controller->applyCommand(NavigationCommand::Last));
+    EXPECT_EQ(controller->getDisplayController().getSelectedRow(), 9);
+}
@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+#include "ConcurrentKeyIndex.h"
+#include "SectionedView.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+
+class ConcurrentKeyIndexTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::unique_ptr<Controller> controller;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+
+        std::vector<TestDisplayItem> items;
+        items.emplace_back("Bolt", 1);
+        items.emplace_back("Nut", 2);
+        items.emplace_back("Screw", 3);
+        items.emplace_back("Washer", 4);
+        controller.reset(new Controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':')));
+        controller->enableKeyIndex();
+    }
+};
+
+TEST_F(ConcurrentKeyIndexTests, InsertFindRemove)
+{
+    ConcurrentKeyIndex<std::string> index;
+
+    EXPECT_TRUE(index.insert("Bolt", 0));
+    EXPECT_FALSE(index.insert("Bolt", 5));
+    EXPECT_EQ(index.find("Bolt"), 0);
+    EXPECT_TRUE(index.remove("Bolt"));
+    EXPECT_FALSE(index.remove("Bolt"));
+    EXPECT_EQ(index.find("Bolt"), ConcurrentKeyIndex<std::string>::notFound);
+
+    EXPECT_TRUE(index.insert("Bolt", 7));
+    EXPECT_EQ(index.find("Bolt"), 7);
+    EXPECT_EQ(index.size(), 1);
+}
+
+TEST_F(ConcurrentKeyIndexTests, GrowsAndReclaims)
+{
+    ConcurrentKeyIndex<int> index;
+    for (int i = 0; i < 5000; ++i)
+    {
+        index.insert(i, static_cast<size_t>(i));
+    }
+    for (int i = 0; i < 5000; i += 2)
+    {
+        index.remove(i);
+    }
+    index.reclaim();
+
+    EXPECT_EQ(index.size(), 2500);
+    EXPECT_EQ(index.find(4999), 4999);
+    EXPECT_EQ(index.find(4998), ConcurrentKeyIndex<int>::notFound);
+}
+
+TEST_F(ConcurrentKeyIndexTests, ConcurrentInsertsAndLookups)
+{
+    ConcurrentKeyIndex<int> index;
+    std::atomic<bool> done(false);
+    std::atomic<size_t> wrongLookups(0);
+
+    // A reader checks that any key it finds maps to the right index while writers insert
+    std::thread reader([&]()
+    {
+        while (!done.load())
+        {
+            for (int key = 0; key < 4000; key += 97)
+            {
+                size_t found = index.find(key);
+                if (found != ConcurrentKeyIndex<int>::notFound && found != static_cast<size_t>(key))
+                {
+                    ++wrongLookups;
+                }
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t)
+    {
+        writers.emplace_back([&index, t]()
+        {
+            for (int key = t; key < 4000; key += 4)
+            {
+                index.insert(key, static_cast<size_t>(key));
+            }
+        });
+    }
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(wrongLookups.load(), 0);
+    EXPECT_EQ(index.size(), 4000);
+    for (int key = 0; key < 4000; ++key)
+    {
+        ASSERT_EQ(index.find(key), static_cast<size_t>(key));
+    }
+}
+
+TEST_F(ConcurrentKeyIndexTests, ChurnKeepsEntriesBounded)
+{
+    ConcurrentKeyIndex<int> index;
+    std::atomic<bool> done(false);
+    std::atomic<size_t> wrongLookups(0);
+
+    // Keys 0..99 stay put while keys from 1000 on come and go; lookups run throughout
+    for (int key = 0; key < 100; ++key)
+    {
+        index.insert(key, static_cast<size_t>(key));
+    }
+    std::thread reader([&]()
+    {
+        while (!done.load())
+        {
+            for (int key = 0; key < 100; key += 7)
+            {
+                if (index.find(key) != static_cast<size_t>(key))
+                {
+                    ++wrongLookups;
+                }
+            }
+        }
+    });
+
+    size_t maxEntries = 0;
+    for (int round = 0; round < 2000; ++round)
+    {
+        for (int key = 1000 + round * 50; key < 1050 + round * 50; ++key)
+        {
+            index.insert(key, 0);
+        }
+        for (int key = 1000 + round * 50; key < 1050 + round * 50; ++key)
+        {
+            index.remove(key);
+        }
+        maxEntries = std::max(maxEntries, index.entryCount());
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(wrongLookups.load(), 0);
+    EXPECT_EQ(index.size(), 100);
+    EXPECT_LT(maxEntries, 1000u);   // 100,000 keys passed through
+    index.reclaim();
+    EXPECT_EQ(index.entryCount(), 100);
+}
+
+TEST_F(ConcurrentKeyIndexTests, ControllerChurnKeepsIndexBounded)
+{
+    for (int round = 0; round < 500; ++round)
+    {
+        std::vector<TestDisplayItem> batch;
+        for (int i = 0; i < 20; ++i)
+        {
+            batch.emplace_back("T" + std::to_string(round * 20 + i), i);
+        }
+        controller->appendItems(batch);
+        controller->removeItem(4);
+        std::vector<size_t> rest(19);
+        for (size_t i = 0; i < rest.size(); ++i)
+        {
+            rest[i] = 4 + i;
+        }
+        controller->removeItems(rest);
+    }
+
+    EXPECT_EQ(controller->getItemCount(), 4);
+    EXPECT_EQ(controller->getKeyIndex()->size(), 4);
+    EXPECT_LT(controller->getKeyIndex()->entryCount(), 200u);   // 10,000 keys passed through
+    EXPECT_EQ(controller->findItem("Washer"), 3);
+    EXPECT_EQ(controller->findItem("T9999"), IItemView::noItem);
+}
+
+TEST_F(ConcurrentKeyIndexTests, UpdateByKeyUsesIndex)
+{
+    EXPECT_TRUE(controller->updateValueByKey("Screw", 30));
+    EXPECT_FALSE(controller->updateValueByKey("Nail", 30));
+    EXPECT_EQ(controller->getItems()[2].getValue(), 30);
+
+    EXPECT_TRUE(controller->jumpToKey("Washer"));
+    EXPECT_EQ(controller->getSelectedItemIndex(), 3);
+}
+
+TEST_F(ConcurrentKeyIndexTests, InsertItemKeepsIndexAndSelection)
+{
+    controller->jumpToKey("Screw");
+    controller->insertItem(1, TestDisplayItem("Rivet", 9));
+
+    EXPECT_EQ(controller->getItemCount(), 5);
+    EXPECT_EQ(controller->findItem("Rivet"), 1);
+    EXPECT_EQ(controller->findItem("Screw"), 3);
+    EXPECT_EQ(controller->getSelectedItemIndex(), 3);
+    EXPECT_EQ(controller->getCurrentKey(), "Screw");
+}
+
+TEST_F(ConcurrentKeyIndexTests, RemoveItemKeepsIndexAndFilters)
+{
+    controller->setValueFilter(3, ValueFilterConfig(10));
+    controller->jumpToKey("Nut");
+    controller->selectItem();
+    controller->removeItem(1);
+
+    EXPECT_EQ(controller->findItem("Nut"), IItemView::noItem);
+    EXPECT_EQ(controller->findItem("Washer"), 2);
+    EXPECT_FALSE(controller->getIsSelected());
+    EXPECT_EQ(controller->getCurrentKey(), "Screw");
+
+    // Washer's deadband filter moved with it
+    EXPECT_FALSE(controller->updateValue(2, 5));
+}
+
+TEST_F(ConcurrentKeyIndexTests, DuplicateKeysAreRejected)
+{
+    EXPECT_THROW(controller->insertItem(0, TestDisplayItem("Nut", 9)), std::invalid_argument);
+    EXPECT_EQ(controller->getItemCount(), 4);
+    EXPECT_EQ(controller->findItem("Nut"), 1);
+
+    Controller duplicates({TestDisplayItem("Bolt", 1), TestDisplayItem("Bolt", 2)}, mockRenderer,
+                          DisplayConfig(2, 16, '>', ':'));
+    WorkerPool pool(2);
+    EXPECT_THROW(duplicates.enableKeyIndex(), std::invalid_argument);
+    EXPECT_THROW(duplicates.enableKeyIndex(&pool), std::invalid_argument);
+    EXPECT_EQ(duplicates.getKeyIndex(), nullptr);
+}
+
+TEST_F(ConcurrentKeyIndexTests, SectionedViewFollowsInsertAndRemove)
+{
+    auto sections = std::make_shared<SectionedView>(SectionedView::fromCategories(
+        {"Fasteners", "Fasteners", "Fasteners", "Washers"}));
+    controller->setView(sections);
+
+    controller->insertItem(3, TestDisplayItem("Rivet", 9));
+    EXPECT_EQ(sections->getSection(0).itemCount, 3);
+    EXPECT_EQ(sections->getSection(1).itemCount, 2);
+    EXPECT_EQ(sections->getRowOfItem(4), 6);
+
+    controller->removeItem(0);
+    EXPECT_EQ(sections->getSection(0).itemCount, 2);
+    EXPECT_EQ(controller->getRowCount(), 6);
+}
+
+TEST_F(ConcurrentKeyIndexTests, StructureChangesRejectedWithDerivedValues)
+{
+    controller->defineDerivedValue(3, {0, 1}, [](const std::vector<int>& in) { return in[0] + in[1]; });
+
+    EXPECT_THROW(controller->removeItem(0), std::logic_error);
+    EXPECT_THROW(controller->insertItem(9, TestDisplayItem("Rivet", 9)), std::out_of_range);
+}
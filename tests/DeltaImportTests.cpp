@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "DeltaImporter.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+using Importer = DeltaImporter<TestDisplayItem>;
+
+class DeltaImportTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> renderer = std::make_shared<MockRenderer>();
+    std::unique_ptr<Controller> controller;
+
+    void SetUp() override
+    {
+        std::vector<TestDisplayItem> items;
+        for (int i = 0; i < 100; ++i)
+        {
+            items.emplace_back("Item" + std::to_string(i), i);
+        }
+        controller = std::make_unique<Controller>(items, renderer, DisplayConfig(2, 16, '>', ':'));
+        renderer->reset();
+    }
+
+    Importer::Stats importText(const std::string& text)
+    {
+        std::istringstream input(text);
+        return Importer(*controller).import(input);
+    }
+};
+
+/**
+ * Counts the structure changes a controller reports.
+ */
+class StructureCounter : public IStructureListener
+{
+public:
+    size_t insertCalls = 0;
+    size_t removeCalls = 0;
+    size_t itemsInsertedCount = 0;
+    size_t itemsRemovedCount = 0;
+
+    void itemsInserted(size_t, size_t count) override
+    {
+        ++insertCalls;
+        itemsInsertedCount += count;
+    }
+
+    void itemsRemoved(const std::vector<size_t>& itemIndices) override
+    {
+        ++removeCalls;
+        itemsRemovedCount += itemIndices.size();
+    }
+};
+
+TEST_F(DeltaImportTests, AppliesUpsertsAndDeletes)
+{
+    Importer::Stats stats = importText("# nightly delta\n"
+                                       "+Item5\t50\n"
+                                       "\n"
+                                       "+Anchor\t7\r\n"
+                                       "-Item9\n"
+                                       "-Unknown\n");
+
+    EXPECT_EQ(stats.updated, 1u);
+    EXPECT_EQ(stats.inserted, 1u);
+    EXPECT_EQ(stats.removed, 1u);
+    EXPECT_EQ(stats.missing, 1u);
+    EXPECT_EQ(controller->getItems()[5].getValue(), 50);
+    EXPECT_EQ(controller->findItem("Item9"), IItemView::noItem);
+    EXPECT_EQ(controller->findItem("Item10"), 9u);
+    ASSERT_EQ(controller->getItemCount(), 100u);
+    EXPECT_EQ(controller->getItems()[99].getKey(), "Anchor");
+    EXPECT_EQ(controller->getItems()[99].getValue(), 7);
+}
+
+TEST_F(DeltaImportTests, PreservesSelectionAndRendersOnce)
+{
+    controller->jumpToItem(50);
+    renderer->reset();
+
+    importText("-Item10\n+Item60\t1\n+Item49\t0\n+New\t1\n");
+
+    EXPECT_EQ(renderer->renderCallCount, 1);
+    EXPECT_EQ(controller->getCurrentKey(), "Item50");
+}
+
+TEST_F(DeltaImportTests, SkipsFrameWhenChangesAreOffScreen)
+{
+    importText("+Item40\t1\n+Item41\t2\n+Item40\t3\n");
+
+    EXPECT_EQ(renderer->renderCallCount, 0);
+    EXPECT_EQ(controller->getItems()[40].getValue(), 3);
+
+    importText("+Item1\t9\n");
+    EXPECT_EQ(renderer->renderCallCount, 1);
+    EXPECT_NE(renderer->getLine(1).find("9"), std::string::npos);
+}
+
+TEST_F(DeltaImportTests, LastUpsertOfAKeyWins)
+{
+    importText("+Item3\t30\n+Item3\t3\n");
+
+    EXPECT_EQ(controller->getItems()[3].getValue(), 3);
+}
+
+TEST_F(DeltaImportTests, HiddenPageIsMarkedDirty)
+{
+    controller->setVisible(false);
+
+    importText("+Item70\t1\n");
+
+    EXPECT_TRUE(controller->isDirty());
+    EXPECT_EQ(renderer->renderCallCount, 0);
+}
+
+TEST_F(DeltaImportTests, MalformedLineStopsImportAfterApplyingPrefix)
+{
+    EXPECT_THROW(importText("+Item2\t20\n+Item3 30\n+Item4\t40\n"), std::invalid_argument);
+    EXPECT_EQ(controller->getItems()[2].getValue(), 20);
+    EXPECT_EQ(controller->getItems()[4].getValue(), 4);
+
+    EXPECT_THROW(importText("+Item2\tabc\n"), std::invalid_argument);
+    EXPECT_THROW(importText("*Item2\t1\n"), std::invalid_argument);
+    EXPECT_THROW(importText("-\n"), std::invalid_argument);
+}
+
+TEST_F(DeltaImportTests, ParsesByteSizedValuesAsNumbers)
+{
+    std::vector<InventoryDisplayItem> items = {{"Bolt", 1}, {"Nut", 2}};
+    LCDDisplayController<InventoryDisplayItem> inventory(items, renderer, DisplayConfig(2, 16, '>', ':'));
+    DeltaImporter<InventoryDisplayItem> importer(inventory);
+
+    std::istringstream input("+Bolt\t5\n"
+                             "+Nut\t12\n"
+                             "+Washer\t 255 \n");
+    DeltaImporter<InventoryDisplayItem>::Stats stats = importer.import(input);
+
+    EXPECT_EQ(stats.updated, 2u);
+    EXPECT_EQ(stats.inserted, 1u);
+    EXPECT_EQ(inventory.getItems()[0].getValue(), 5);
+    EXPECT_EQ(inventory.getItems()[1].getValue(), 12);
+    EXPECT_EQ(inventory.getItems()[2].getValue(), 255);
+
+    std::istringstream outOfRange("+Bolt\t256\n");
+    EXPECT_THROW(importer.import(outOfRange), std::invalid_argument);
+    std::istringstream negative("+Bolt\t-1\n");
+    EXPECT_THROW(importer.import(negative), std::invalid_argument);
+    std::istringstream letter("+Bolt\tA\n");
+    EXPECT_THROW(importer.import(letter), std::invalid_argument);
+    EXPECT_EQ(inventory.getItems()[0].getValue(), 5);
+}
+
+TEST_F(DeltaImportTests, DeletesAndAppendsAreAppliedInBulk)
+{
+    StructureCounter counter;
+    controller->addStructureListener(&counter);
+    std::string text;
+    for (int i = 0; i < 100; i += 2)
+    {
+        text += "-Item" + std::to_string(i) + "\n";
+        text += "+New" + std::to_string(i) + "\t" + std::to_string(i) + "\n";
+        text += "+Item" + std::to_string(i + 1) + "\t0\n";
+    }
+    text += "+New4\t44\n"       // Upsert of a pending new item
+            "-New6\n"            // Delete of a pending new item
+            "+Item10\t10\n"     // Deleted above, so appended again
+            "-Item0\n";          // Already deleted
+
+    Importer::Stats stats = importText(text);
+    controller->removeStructureListener(&counter);
+
+    EXPECT_EQ(counter.removeCalls, 1u);
+    EXPECT_EQ(counter.insertCalls, 1u);
+    EXPECT_EQ(counter.itemsRemovedCount, 50u);
+    EXPECT_EQ(counter.itemsInsertedCount, 50u);
+    EXPECT_EQ(stats.removed, 51u);
+    EXPECT_EQ(stats.inserted, 51u);
+    EXPECT_EQ(stats.missing, 1u);
+
+    ASSERT_EQ(controller->getItemCount(), 100u);
+    EXPECT_EQ(controller->getItems()[0].getKey(), "Item1");
+    EXPECT_EQ(controller->getItems()[0].getValue(), 0);
+    EXPECT_EQ(controller->getItems()[50].getKey(), "New0");
+    EXPECT_EQ(controller->getItems()[52].getKey(), "New4");
+    EXPECT_EQ(controller->getItems()[52].getValue(), 44);
+    EXPECT_EQ(controller->findItem("New6"), IItemView::noItem);
+    EXPECT_EQ(controller->getItems()[99].getKey(), "Item10");
+    EXPECT_EQ(controller->findItem("Item10"), 99u);
+}
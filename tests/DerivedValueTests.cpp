@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "DerivedValueGraph.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <numeric>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+
+static int sum(const std::vector<int>& inputs)
+{
+    return std::accumulate(inputs.begin(), inputs.end(), 0);
+}
+
+class DerivedValueTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::unique_ptr<Controller> controller;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+        std::vector<TestDisplayItem> items;
+        items.emplace_back("Bolts", 3);     // 0
+        items.emplace_back("Nuts", 4);      // 1
+        items.emplace_back("Total", 0);     // 2 = 0 + 1
+        items.emplace_back("Price", 5);     // 3
+        items.emplace_back("Worth", 0);     // 4 = total * price
+        controller.reset(new Controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':')));
+    }
+
+    int valueOf(size_t index) const
+    {
+        return controller->getItems()[index].getValue();
+    }
+};
+
+TEST_F(DerivedValueTests, DefinitionComputesInitialValue)
+{
+    controller->defineDerivedValue(2, {0, 1}, sum);
+
+    EXPECT_EQ(valueOf(2), 7);
+    EXPECT_TRUE(controller->isDerivedValue(2));
+}
+
+TEST_F(DerivedValueTests, ChangesPropagateThroughChains)
+{
+    controller->defineDerivedValue(2, {0, 1}, sum);
+    controller->defineDerivedValue(4, {2, 3}, [](const std::vector<int>& in) { return in[0] * in[1]; });
+
+    controller->setCurrentValue(10);   // Bolts
+
+    EXPECT_EQ(valueOf(2), 14);
+    EXPECT_EQ(valueOf(4), 70);
+}
+
+TEST_F(DerivedValueTests, BatchRecomputesOncePerFrame)
+{
+    int computeCount = 0;
+    controller->defineDerivedValue(2, {0, 1}, [&](const std::vector<int>& in) { ++computeCount; return sum(in); });
+    computeCount = 0;
+    mockRenderer->reset();
+
+    {
+        Controller::BatchScope batch(*controller);
+        controller->updateValue(0, 100);
+        controller->updateValue(1, 200);
+    }
+
+    EXPECT_EQ(computeCount, 1);
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(valueOf(2), 300);
+}
+
+TEST_F(DerivedValueTests, UnrelatedChangesDoNotRecompute)
+{
+    int computeCount = 0;
+    controller->defineDerivedValue(2, {0, 1}, [&](const std::vector<int>& in) { ++computeCount; return sum(in); });
+    computeCount = 0;
+
+    controller->updateValue(3, 9);
+
+    EXPECT_EQ(computeCount, 0);
+}
+
+TEST_F(DerivedValueTests, DiamondDependencyComputesEachNodeOnceAfterInputs)
+{
+    // 2 = 0 + 1, 3 = 0 * 2, 4 = 2 + 3  (4 must see the new values of both 2 and 3)
+    int worthComputations = 0;
+    controller->defineDerivedValue(2, {0, 1}, sum);
+    controller->defineDerivedValue(3, {0, 2}, [](const std::vector<int>& in) { return in[0] * in[1]; });
+    controller->defineDerivedValue(4, {2, 3}, [&](const std::vector<int>& in) { ++worthComputations; return sum(in); });
+    worthComputations = 0;
+
+    controller->updateValue(0, 2);
+
+    EXPECT_EQ(valueOf(2), 6);
+    EXPECT_EQ(valueOf(3), 12);
+    EXPECT_EQ(valueOf(4), 18);
+    EXPECT_EQ(worthComputations, 1);
+}
+
+TEST_F(DerivedValueTests, CyclesAreRejected)
+{
+    controller->defineDerivedValue(2, {0, 1}, sum);
+    controller->defineDerivedValue(4, {2}, sum);
+
+    EXPECT_THROW(controller->defineDerivedValue(0, {4}, sum), std::invalid_argument);
+    EXPECT_THROW(controller->defineDerivedValue(3, {3}, sum), std::invalid_argument);
+    EXPECT_THROW(controller->defineDerivedValue(3, {99}, sum), std::out_of_range);
+}
+
+TEST_F(DerivedValueTests, RemovedDerivedValueKeepsLastValue)
+{
+    controller->defineDerivedValue(2, {0, 1}, sum);
+    EXPECT_TRUE(controller->removeDerivedValue(2));
+
+    controller->updateValue(0, 50);
+
+    EXPECT_EQ(valueOf(2), 7);
+    EXPECT_FALSE(controller->removeDerivedValue(2));
+}
+
+TEST_F(DerivedValueTests, HiddenDisplayStillUpdatesDerivedModel)
+{
+    controller->defineDerivedValue(2, {0, 1}, sum);
+    controller->setVisible(false);
+    mockRenderer->reset();
+
+    controller->updateValue(1, 40);
+
+    EXPECT_EQ(valueOf(2), 43);
+    EXPECT_EQ(mockRenderer->renderCallCount, 0);
+}
+
+TEST_F(DerivedValueTests, GraphRedefinitionMovesDependentsToNewLevel)
+{
+    DerivedValueGraph<int> graph;
+    std::vector<int> values = {1, 2, 0, 0};
+    auto get = [&](size_t i) { return values[i]; };
+    auto set = [&](size_t i, int v) { values[i] = v; };
+
+    graph.define(3, {2}, sum);
+    graph.define(2, {0}, sum);
+    graph.propagate(get, set);
+    graph.define(2, {0, 1}, sum);
+    graph.propagate(get, set);
+
+    EXPECT_EQ(values[2], 3);
+    EXPECT_EQ(values[3], 3);
+    EXPECT_FALSE(graph.hasPending());
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "EscapeSequenceParser.h"
+#include "ConsoleInputListener.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include "SignalInterrupter.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+
+class EscapeSequenceTests : public ::testing::Test
+{
+protected:
+    EscapeSequenceParser parser;
+
+    std::vector<NavigationCommand> parse(const std::string& input)
+    {
+        std::vector<NavigationCommand> commands(input.size());
+        commands.resize(parser.parse(input.data(), input.size(), commands.data()));
+        return commands;
+    }
+};
+
+TEST_F(EscapeSequenceTests, ArrowKeysInCsiAndSs3Form)
+{
+    auto commands = parse("\x1B[A\x1B[B\x1BOC\x1BOD");
+
+    std::vector<NavigationCommand> expected = {
+        NavigationCommand::Up, NavigationCommand::Down,
+        NavigationCommand::Increment, NavigationCommand::Decrement};
+    EXPECT_EQ(commands, expected);
+    EXPECT_FALSE(parser.isPending());
+}
+
+TEST_F(EscapeSequenceTests, PagingKeysAndModifiers)
+{
+    auto commands = parse("\x1B[5~\x1B[6~\x1B[H\x1B[4~\x1B[1;5A\x1B[6;2~");
+
+    std::vector<NavigationCommand> expected = {
+        NavigationCommand::PageUp, NavigationCommand::PageDown,
+        NavigationCommand::First, NavigationCommand::Last,
+        NavigationCommand::Up, NavigationCommand::PageDown};
+    EXPECT_EQ(commands, expected);
+}
+
+TEST_F(EscapeSequenceTests, FunctionKeysAreConsumedWithoutCommands)
+{
+    // F1 (SS3), F5 (CSI 15~), Delete: none of their bytes leak out as plain keys
+    auto commands = parse("\x1BOP\x1B[15~\x1B[3~s");
+
+    ASSERT_EQ(commands.size(), 1u);
+    EXPECT_EQ(commands[0], NavigationCommand::Down);
+}
+
+TEST_F(EscapeSequenceTests, PlainKeysStillMap)
+{
+    auto commands = parse("wsedqa");
+
+    std::vector<NavigationCommand> expected = {
+        NavigationCommand::Up, NavigationCommand::Down, NavigationCommand::Select,
+        NavigationCommand::Increment, NavigationCommand::Deselect, NavigationCommand::Decrement};
+    EXPECT_EQ(commands, expected);
+}
+
+TEST_F(EscapeSequenceTests, LoneEscapeNeedsTimeout)
+{
+    EXPECT_EQ(parser.feed('\x1B'), NavigationCommand::None);
+    EXPECT_TRUE(parser.isPending());
+    EXPECT_EQ(parser.timeout(), NavigationCommand::Deselect);
+    EXPECT_FALSE(parser.isPending());
+
+    // A sequence split across reads completes when the rest arrives
+    parse("\x1B[");
+    EXPECT_TRUE(parser.isPending());
+    EXPECT_EQ(parse("B"), std::vector<NavigationCommand>{NavigationCommand::Down});
+}
+
+TEST_F(EscapeSequenceTests, LargePasteParsesEveryKey)
+{
+    std::string paste;
+    for (int i = 0; i < 10000; ++i)
+    {
+        paste += "\x1B[B";
+    }
+    auto commands = parse(paste);
+
+    EXPECT_EQ(commands.size(), 10000u);
+    EXPECT_EQ(commands.back(), NavigationCommand::Down);
+}
+
+TEST_F(EscapeSequenceTests, ConsoleListenerDecodesSequencesFromInput)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ConsoleInputListener listener(fds[0]);
+    listener.startListening();
+
+    ASSERT_EQ(::write(fds[1], "\x1B[6~\x1B", 5), 5);
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::PageDown);
+    // The trailing Escape becomes a key once the escape timeout passes
+    EXPECT_EQ(listener.pollCommand(), NavigationCommand::None);
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::Deselect);
+
+    ::close(fds[1]);
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::None);
+    ::close(fds[0]);
+}
+
+TEST_F(EscapeSequenceTests, ConsoleListenerSurvivesSignalDuringWait)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ConsoleInputListener listener(fds[0]);
+    listener.startListening();
+
+    SignalInterrupter interrupter;
+    std::thread writer([&]
+    {
+        // The key is only written once the wait has been interrupted
+        EXPECT_TRUE(interrupter.interruptBlockedCall());
+        EXPECT_EQ(::write(fds[1], "\x1B[A", 3), 3);
+    });
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::Up);
+    EXPECT_TRUE(listener.isListening());
+
+    writer.join();
+    ::close(fds[1]);
+    ::close(fds[0]);
+}
+
+TEST_F(EscapeSequenceTests, ConsoleListenerStopsOnInputError)
+{
+    // Reading a write-only descriptor fails: listening stops instead of polling forever
+    int fd = ::open("/dev/null", O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ConsoleInputListener listener(fd);
+    listener.startListening();
+
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::None);
+    EXPECT_FALSE(listener.isListening());
+    ::close(fd);
+}
+
+TEST_F(EscapeSequenceTests, ControllerPagesByDisplayRows)
+{
+    auto renderer = std::make_shared<MockRenderer>();
+    std::vector<TestDisplayItem> items;
+    for (int i = 0; i < 5; ++i)
+    {
+        items.emplace_back("Item" + std::to_string(i), i);
+    }
+    Controller controller(items, renderer, DisplayConfig(2, 16, '>', ':'));
+
+    EXPECT_TRUE(controller.pageDown());
+    EXPECT_EQ(controller.getSelectedRow(), 2);
+    EXPECT_TRUE(controller.navigateToLast());
+    EXPECT_EQ(controller.getSelectedRow(), 4);
+    EXPECT_FALSE(controller.pageDown());
+    EXPECT_TRUE(controller.pageUp());
+    EXPECT_EQ(controller.getSelectedRow(), 2);
+    EXPECT_TRUE(controller.navigateToFirst());
+    EXPECT_EQ(controller.getWindowStartIndex(), 0);
+    EXPECT_FALSE(controller.pageUp());
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "FrontCodedKeyStore.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+
+class FrontCodedKeyStoreTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::vector<std::string> keys;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+
+        // WIDGET-0000 .. WIDGET-0099, already sorted
+        char buffer[16];
+        for (int i = 0; i < 100; ++i)
+        {
+            std::snprintf(buffer, sizeof(buffer), "WIDGET-%04d", i);
+            keys.push_back(buffer);
+        }
+    }
+};
+
+TEST_F(FrontCodedKeyStoreTests, RandomAccessReturnsOriginalKeys)
+{
+    FrontCodedKeyStore store(keys, 8);
+
+    ASSERT_EQ(store.getKeyCount(), keys.size());
+    for (size_t i : {99, 0, 57, 8, 7, 63, 64})
+    {
+        EXPECT_EQ(store.getKey(i), keys[i]);
+    }
+    EXPECT_THROW(store.getKey(100), std::out_of_range);
+}
+
+TEST_F(FrontCodedKeyStoreTests, SequentialAccessReturnsOriginalKeys)
+{
+    FrontCodedKeyStore store(keys, 16);
+    std::string key;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        store.getKey(i, key);
+        EXPECT_EQ(key, keys[i]);
+    }
+}
+
+TEST_F(FrontCodedKeyStoreTests, SharedPrefixesAreStoredOnce)
+{
+    FrontCodedKeyStore store(keys, 16);
+
+    // 100 keys of 11 characters; most entries keep only their last one or two digits
+    EXPECT_LT(store.getByteSize(), 100 * 11 / 2);
+}
+
+TEST_F(FrontCodedKeyStoreTests, LowerBoundAndFind)
+{
+    FrontCodedKeyStore store(keys, 8);
+
+    EXPECT_EQ(store.lowerBound("A"), 0);
+    EXPECT_EQ(store.lowerBound("WIDGET-0042"), 42);
+    EXPECT_EQ(store.lowerBound("WIDGET-00425"), 43);
+    EXPECT_EQ(store.lowerBound("Z"), 100);
+    EXPECT_EQ(store.find("WIDGET-0016"), 16);
+    EXPECT_EQ(store.find("WIDGET-01"), FrontCodedKeyStore::notFound);
+}
+
+TEST_F(FrontCodedKeyStoreTests, RejectsUnsortedKeys)
+{
+    EXPECT_THROW(FrontCodedKeyStore({"B", "A"}), std::invalid_argument);
+    EXPECT_THROW(FrontCodedKeyStore(keys, 0), std::invalid_argument);
+}
+
+TEST_F(FrontCodedKeyStoreTests, ControllerShowsKeysFromColumn)
+{
+    std::vector<TestDisplayItem> items(keys.size(), TestDisplayItem("", 0));
+    Controller controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':'));
+
+    controller.setKeyColumn(std::make_shared<FrontCodedKeyStore>(keys));
+    controller.navigateDown();
+    controller.navigateDown();
+
+    EXPECT_EQ(mockRenderer->getLine(0), " WIDGET-000:0   ");
+    EXPECT_EQ(mockRenderer->getLine(1), ">WIDGET-000:0   ");
+
+    std::vector<std::string> tooFew(keys.begin(), keys.begin() + 3);
+    EXPECT_THROW(controller.setKeyColumn(std::make_shared<FrontCodedKeyStore>(tooFew)),
+                 std::invalid_argument);
+}
+
+TEST_F(FrontCodedKeyStoreTests, KeyLookupsGoThroughTheColumn)
+{
+    std::vector<TestDisplayItem> items(keys.size(), TestDisplayItem("", 0));
+    Controller controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':'));
+    auto store = std::make_shared<FrontCodedKeyStore>(keys);
+    controller.setKeyColumn(store);
+
+    EXPECT_TRUE(controller.jumpToKey(*store, std::string("WIDGET-0042")));
+    EXPECT_EQ(controller.getSelectedItemIndex(), 42u);
+    EXPECT_EQ(controller.getCurrentKeyText(), "WIDGET-0042");
+
+    // Item keys are empty: lookups by item key would silently resolve to the wrong item
+    EXPECT_THROW(controller.findItem("WIDGET-0042"), std::logic_error);
+    EXPECT_THROW(controller.enableKeyIndex(), std::logic_error);
+    EXPECT_THROW(controller.getCurrentKey(), std::logic_error);
+
+}
+
+TEST_F(FrontCodedKeyStoreTests, KeyColumnIsRejectedWhileKeyIndexIsEnabled)
+{
+    std::vector<TestDisplayItem> items;
+    for (const auto& key : keys)
+    {
+        items.emplace_back(key, 0);
+    }
+    Controller controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':'));
+    controller.enableKeyIndex();
+
+    EXPECT_THROW(controller.setKeyColumn(std::make_shared<FrontCodedKeyStore>(keys)), std::logic_error);
+}
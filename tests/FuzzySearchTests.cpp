@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "TrigramIndex.h"
+#include "FuzzySearchView.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+using TestFuzzyView = FuzzySearchView<TestDisplayItem>;
+
+class FuzzySearchTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> renderer = std::make_shared<MockRenderer>();
+
+    static std::vector<TestDisplayItem> makeItems()
+    {
+        return {{"SKU-10423", 1}, {"SKU-77310", 2}, {"SKU-10432", 3}, {"BOLT-M4", 4},
+                {"SKU-1042", 5}, {"WASHER", 6}};
+    }
+};
+
+TEST_F(FuzzySearchTests, EditDistanceCountsTranspositionsOnce)
+{
+    EXPECT_EQ(TrigramIndex::editDistance("SKU-10423", "SKU-10423", 2), 0u);
+    EXPECT_EQ(TrigramIndex::editDistance("SKU-10423", "sku-10423", 2), 0u);
+    EXPECT_EQ(TrigramIndex::editDistance("SKU-10423", "SKU-10432", 2), 1u);
+    EXPECT_EQ(TrigramIndex::editDistance("SKU-10423", "SKU-1042", 2), 1u);
+    EXPECT_EQ(TrigramIndex::editDistance("KITTEN", "SITTING", 5), 3u);
+    EXPECT_EQ(TrigramIndex::editDistance("ABCDEF", "UVWXYZ", 2), 3u);
+    EXPECT_EQ(TrigramIndex::editDistance("", "ABC", 5), 3u);
+}
+
+TEST_F(FuzzySearchTests, FindsMistypedKeysRankedByDistance)
+{
+    TrigramIndex index;
+    for (const auto& item : makeItems())
+    {
+        index.append(item.getKeyText());
+    }
+
+    std::vector<TrigramIndex::Match> matches = index.search("sku-10423", 10);
+
+    ASSERT_EQ(matches.size(), 3u);
+    EXPECT_EQ(matches[0].itemIndex, 0u);
+    EXPECT_EQ(matches[0].distance, 0u);
+    EXPECT_EQ(matches[1].distance, 1u);
+    EXPECT_EQ(matches[2].distance, 1u);
+    EXPECT_EQ(index.search("SKU-10423", 1).size(), 1u);
+    EXPECT_TRUE(index.search("ZZZZZZ", 10).empty());
+    EXPECT_TRUE(index.search("", 10).empty());
+}
+
+TEST_F(FuzzySearchTests, IndexFollowsInsertAndRemove)
+{
+    TrigramIndex index;
+    index.append("ALPHA");
+    index.append("GAMMA");
+    index.insert(1, "BETA");
+
+    ASSERT_EQ(index.search("GAMA", 5).size(), 1u);
+    EXPECT_EQ(index.search("GAMA", 5)[0].itemIndex, 2u);
+
+    index.remove(0);
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_TRUE(index.search("ALPHA", 5).empty());
+    EXPECT_EQ(index.search("BETTA", 5)[0].itemIndex, 0u);
+    EXPECT_EQ(index.search("GAMMA", 5)[0].itemIndex, 1u);
+    EXPECT_THROW(index.remove(2), std::out_of_range);
+}
+
+TEST_F(FuzzySearchTests, ViewShowsBestMatchFirst)
+{
+    Controller controller(makeItems(), renderer, DisplayConfig(2, 16, '>', ':'));
+    auto view = std::make_shared<TestFuzzyView>(controller.getItems());
+    controller.setView(view);
+    EXPECT_EQ(view->getRowCount(), 0u);
+
+    view->setQuery("SKU-10432");
+    controller.refreshView();
+
+    EXPECT_EQ(controller.getCurrentKey(), "SKU-10432");
+    EXPECT_EQ(view->getRowCount(), 3u);
+    EXPECT_EQ(view->getRowOfItem(2), 0u);
+    EXPECT_EQ(view->getRowOfItem(3), IItemView::noItem);
+}
+
+TEST_F(FuzzySearchTests, ViewFollowsInventoryChanges)
+{
+    Controller controller(makeItems(), renderer, DisplayConfig(2, 16, '>', ':'));
+    auto view = std::make_shared<TestFuzzyView>(controller.getItems());
+    controller.setView(view);
+    view->setQuery("BOLT-M5");
+    controller.refreshView();
+    ASSERT_EQ(view->getRowCount(), 1u);
+
+    controller.insertItem(0, TestDisplayItem("BOLT-M5", 9));
+    EXPECT_EQ(view->getRowCount(), 2u);
+    EXPECT_EQ(view->getItemAtRow(0), 0u);
+    EXPECT_EQ(view->getItemAtRow(1), 4u);
+
+    controller.removeItem(0);
+    EXPECT_EQ(view->getRowCount(), 1u);
+    EXPECT_EQ(view->getItemAtRow(0), 3u);
+}
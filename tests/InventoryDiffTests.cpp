@@ -0,0 +1,330 @@
+#include <gtest/gtest.h>
+#include "InventoryDiff.h"
+#include "WorkerPool.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include "NaturalSortedView.h"
+#include "QueryView.h"
+#include "KeySearchView.h"
+#include "FuzzySearchView.h"
+#include "SectionedView.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+using Diff = InventoryDiff<TestDisplayItem>;
+
+class InventoryDiffTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> renderer = std::make_shared<MockRenderer>();
+    WorkerPool pool{4};
+
+    static std::vector<TestDisplayItem> makeItems(int count)
+    {
+        std::vector<TestDisplayItem> items;
+        for (int i = 0; i < count; ++i)
+        {
+            items.emplace_back("Item" + std::to_string(i), i);
+        }
+        return items;
+    }
+
+    // Remove every seventh item, then append new ones
+    static void applyBulkChanges(Controller& controller)
+    {
+        std::vector<size_t> removed;
+        for (size_t i = 0; i < controller.getItemCount(); i += 7)
+        {
+            removed.push_back(i);
+        }
+        std::vector<TestDisplayItem> added;
+        for (int i = 0; i < 50; ++i)
+        {
+            added.emplace_back("New" + std::to_string(i * 37 % 50), i);
+        }
+        controller.removeItems(removed);
+        controller.appendItems(added);
+    }
+
+    static void expectSameRows(const IItemView& kept, const IItemView& fresh)
+    {
+        ASSERT_EQ(kept.getRowCount(), fresh.getRowCount());
+        for (size_t row = 0; row < fresh.getRowCount(); ++row)
+        {
+            ASSERT_EQ(kept.getItemAtRow(row), fresh.getItemAtRow(row)) << "row " << row;
+        }
+    }
+};
+
+/**
+ * View with one row per item that counts how it is told about structure changes.
+ */
+class CountingView : public IItemView
+{
+public:
+    size_t itemCount;
+    size_t singleChanges = 0;
+    size_t bulkChanges = 0;
+
+    explicit CountingView(size_t itemCount) : itemCount(itemCount) {}
+
+    size_t getRowCount() const override { return itemCount; }
+    size_t getItemAtRow(size_t row) const override { return row < itemCount ? row : noItem; }
+    size_t getRowOfItem(size_t itemIndex) const override { return itemIndex < itemCount ? itemIndex : noItem; }
+    std::string getRowLabel(size_t) const override { return std::string(); }
+    bool activateRow(size_t) override { return false; }
+    void itemInserted(size_t) override { ++singleChanges; ++itemCount; }
+    void itemRemoved(size_t) override { ++singleChanges; --itemCount; }
+    void itemsRemoved(const std::vector<size_t>& itemIndices) override
+    {
+        ++bulkChanges;
+        itemCount -= itemIndices.size();
+    }
+    void itemsAppended(size_t, size_t count) override
+    {
+        ++bulkChanges;
+        itemCount += count;
+    }
+};
+
+/**
+ * Counts the structure changes a controller reports.
+ */
+class StructureCounter : public IStructureListener
+{
+public:
+    size_t insertCalls = 0;
+    size_t removeCalls = 0;
+    size_t itemsInsertedCount = 0;
+    size_t itemsRemovedCount = 0;
+
+    void itemsInserted(size_t, size_t count) override
+    {
+        ++insertCalls;
+        itemsInsertedCount += count;
+    }
+
+    void itemsRemoved(const std::vector<size_t>& itemIndices) override
+    {
+        ++removeCalls;
+        itemsRemovedCount += itemIndices.size();
+    }
+};
+
+TEST_F(InventoryDiffTests, IdenticalSetsProduceEmptyDiff)
+{
+    std::vector<TestDisplayItem> items = makeItems(50);
+
+    EXPECT_TRUE(Diff::compute(items, items).empty());
+    EXPECT_TRUE(Diff::compute(items, items, &pool).empty());
+}
+
+TEST_F(InventoryDiffTests, FindsAddedRemovedAndChanged)
+{
+    std::vector<TestDisplayItem> local = {{"Bolt", 5}, {"Nut", 3}, {"Screw", 7}, {"Washer", 1}};
+    std::vector<TestDisplayItem> upstream = {{"Washer", 1}, {"Anchor", 2}, {"Bolt", 6}, {"Screw", 7}};
+
+    Diff::Result diff = Diff::compute(local, upstream);
+
+    ASSERT_EQ(diff.added.size(), 1u);
+    EXPECT_EQ(diff.added[0].getKey(), "Anchor");
+    ASSERT_EQ(diff.removed.size(), 1u);
+    EXPECT_EQ(diff.removed[0], 1u);
+    ASSERT_EQ(diff.changed.size(), 1u);
+    EXPECT_EQ(diff.changed[0].first, 0u);
+    EXPECT_EQ(diff.changed[0].second, 6);
+}
+
+TEST_F(InventoryDiffTests, ParallelDiffMatchesSerialDiff)
+{
+    std::vector<TestDisplayItem> local = makeItems(20000);
+    std::vector<TestDisplayItem> upstream;
+    for (int i = 0; i < 20000; ++i)
+    {
+        if (i % 7 == 0)
+        {
+            continue;                                   // Removed upstream
+        }
+        upstream.emplace_back("Item" + std::to_string(i), i % 11 == 0 ? i + 1 : i);
+    }
+    for (int i = 0; i < 300; ++i)
+    {
+        upstream.emplace_back("New" + std::to_string(i), i);
+    }
+    std::shuffle(upstream.begin(), upstream.end(), std::mt19937(3));
+
+    Diff::Result serial = Diff::compute(local, upstream);
+    Diff::Result parallel = Diff::compute(local, upstream, &pool);
+
+    EXPECT_EQ(parallel.removed, serial.removed);
+    EXPECT_EQ(parallel.changed, serial.changed);
+    ASSERT_EQ(parallel.added.size(), serial.added.size());
+    EXPECT_EQ(parallel.added.size(), 300u);
+    EXPECT_EQ(parallel.removed.size(), 2858u);
+    EXPECT_TRUE(std::is_sorted(parallel.removed.begin(), parallel.removed.end()));
+}
+
+TEST_F(InventoryDiffTests, ApplyReconcilesControllerInOneFrame)
+{
+    std::vector<TestDisplayItem> local = {{"Bolt", 5}, {"Nut", 3}, {"Screw", 7}, {"Washer", 1}};
+    std::vector<TestDisplayItem> upstream = {{"Anchor", 2}, {"Bolt", 6}, {"Screw", 7}, {"Washer", 1}};
+    Controller controller(local, renderer, DisplayConfig(2, 16, '>', ':'));
+    controller.enableKeyIndex();
+    controller.navigateDown();
+    controller.navigateDown();                          // Select Screw
+    renderer->reset();
+
+    Diff::apply(controller, Diff::compute(controller.getItems(), upstream));
+
+    EXPECT_EQ(renderer->renderCallCount, 1);
+    ASSERT_EQ(controller.getItemCount(), 4u);
+    EXPECT_EQ(controller.getItems()[0].getValue(), 6);
+    EXPECT_EQ(controller.getItems()[3].getKey(), "Anchor");
+    EXPECT_EQ(controller.getCurrentKey(), "Screw");
+    EXPECT_EQ(controller.findItem("Nut"), IItemView::noItem);
+    EXPECT_EQ(controller.findItem("Anchor"), 3u);
+    EXPECT_TRUE(Diff::compute(controller.getItems(), upstream).empty());
+}
+
+TEST_F(InventoryDiffTests, ApplyMakesOneBulkPassPerChangeKind)
+{
+    std::vector<TestDisplayItem> upstream = makeItems(1000);
+    upstream.erase(upstream.begin() + 100, upstream.begin() + 400);
+    for (int i = 0; i < 200; ++i)
+    {
+        upstream.emplace_back("New" + std::to_string(i), i);
+    }
+    Controller controller(makeItems(1000), renderer, DisplayConfig(2, 16, '>', ':'));
+    auto view = std::make_shared<CountingView>(1000);
+    controller.setView(view);
+    renderer->reset();
+
+    Diff::apply(controller, Diff::compute(controller.getItems(), upstream));
+
+    EXPECT_EQ(view->singleChanges, 0u);
+    EXPECT_EQ(view->bulkChanges, 2u);
+    EXPECT_EQ(view->itemCount, 900u);
+    EXPECT_EQ(renderer->renderCallCount, 1);
+    EXPECT_TRUE(Diff::compute(controller.getItems(), upstream).empty());
+}
+
+TEST_F(InventoryDiffTests, LargeApplyChangesStructureInBulk)
+{
+    // Row-by-row removal and insertion is O(changes * n): apply must report one removal and
+    // one insertion to structure listeners, however many items change
+    const int itemCount = 200000;
+    std::vector<TestDisplayItem> upstream;
+    for (int i = 0; i < itemCount; ++i)
+    {
+        if (i % 10 != 3)
+        {
+            upstream.emplace_back("Item" + std::to_string(i), i % 13 == 0 ? i + 1 : i);
+        }
+    }
+    for (int i = 0; i < itemCount / 10; ++i)
+    {
+        upstream.emplace_back("New" + std::to_string(i), i);
+    }
+
+    Controller controller(makeItems(itemCount), renderer, DisplayConfig(2, 16, '>', ':'));
+    controller.enableKeyIndex();
+    controller.enableHistory(4);
+    controller.setValueFilter(9, ValueFilterConfig(10));
+    controller.markRange(0, 100);
+    controller.setView(std::make_shared<NaturalSortedView<TestDisplayItem>>(controller.getItems()));
+    controller.jumpToKey("Item9");
+    Diff::Result diff = Diff::compute(controller.getItems(), upstream, &pool);
+    StructureCounter counter;
+    controller.addStructureListener(&counter);
+    renderer->reset();
+
+    Diff::apply(controller, diff);
+    controller.removeStructureListener(&counter);
+
+    EXPECT_EQ(counter.removeCalls, 1u);
+    EXPECT_EQ(counter.itemsRemovedCount, static_cast<size_t>(itemCount / 10));
+    EXPECT_EQ(counter.insertCalls, 1u);
+    EXPECT_EQ(counter.itemsInsertedCount, static_cast<size_t>(itemCount / 10));
+    EXPECT_EQ(renderer->renderCallCount, 1);
+    ASSERT_EQ(controller.getItemCount(), upstream.size());
+    EXPECT_EQ(controller.getCurrentKey(), "Item9");
+    EXPECT_EQ(controller.findItem("Item9"), 8u);
+    EXPECT_EQ(controller.findItem("Item13"), IItemView::noItem);
+    size_t newItem = controller.findItem("New7");
+    ASSERT_LT(newItem, controller.getItemCount());
+    EXPECT_EQ(controller.getItems()[newItem].getKey(), "New7");
+    EXPECT_EQ(controller.getMarkedItems().count(), 90u);
+    EXPECT_EQ(controller.getHistory()->getItemCount(), upstream.size());
+    EXPECT_FALSE(controller.updateValue(8, 12));        // Item9's deadband filter moved with it
+    EXPECT_TRUE(Diff::compute(controller.getItems(), upstream, &pool).empty());
+}
+
+TEST_F(InventoryDiffTests, BulkChangesKeepViewsConsistent)
+{
+    DisplayConfig config(2, 16, '>', ':');
+
+    Controller sorted(makeItems(700), renderer, config);
+    sorted.setView(std::make_shared<NaturalSortedView<TestDisplayItem>>(sorted.getItems()));
+    applyBulkChanges(sorted);
+    expectSameRows(*sorted.getView(), NaturalSortedView<TestDisplayItem>(sorted.getItems()));
+
+    Controller queried(makeItems(700), renderer, config);
+    queried.setView(std::make_shared<QueryView<TestDisplayItem>>(queried.getItems(), ItemQuery("value < 30")));
+    applyBulkChanges(queried);
+    expectSameRows(*queried.getView(),
+                   QueryView<TestDisplayItem>(queried.getItems(), ItemQuery("value < 30")));
+
+    Controller searched(makeItems(700), renderer, config);
+    auto search = std::make_shared<KeySearchView<TestDisplayItem>>(searched.getItems());
+    search->setPattern("4");
+    search->step(300);                                  // Stop halfway: the scan resumes later
+    searched.setView(search);
+    applyBulkChanges(searched);
+    search->step(searched.getItemCount());
+    KeySearchView<TestDisplayItem> freshSearch(searched.getItems());
+    freshSearch.setPattern("4");
+    freshSearch.step(searched.getItemCount());
+    expectSameRows(*search, freshSearch);
+
+    Controller fuzzy(makeItems(700), renderer, config);
+    auto fuzzyView = std::make_shared<FuzzySearchView<TestDisplayItem>>(fuzzy.getItems());
+    fuzzyView->setQuery("Item51");
+    fuzzy.setView(fuzzyView);
+    applyBulkChanges(fuzzy);
+    fuzzyView->setQuery("Item52");
+    FuzzySearchView<TestDisplayItem> freshFuzzy(fuzzy.getItems());
+    freshFuzzy.setQuery("Item52");
+    expectSameRows(*fuzzyView, freshFuzzy);
+
+    Controller sectioned(makeItems(700), renderer, config);
+    auto sections = std::make_shared<SectionedView>(std::vector<SectionedView::Section>{
+        {"A", 300}, {"B", 0}, {"C", 400, true}});
+    sectioned.setView(sections);
+    applyBulkChanges(sectioned);
+    EXPECT_EQ(sections->getSection(0).itemCount, 257u);
+    EXPECT_EQ(sections->getSection(1).itemCount, 0u);
+    EXPECT_EQ(sections->getSection(2).itemCount, 343u + 50u);
+    EXPECT_EQ(sections->getRowCount(), 1u + 257u + 1u + 1u);
+    EXPECT_EQ(sections->getRowOfItem(256), 257u);
+}
+
+TEST_F(InventoryDiffTests, SetValuesSkipsUnchangedItems)
+{
+    Controller controller(makeItems(5), renderer, DisplayConfig(2, 16, '>', ':'));
+    renderer->reset();
+
+    EXPECT_EQ(controller.setValues({{0, 0}, {1, 10}, {4, 40}}), 2u);
+    EXPECT_EQ(renderer->renderCallCount, 1);
+    EXPECT_EQ(controller.getItems()[4].getValue(), 40);
+    EXPECT_EQ(controller.setValues({{1, 10}}), 0u);
+    EXPECT_EQ(renderer->renderCallCount, 1);
+    EXPECT_THROW(controller.setValues({{9, 1}}), std::out_of_range);
+}
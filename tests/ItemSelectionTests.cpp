@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "ItemSelection.h"
+#include "LCDDisplayController.h"
+#include "LCDInventoryController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+using Inventory = LCDInventoryController<TestDisplayItem>;
+
+class ItemSelectionTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> renderer = std::make_shared<MockRenderer>();
+
+    static std::vector<TestDisplayItem> makeItems(int count)
+    {
+        std::vector<TestDisplayItem> items;
+        for (int i = 0; i < count; ++i)
+        {
+            items.emplace_back("Item" + std::to_string(i), i);
+        }
+        return items;
+    }
+
+    static std::vector<size_t> selectedItems(const ItemSelection& selection)
+    {
+        std::vector<size_t> result;
+        selection.forEach([&](size_t itemIndex) { result.push_back(itemIndex); });
+        return result;
+    }
+};
+
+TEST_F(ItemSelectionTests, RangesSpanWordBoundaries)
+{
+    ItemSelection selection(300);
+    selection.setRange(60, 200);
+    EXPECT_EQ(selection.count(), 140u);
+    EXPECT_FALSE(selection.test(59));
+    EXPECT_TRUE(selection.test(60));
+    EXPECT_TRUE(selection.test(199));
+    EXPECT_FALSE(selection.test(200));
+
+    selection.setRange(100, 130, false);
+    selection.setRange(190, 210);
+    EXPECT_EQ(selection.count(), 120u);
+    selection.toggle(100);
+    EXPECT_EQ(selection.count(), 121u);
+    EXPECT_THROW(selection.setRange(10, 301), std::out_of_range);
+    EXPECT_THROW(selection.set(300), std::out_of_range);
+    EXPECT_FALSE(selection.test(300));
+
+    selection.clear();
+    EXPECT_TRUE(selection.empty());
+}
+
+TEST_F(ItemSelectionTests, ForEachVisitsItemsInOrder)
+{
+    ItemSelection selection(200);
+    selection.set(130);
+    selection.set(0);
+    selection.set(63);
+    selection.set(64);
+    selection.set(199);
+    EXPECT_EQ(selectedItems(selection), (std::vector<size_t>{0, 63, 64, 130, 199}));
+}
+
+TEST_F(ItemSelectionTests, InsertAndRemoveShiftSelection)
+{
+    ItemSelection selection(130);
+    selection.set(10);
+    selection.set(63);
+    selection.set(129);
+
+    selection.insertItem(5);
+    EXPECT_EQ(selection.size(), 131u);
+    EXPECT_EQ(selectedItems(selection), (std::vector<size_t>{11, 64, 130}));
+
+    selection.removeItem(64);
+    selection.removeItem(0);
+    EXPECT_EQ(selection.size(), 129u);
+    EXPECT_EQ(selection.count(), 2u);
+    EXPECT_EQ(selectedItems(selection), (std::vector<size_t>{10, 128}));
+}
+
+TEST_F(ItemSelectionTests, MarkedRowsShowMarkGlyph)
+{
+    Controller controller(makeItems(4), renderer, DisplayConfig(2, 16, '>', ':'));
+    controller.markItem(0);
+    controller.markItem(1);
+    EXPECT_EQ(renderer->getLine(0)[0], '>');
+    EXPECT_EQ(renderer->getLine(1)[0], '*');
+
+    controller.setMarkChar('+');
+    EXPECT_EQ(renderer->getLine(1)[0], '+');
+    controller.markItem(1, false);
+    EXPECT_EQ(renderer->getLine(1)[0], ' ');
+}
+
+TEST_F(ItemSelectionTests, MarksFollowInsertAndRemove)
+{
+    Controller controller(makeItems(4), renderer, DisplayConfig(2, 16, '>', ':'));
+    controller.markItem(2);
+    controller.insertItem(0, TestDisplayItem("First", 9));
+    EXPECT_TRUE(controller.getMarkedItems().test(3));
+    controller.removeItem(3);
+    EXPECT_TRUE(controller.getMarkedItems().empty());
+}
+
+TEST_F(ItemSelectionTests, BulkIncrementProducesOneFrame)
+{
+    Inventory inventory(makeItems(100000), renderer, DisplayConfig(2, 16, '>', ':'));
+    inventory.markRange(0, 100000);
+    renderer->reset();
+
+    EXPECT_EQ(inventory.incrementMarked(), 100000u);
+    EXPECT_EQ(renderer->renderCallCount, 1);
+    const auto& items = inventory.getDisplayController().getItems();
+    EXPECT_EQ(items[0].getValue(), 1);
+    EXPECT_EQ(items[99999].getValue(), 100000);
+
+    inventory.clearMarks();
+    inventory.markRange(10, 20);
+    EXPECT_EQ(inventory.getMarkedItems().count(), 10u);
+    renderer->reset();
+    EXPECT_EQ(inventory.zeroMarked(), 10u);
+    EXPECT_EQ(renderer->renderCallCount, 0);            // No marked item on screen
+    EXPECT_EQ(items[15].getValue(), 0);
+    EXPECT_EQ(inventory.zeroMarked(), 0u);
+}
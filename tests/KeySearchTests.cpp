@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "FixedWidthKeyScanner.h"
+#include "KeySearchView.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+using TestSearchView = KeySearchView<TestDisplayItem>;
+
+class KeySearchTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> renderer = std::make_shared<MockRenderer>();
+
+    static std::vector<TestDisplayItem> makeItems()
+    {
+        return {{"RED-BOLT", 1}, {"BLUE-NUT", 2}, {"BLUEBELL", 3}, {"GREEN", 4},
+                {"NAVY-BLUE", 5}, {"BLU", 6}};
+    }
+};
+
+TEST_F(KeySearchTests, ScanMatchesScalarFind)
+{
+    std::mt19937 random(5);
+    std::vector<std::string> keys;
+    FixedWidthKeyScanner scanner(8);
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string key;
+        size_t length = random() % 20;
+        for (size_t c = 0; c < length; ++c)
+        {
+            key += static_cast<char>('A' + random() % 4);
+        }
+        keys.push_back(key);
+        scanner.append(key);
+    }
+
+    for (const char* pattern : {"A", "AB", "ABC", "DDAA", "ABCDABCD", "CCCCCCCCCCCCCCCCCC"})
+    {
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            if (keys[i].find(pattern) != std::string::npos)
+            {
+                expected.push_back(i);
+            }
+        }
+        std::vector<size_t> found;
+        scanner.scan(pattern, 0, keys.size(), found);
+        EXPECT_EQ(found, expected) << pattern;
+    }
+}
+
+TEST_F(KeySearchTests, HitsDoNotSpanSlots)
+{
+    FixedWidthKeyScanner scanner(4);
+    scanner.append("ABCD");
+    scanner.append("EFGH");
+    scanner.append("XX");
+
+    std::vector<size_t> found;
+    EXPECT_EQ(scanner.scan("DE", 0, 3, found), 0u);
+    EXPECT_EQ(scanner.scan("X", 0, 3, found), 1u);
+    EXPECT_EQ(found.back(), 2u);
+    EXPECT_EQ(scanner.scan("ABCDE", 0, 3, found), 0u);
+}
+
+TEST_F(KeySearchTests, StrideGrowsForLongKeys)
+{
+    FixedWidthKeyScanner scanner(4);
+    scanner.append("AB");
+    scanner.append("A-VERY-LONG-KEY");
+    scanner.insert(1, "MIDDLE");
+
+    EXPECT_GE(scanner.getStride(), 15u);
+    EXPECT_EQ(scanner.getKey(0), "AB");
+    EXPECT_EQ(scanner.getKey(1), "MIDDLE");
+    EXPECT_EQ(scanner.getKey(2), "A-VERY-LONG-KEY");
+
+    scanner.remove(0);
+    std::vector<size_t> found;
+    scanner.scan("LONG", 0, scanner.getKeyCount(), found);
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0], 1u);
+    EXPECT_THROW(scanner.append(std::string("A\0B", 3)), std::invalid_argument);
+}
+
+TEST_F(KeySearchTests, SearchStreamsInSteps)
+{
+    std::vector<TestDisplayItem> items = makeItems();
+    TestSearchView view(items);
+    EXPECT_EQ(view.getRowCount(), 6u);
+
+    EXPECT_TRUE(view.setPattern("BLUE"));
+    EXPECT_EQ(view.getRowCount(), 0u);
+    EXPECT_FALSE(view.isComplete());
+
+    EXPECT_TRUE(view.step(3));
+    EXPECT_EQ(view.getRowCount(), 2u);
+    EXPECT_TRUE(view.step(3));
+    EXPECT_TRUE(view.isComplete());
+    EXPECT_EQ(view.getRowCount(), 3u);
+    EXPECT_EQ(view.getItemAtRow(2), 4u);
+    EXPECT_EQ(view.getRowOfItem(2), 1u);
+    EXPECT_EQ(view.getRowOfItem(3), IItemView::noItem);
+}
+
+TEST_F(KeySearchTests, TypingMoreNarrowsWithoutRescanning)
+{
+    std::vector<TestDisplayItem> items = makeItems();
+    TestSearchView view(items);
+    view.setPattern("BLU");
+    view.step(3);                                       // Stale: only half scanned
+
+    EXPECT_FALSE(view.setPattern("BLUE"));              // BLUE-NUT and BLUEBELL still match
+    EXPECT_EQ(view.getRowCount(), 2u);
+    EXPECT_FALSE(view.isComplete());
+    view.step(100);
+    EXPECT_EQ(view.getRowCount(), 3u);
+
+    view.setPattern("NUT");                             // Not a narrowing: starts over
+    EXPECT_EQ(view.getRowCount(), 0u);
+    view.step(100);
+    EXPECT_EQ(view.getRowCount(), 1u);
+}
+
+TEST_F(KeySearchTests, ControllerShowsMatchesAndFollowsEdits)
+{
+    Controller controller(makeItems(), renderer, DisplayConfig(2, 16, '>', ':'));
+    auto view = std::make_shared<TestSearchView>(controller.getItems());
+    controller.setView(view);
+
+    view->setPattern("BLUE");
+    if (view->step(1000))
+    {
+        controller.refreshView();
+    }
+    EXPECT_EQ(controller.getCurrentKey(), "BLUE-NUT");
+
+    controller.insertItem(0, TestDisplayItem("SKY-BLUE", 7));
+    EXPECT_EQ(view->getRowCount(), 4u);
+    EXPECT_EQ(view->getItemAtRow(0), 0u);
+    EXPECT_EQ(controller.getCurrentKey(), "BLUE-NUT");
+
+    controller.removeItem(2);                           // BLUE-NUT
+    EXPECT_EQ(view->getRowCount(), 3u);
+    EXPECT_EQ(view->getItemAtRow(1), 2u);
+    EXPECT_EQ(controller.getItems()[view->getItemAtRow(1)].getKey(), "BLUEBELL");
+}
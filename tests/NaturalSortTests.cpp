@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "NaturalSortKey.h"
+#include "NaturalSortedView.h"
+#include "WorkerPool.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+using TestSortedView = NaturalSortedView<TestDisplayItem>;
+
+class NaturalSortTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> renderer = std::make_shared<MockRenderer>();
+
+    static bool keyLess(const std::string& a, const std::string& b)
+    {
+        return makeNaturalSortKey(a) < makeNaturalSortKey(b);
+    }
+};
+
+TEST_F(NaturalSortTests, NumbersCompareByValue)
+{
+    EXPECT_TRUE(keyLess("Item2", "Item10"));
+    EXPECT_TRUE(keyLess("Item9", "Item10"));
+    EXPECT_TRUE(keyLess("Item10", "Item10a"));
+    EXPECT_TRUE(keyLess("Item", "Item1"));
+    EXPECT_TRUE(keyLess("Item1", "ItemA"));
+    EXPECT_TRUE(keyLess("a2b3", "a2b10"));
+    EXPECT_TRUE(keyLess("v1.9", "v1.10"));
+    EXPECT_TRUE(keyLess(std::string(300, '9'), "1" + std::string(300, '0')));
+    EXPECT_TRUE(keyLess(std::string(20, '9'), std::string(300, '1')));
+}
+
+TEST_F(NaturalSortTests, CaseAndLeadingZerosOnlyBreakTies)
+{
+    EXPECT_TRUE(keyLess("apple", "Banana"));
+    EXPECT_TRUE(keyLess("Item007", "Item8"));
+    EXPECT_TRUE(keyLess("ITEM2", "item2"));
+    EXPECT_TRUE(keyLess("Item02", "Item2"));
+    EXPECT_NE(makeNaturalSortKey("ITEM2"), makeNaturalSortKey("item2"));
+    EXPECT_EQ(naturalCompare("Item5", "Item5"), 0);
+}
+
+TEST_F(NaturalSortTests, SortKeysAgreeWithComparator)
+{
+    std::mt19937 random(9);
+    const char alphabet[] = "aAbB0012 9-";
+    std::vector<std::string> keys;
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string key;
+        size_t length = random() % 8;
+        for (size_t c = 0; c < length; ++c)
+        {
+            key += alphabet[random() % (sizeof(alphabet) - 1)];
+        }
+        keys.push_back(key);
+    }
+
+    for (size_t i = 0; i + 1 < keys.size(); ++i)
+    {
+        int byKey = makeNaturalSortKey(keys[i]).compare(makeNaturalSortKey(keys[i + 1]));
+        int byComparator = naturalCompare(keys[i], keys[i + 1]);
+        ASSERT_EQ(byKey < 0, byComparator < 0) << keys[i] << " vs " << keys[i + 1];
+        ASSERT_EQ(byKey == 0, byComparator == 0) << keys[i] << " vs " << keys[i + 1];
+    }
+}
+
+TEST_F(NaturalSortTests, ViewSortsItemsNaturally)
+{
+    std::vector<TestDisplayItem> items;
+    for (int i = 12; i > 0; --i)
+    {
+        items.emplace_back("Item" + std::to_string(i), i);
+    }
+    WorkerPool pool(2);
+    Controller controller(items, renderer, DisplayConfig(2, 16, '>', ':'));
+    auto view = std::make_shared<TestSortedView>(controller.getItems(), &pool);
+    controller.setView(view);
+
+    controller.navigateToFirst();
+    EXPECT_EQ(controller.getCurrentKey(), "Item1");
+    controller.navigateDown();
+    EXPECT_EQ(controller.getCurrentKey(), "Item2");
+    controller.navigateToLast();
+    EXPECT_EQ(controller.getCurrentKey(), "Item12");
+    EXPECT_EQ(view->getRowOfItem(0), 11u);
+}
+
+TEST_F(NaturalSortTests, ViewPlacesInsertedItems)
+{
+    std::vector<TestDisplayItem> items = {{"Item10", 1}, {"Item1", 2}, {"Item3", 3}};
+    Controller controller(items, renderer, DisplayConfig(2, 16, '>', ':'));
+    auto view = std::make_shared<TestSortedView>(controller.getItems());
+    controller.setView(view);
+
+    controller.insertItem(0, TestDisplayItem("Item2", 4));
+    EXPECT_EQ(view->getItemAtRow(1), 0u);               // Item1, Item2, Item3, Item10
+    EXPECT_EQ(view->getItemAtRow(3), 1u);
+
+    controller.removeItem(2);                           // Item1
+    EXPECT_EQ(view->getRowCount(), 3u);
+    EXPECT_EQ(view->getItemAtRow(0), 0u);
+    EXPECT_EQ(controller.getItems()[view->getItemAtRow(2)].getKey(), "Item10");
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "PackedValueArray.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+
+class PackedValueArrayTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+    }
+};
+
+TEST_F(PackedValueArrayTests, RangeSelectsBitWidth)
+{
+    EXPECT_EQ(packedBitsFor(1), 1u);
+    EXPECT_EQ(packedBitsFor(3), 2u);
+    EXPECT_EQ(packedBitsFor(15), 4u);
+    EXPECT_EQ(packedBitsFor(16), 5u);
+    EXPECT_EQ(PackedRangeArray<15>::maxValue, 15u);
+}
+
+TEST_F(PackedValueArrayTests, TenMillionFlagsFitInAboutOneMegabyte)
+{
+    PackedValueArray<1> flags(10000000);
+
+    EXPECT_EQ(flags.getByteSize(), 1250000u);
+    flags.set(9999999, 1);
+    EXPECT_EQ(flags.get(9999999), 1u);
+    EXPECT_EQ(flags.get(9999998), 0u);
+}
+
+TEST_F(PackedValueArrayTests, SetAndGetDoNotDisturbNeighbours)
+{
+    PackedValueArray<4> counts(40);
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        counts.set(i, i % 16);
+    }
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        EXPECT_EQ(counts.get(i), i % 16);
+    }
+    EXPECT_THROW(counts.set(0, 16), std::out_of_range);
+    EXPECT_THROW(counts.get(40), std::out_of_range);
+}
+
+TEST_F(PackedValueArrayTests, IncrementAndDecrementSaturate)
+{
+    PackedValueArray<2> values(3);
+
+    EXPECT_EQ(values.decrement(1), 0u);
+    values.set(1, 2);
+    EXPECT_EQ(values.increment(1), 3u);
+    EXPECT_EQ(values.increment(1), 3u);
+    EXPECT_FALSE(values.compareExchange(1, 2, 0));
+    EXPECT_TRUE(values.compareExchange(1, 3, 1));
+    EXPECT_EQ(values.get(1), 1u);
+}
+
+TEST_F(PackedValueArrayTests, UnpackHandlesPartialWords)
+{
+    // 5 bits: 12 values per word, 4 bits unused per word
+    PackedValueArray<5> values(50);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values.set(i, (i * 7) % 32);
+    }
+
+    std::vector<int> out(37);
+    values.unpack(5, out.size(), out.data());
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        EXPECT_EQ(out[i], static_cast<int>(((i + 5) * 7) % 32));
+    }
+    EXPECT_THROW(values.unpack(40, 11, out.data()), std::out_of_range);
+}
+
+TEST_F(PackedValueArrayTests, ConcurrentWritersToSharedWordsLoseNoUpdates)
+{
+    // Every value of one word is incremented by a different thread
+    PackedValueArray<8> counters(8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&counters, t]()
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                counters.increment(t);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < 8; ++t)
+    {
+        EXPECT_EQ(counters.get(t), 200u);
+    }
+}
+
+TEST_F(PackedValueArrayTests, UnpackedWindowFeedsControllerInOneFrame)
+{
+    PackedRangeArray<15> counts(1000);
+    counts.set(0, 7);
+    counts.set(1, 15);
+
+    std::vector<TestDisplayItem> items;
+    items.emplace_back("Bolt", 0);
+    items.emplace_back("Nut", 0);
+    Controller controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':'));
+    mockRenderer->reset();
+
+    int window[2];
+    counts.unpack(0, 2, window);
+    controller.applyUpdates({{0, window[0]}, {1, window[1]}});
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(mockRenderer->getLine(1), " Nut       :15  ");
+}
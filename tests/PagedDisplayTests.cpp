@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "PagedDisplay.h"
+#include "LCDDisplayController.h"
+#include "LCDInventoryController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <vector>
+
+// Pages may hold different item types
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using AlertItem = DisplayItem<std::string, std::string, 8, 6>;
+
+class PagedDisplayTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    DisplayConfig config;
+    std::shared_ptr<LCDInventoryController<TestDisplayItem>> inventoryPage;
+    std::shared_ptr<LCDDisplayController<AlertItem>> alertPage;
+    PagedDisplay display;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+        config = DisplayConfig(2, 16, '>', ':');
+
+        std::vector<TestDisplayItem> items;
+        items.emplace_back("Bolts", 5);
+        items.emplace_back("Nuts", 7);
+        inventoryPage = std::make_shared<LCDInventoryController<TestDisplayItem>>(items, mockRenderer, config);
+
+        std::vector<AlertItem> alerts;
+        alerts.emplace_back("Temp", "HIGH");
+        alertPage = std::make_shared<LCDDisplayController<AlertItem>>(alerts, mockRenderer, config);
+
+        display.addPage(inventoryPage);
+        display.addPage(alertPage);
+        inventoryPage->render();
+        mockRenderer->reset();
+    }
+};
+
+TEST_F(PagedDisplayTests, FirstPageIsActiveAndOthersHidden)
+{
+    EXPECT_EQ(display.getPageCount(), 2);
+    EXPECT_EQ(display.getActivePageIndex(), 0);
+    EXPECT_TRUE(inventoryPage->isVisible());
+    EXPECT_FALSE(alertPage->isVisible());
+}
+
+TEST_F(PagedDisplayTests, InactivePageMutationsDoNotRender)
+{
+    alertPage->setCurrentValue(std::string("LOW"));
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 0);
+    EXPECT_TRUE(alertPage->isDirty());
+}
+
+TEST_F(PagedDisplayTests, PageSwitchCostsExactlyOneFrame)
+{
+    EXPECT_TRUE(display.nextPage());
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(mockRenderer->getLine(0).substr(1, 4), "Temp");
+    EXPECT_FALSE(inventoryPage->isVisible());
+}
+
+TEST_F(PagedDisplayTests, SwitchingBackRepaintsUnchangedPage)
+{
+    display.nextPage();
+    mockRenderer->reset();
+
+    display.previousPage();
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(mockRenderer->getLine(0).substr(1, 5), "Bolts");
+}
+
+TEST_F(PagedDisplayTests, PagesCycleWithWrapAround)
+{
+    display.nextPage();
+    display.nextPage();
+
+    EXPECT_EQ(display.getActivePageIndex(), 0);
+
+    display.previousPage();
+    EXPECT_EQ(display.getActivePageIndex(), 1);
+}
+
+TEST_F(PagedDisplayTests, ShowingActivePageDoesNothing)
+{
+    EXPECT_FALSE(display.showPage(0));
+    EXPECT_EQ(mockRenderer->renderCallCount, 0);
+}
+
+TEST_F(PagedDisplayTests, HiddenDisplaySwitchesPagesWithoutRendering)
+{
+    display.setVisible(false);
+    display.nextPage();
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 0);
+
+    display.setVisible(true);
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_TRUE(alertPage->isVisible());
+}
+
+TEST_F(PagedDisplayTests, InvalidArgumentsThrow)
+{
+    EXPECT_THROW(display.addPage(nullptr), std::invalid_argument);
+    EXPECT_THROW(display.showPage(5), std::out_of_range);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "ParallelAlgorithms.h"
+#include "ConcurrentKeyIndex.h"
+#include "WorkerPool.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+
+class ParallelBuildTests : public ::testing::Test
+{
+protected:
+    WorkerPool pool{4};
+};
+
+TEST_F(ParallelBuildTests, SplitRangeCoversEverything)
+{
+    std::vector<size_t> bounds = splitRange(10, 4);
+
+    ASSERT_EQ(bounds.size(), 5u);
+    EXPECT_EQ(bounds.front(), 0u);
+    EXPECT_EQ(bounds.back(), 10u);
+    EXPECT_EQ(splitRange(2, 8).size(), 3u);
+}
+
+TEST_F(ParallelBuildTests, ParallelSortMatchesSerialSort)
+{
+    std::mt19937 random(7);
+    std::vector<uint32_t> values(100000);
+    for (auto& value : values)
+    {
+        value = random();
+    }
+    std::vector<uint32_t> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    parallelSort(pool, values.begin(), values.end(), std::less<uint32_t>(), 1000);
+    EXPECT_EQ(values, expected);
+}
+
+TEST_F(ParallelBuildTests, ParallelSortWithOddPieceCount)
+{
+    WorkerPool threePool(2);
+    std::vector<int> values;
+    for (int i = 30000; i > 0; --i)
+    {
+        values.push_back(i);
+    }
+
+    parallelSort(threePool, values.begin(), values.end(), std::less<int>(), 100);
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+    EXPECT_EQ(values.front(), 1);
+}
+
+TEST_F(ParallelBuildTests, ParallelReduceSumsInPieces)
+{
+    std::vector<int> values(50000, 3);
+    int64_t total = parallelReduce<int64_t>(pool, values.size(), 0,
+        [&](size_t begin, size_t end)
+        {
+            int64_t sum = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                sum += values[i];
+            }
+            return sum;
+        },
+        [](int64_t a, int64_t b) { return a + b; }, 1000);
+
+    EXPECT_EQ(total, 150000);
+}
+
+TEST_F(ParallelBuildTests, ChunkedIndexBuildFindsEveryKey)
+{
+    ConcurrentKeyIndex<std::string> index;
+    index.insert("existing", 99);
+    index.build(20000, [](size_t i) { return "KEY-" + std::to_string(i); }, pool);
+
+    EXPECT_EQ(index.size(), 20001u);
+    for (size_t i = 0; i < 20000; i += 997)
+    {
+        EXPECT_EQ(index.find("KEY-" + std::to_string(i)), i);
+    }
+    EXPECT_EQ(index.find("existing"), 99u);
+
+    // Incremental maintenance continues on the built index
+    EXPECT_TRUE(index.remove("KEY-5"));
+    EXPECT_TRUE(index.insert("KEY-20000", 20000));
+    EXPECT_EQ(index.find("KEY-20000"), 20000u);
+}
+
+TEST_F(ParallelBuildTests, ControllerBuildsKeyIndexOnPool)
+{
+    std::vector<TestDisplayItem> items;
+    for (int i = 0; i < 1000; ++i)
+    {
+        items.emplace_back("Item" + std::to_string(i), i);
+    }
+    Controller controller(items, std::make_shared<MockRenderer>(), DisplayConfig(2, 16, '>', ':'));
+
+    controller.enableKeyIndex(&pool);
+    EXPECT_EQ(controller.findItem("Item777"), 777u);
+    controller.removeItem(0);
+    EXPECT_EQ(controller.findItem("Item777"), 776u);
+}
@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include "PeriodicSampler.h"
+#include "WorkerPool.h"
+#include "FileValueSource.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+using Sampler = PeriodicSampler<TestDisplayItem>;
+using std::chrono::milliseconds;
+
+class PeriodicSamplerTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::unique_ptr<Controller> controller;
+    Controller::Clock::time_point start;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+        std::vector<TestDisplayItem> items;
+        for (int i = 0; i < 8; ++i)
+        {
+            items.emplace_back("Sensor" + std::to_string(i), 0);
+        }
+        controller.reset(new Controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':')));
+        start = Controller::Clock::now();
+    }
+};
+
+TEST_F(PeriodicSamplerTests, BatchCoalescesRendersIntoOneFrame)
+{
+    {
+        Controller::BatchScope batch(*controller);
+        controller->setCurrentValue(1);
+        controller->navigateDown();
+        controller->setCurrentValue(2);
+        EXPECT_EQ(mockRenderer->renderCallCount, 0);
+    }
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+}
+
+TEST_F(PeriodicSamplerTests, FailedBulkUpdateDoesNotRenderHalfAppliedBatch)
+{
+    std::vector<Controller::ValueUpdate> updates = {{0, 5}, {99, 6}};
+
+    EXPECT_THROW(controller->setValues(updates), std::out_of_range);
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 0);
+    EXPECT_TRUE(controller->isDirty());
+    controller->setCurrentValue(7);                     // Batch was closed: renders again
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+}
+
+TEST_F(PeriodicSamplerTests, RendererErrorAtBatchEndDoesNotEscape)
+{
+    class FailingRenderer : public MockRenderer
+    {
+    public:
+        void render(const std::vector<std::string>&, size_t) override
+        {
+            throw std::runtime_error("Display unplugged");
+        }
+    };
+    Controller failing({TestDisplayItem("Sensor", 0)}, std::make_shared<FailingRenderer>(),
+                       DisplayConfig(2, 16, '>', ':'));
+
+    {
+        Controller::BatchScope batch(failing);
+        failing.setCurrentValue(3);
+    }
+
+    EXPECT_TRUE(failing.isDirty());
+}
+
+TEST_F(PeriodicSamplerTests, ApplyUpdatesRendersOnceForManyChanges)
+{
+    std::vector<Controller::ValueUpdate> updates = {{0, 5}, {1, 6}, {5, 7}};
+
+    EXPECT_EQ(controller->applyUpdates(updates), 3);
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(controller->getItems()[5].getValue(), 7);
+}
+
+TEST_F(PeriodicSamplerTests, ApplyUpdatesWithoutChangesDoesNotRender)
+{
+    std::vector<Controller::ValueUpdate> updates = {{0, 0}, {1, 0}};
+
+    EXPECT_EQ(controller->applyUpdates(updates), 0);
+    EXPECT_EQ(mockRenderer->renderCallCount, 0);
+}
+
+TEST_F(PeriodicSamplerTests, SourcesWithSamePeriodShareAGroup)
+{
+    Sampler sampler(*controller);
+    sampler.addSource(0, milliseconds(100), [] { return 1; });
+    sampler.addSource(1, milliseconds(100), [] { return 2; });
+    sampler.addSource(2, milliseconds(250), [] { return 3; });
+
+    EXPECT_EQ(sampler.getGroupCount(), 2);
+    EXPECT_EQ(sampler.getSourceCount(), 3);
+    EXPECT_EQ(sampler.getTickInterval(), milliseconds(50));
+}
+
+TEST_F(PeriodicSamplerTests, TickAppliesDueSourcesAsOneFrame)
+{
+    Sampler sampler(*controller);
+    sampler.addSource(0, milliseconds(100), [] { return 11; });
+    sampler.addSource(1, milliseconds(100), [] { return 22; });
+
+    EXPECT_EQ(sampler.tick(start + milliseconds(1000)), 2);
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(controller->getItems()[1].getValue(), 22);
+
+    // Not due again until one period after the last tick
+    EXPECT_EQ(sampler.tick(start + milliseconds(1050)), 0);
+    EXPECT_EQ(sampler.tick(start + milliseconds(1100)), 2);
+}
+
+TEST_F(PeriodicSamplerTests, SourcesFollowInsertedAndRemovedItems)
+{
+    Sampler sampler(*controller);
+    Sampler::SourceOptions always(false, 1);
+    sampler.addSource(2, milliseconds(100), [] { return 22; }, always);
+    sampler.addSource(5, milliseconds(100), [] { return 55; }, always);
+    sampler.addSource(7, milliseconds(100), [] { return 77; }, always);
+
+    controller->removeItem(3);
+    controller->removeItem(6);                          // Sensor7: its source is dropped
+    controller->insertItem(0, TestDisplayItem("Fan", 0));
+
+    EXPECT_EQ(sampler.getSourceCount(), 2);
+    EXPECT_EQ(sampler.tick(start + milliseconds(1000)), 2);
+    EXPECT_EQ(controller->getItems()[3].getKey(), "Sensor2");
+    EXPECT_EQ(controller->getItems()[3].getValue(), 22);
+    EXPECT_EQ(controller->getItems()[5].getKey(), "Sensor5");
+    EXPECT_EQ(controller->getItems()[5].getValue(), 55);
+    EXPECT_EQ(controller->getItems()[0].getValue(), 0);
+}
+
+TEST_F(PeriodicSamplerTests, HiddenRowsAreSampledLessOften)
+{
+    Sampler sampler(*controller);
+    int visibleReads = 0;
+    int hiddenReads = 0;
+    sampler.addSource(0, milliseconds(10), [&] { return ++visibleReads; }, Sampler::SourceOptions(false, 4));
+    sampler.addSource(7, milliseconds(10), [&] { return ++hiddenReads; }, Sampler::SourceOptions(false, 4));
+
+    for (int i = 1; i <= 8; ++i)
+    {
+        sampler.tick(start + milliseconds(10 * i));
+    }
+
+    EXPECT_EQ(visibleReads, 8);
+    EXPECT_EQ(hiddenReads, 2);
+}
+
+TEST_F(PeriodicSamplerTests, SlowSourcesAreReadOnWorkerPool)
+{
+    auto pool = std::make_shared<WorkerPool>(2);
+    Sampler sampler(*controller, pool);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        sampler.addSource(i, milliseconds(10), [i] { return static_cast<int>(i) + 100; },
+                          Sampler::SourceOptions(true, 1));
+    }
+
+    EXPECT_EQ(sampler.tick(start + milliseconds(10)), 4);
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(controller->getItems()[3].getValue(), 103);
+}
+
+TEST_F(PeriodicSamplerTests, FailingSourceKeepsLastValue)
+{
+    Sampler sampler(*controller);
+    sampler.addSource(0, milliseconds(10), []() -> int { throw std::runtime_error("gone"); });
+
+    EXPECT_NO_THROW(sampler.tick(start + milliseconds(10)));
+    EXPECT_EQ(controller->getItems()[0].getValue(), 0);
+}
+
+TEST_F(PeriodicSamplerTests, InvalidSourcesThrow)
+{
+    Sampler sampler(*controller);
+
+    EXPECT_THROW(sampler.addSource(99, milliseconds(10), [] { return 1; }), std::out_of_range);
+    EXPECT_THROW(sampler.addSource(0, milliseconds(0), [] { return 1; }), std::invalid_argument);
+}
+
+TEST_F(PeriodicSamplerTests, WorkerPoolParallelForCoversRange)
+{
+    WorkerPool pool(3);
+    std::vector<int> hits(1000, 0);
+
+    pool.parallelFor(hits.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            ++hits[i];
+        }
+    });
+
+    for (int hit : hits)
+    {
+        EXPECT_EQ(hit, 1);
+    }
+}
+
+TEST_F(PeriodicSamplerTests, WorkerPoolRethrowsChunkErrors)
+{
+    WorkerPool pool(2);
+
+    EXPECT_THROW(pool.parallelFor(100, [](size_t begin, size_t) {
+        if (begin == 0)
+        {
+            throw std::runtime_error("chunk failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST_F(PeriodicSamplerTests, FileValueSourceRereadsFile)
+{
+    std::string path = ::testing::TempDir() + "sampler_value.txt";
+    std::ofstream(path) << "42000\n";
+    FileValueSource source(path);
+    source.setDivisor(1000.0);
+
+    EXPECT_DOUBLE_EQ(source.read(), 42.0);
+
+    std::ofstream(path) << "43500\n";
+    EXPECT_DOUBLE_EQ(source.read(), 43.5);
+    std::remove(path.c_str());
+}
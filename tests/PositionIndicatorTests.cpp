@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "PositionIndicator.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+
+class PositionIndicatorTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::unique_ptr<Controller> controller;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+
+        std::vector<TestDisplayItem> items;
+        for (int i = 0; i < 10; ++i)
+        {
+            items.emplace_back("Item" + std::to_string(i), i);
+        }
+        controller.reset(new Controller(items, mockRenderer, DisplayConfig(2, 17, '>', ':')));
+    }
+};
+
+TEST_F(PositionIndicatorTests, QuantizeSpansAllSubPositions)
+{
+    EXPECT_EQ(PositionIndicator::quantize(0, 10, 2, 8), 0);
+    EXPECT_EQ(PositionIndicator::quantize(9, 10, 2, 8), 15);
+    EXPECT_EQ(PositionIndicator::quantize(9, 10, 2, 1), 1);
+    EXPECT_EQ(PositionIndicator::quantize(1, 2, 2, 8), PositionIndicator::hidden);
+}
+
+TEST_F(PositionIndicatorTests, ThumbFollowsSelectionInLastColumn)
+{
+    controller->enablePositionIndicator();
+
+    EXPECT_EQ(mockRenderer->getLine(0), ">Item0     :0   #");
+    EXPECT_EQ(mockRenderer->getLine(1), " Item1     :1   |");
+
+    for (int i = 0; i < 9; ++i)
+    {
+        controller->navigateDown();
+    }
+    EXPECT_EQ(mockRenderer->getLine(0), " Item8     :8   |");
+    EXPECT_EQ(mockRenderer->getLine(1), ">Item9     :9   #");
+}
+
+TEST_F(PositionIndicatorTests, ColumnRebuiltOnlyWhenQuantizedPositionChanges)
+{
+    controller->enablePositionIndicator();
+    const PositionIndicator* indicator = controller->getPositionIndicator();
+    ASSERT_NE(indicator, nullptr);
+    size_t rebuilds = indicator->getRebuildCount();
+
+    // ASCII has 2 positions for 10 rows: only crossing the midpoint moves the thumb
+    for (int i = 0; i < 4; ++i)
+    {
+        controller->navigateDown();
+    }
+    EXPECT_EQ(indicator->getRebuildCount(), rebuilds);
+
+    controller->navigateDown();
+    EXPECT_EQ(indicator->getRebuildCount(), rebuilds + 1);
+}
+
+TEST_F(PositionIndicatorTests, CgramGlyphsUseSubRowPositions)
+{
+    controller->enablePositionIndicator(PositionGlyphs::cgram());
+    controller->navigateDown();
+
+    // Row 1 of 10 maps to sub-position 1 of the top cell
+    EXPECT_EQ(controller->getPositionIndicator()->getPosition(), 1);
+    EXPECT_EQ(mockRenderer->getLine(0).back(), '\x09');
+    EXPECT_EQ(PositionGlyphs::getCgramPattern(1, 1), 0x0E);
+    EXPECT_EQ(PositionGlyphs::getCgramPattern(1, 2), 0x00);
+}
+
+TEST_F(PositionIndicatorTests, HiddenWhenAllRowsFit)
+{
+    std::vector<TestDisplayItem> items;
+    items.emplace_back("Bolt", 1);
+    Controller small(items, mockRenderer, DisplayConfig(2, 17, '>', ':'));
+    small.enablePositionIndicator();
+
+    EXPECT_EQ(mockRenderer->getLine(0), ">Bolt      :1    ");
+}
+
+TEST_F(PositionIndicatorTests, RequiresSpareColumn)
+{
+    std::vector<TestDisplayItem> items;
+    items.emplace_back("Bolt", 1);
+    Controller full(items, mockRenderer, DisplayConfig(2, 16, '>', ':'));
+
+    EXPECT_THROW(full.enablePositionIndicator(), std::invalid_argument);
+}
+
+TEST_F(PositionIndicatorTests, CgramIsNotSharedWithSparkline)
+{
+    std::vector<TestDisplayItem> items;
+    items.emplace_back("Bolt", 1);
+    Controller indicatorFirst(items, mockRenderer, DisplayConfig(2, 20, '>', ':'));
+    indicatorFirst.enablePositionIndicator(PositionGlyphs::cgram());
+    EXPECT_THROW(indicatorFirst.enableHistory(8, 2, BarGlyphs::cgram()), std::invalid_argument);
+    EXPECT_EQ(indicatorFirst.getHistory(), nullptr);
+    EXPECT_NO_THROW(indicatorFirst.enableHistory(8, 2, BarGlyphs::ascii()));
+    EXPECT_NO_THROW(indicatorFirst.enableHistory(8, 0, BarGlyphs::cgram()));   // Not drawn
+
+    Controller sparklineFirst(items, mockRenderer, DisplayConfig(2, 20, '>', ':'));
+    sparklineFirst.enableHistory(8, 2, BarGlyphs::cgram());
+    EXPECT_THROW(sparklineFirst.enablePositionIndicator(PositionGlyphs::cgram()), std::invalid_argument);
+    EXPECT_EQ(sparklineFirst.getPositionIndicator(), nullptr);
+    EXPECT_NO_THROW(sparklineFirst.enablePositionIndicator(PositionGlyphs::ascii()));
+}
+
+TEST_F(PositionIndicatorTests, ViewportsWithoutSpareColumnSkipIndicator)
+{
+    auto wide = std::make_shared<MockRenderer>();
+    auto narrow = std::make_shared<MockRenderer>();
+    controller->addViewport(wide, DisplayConfig(4, 20, '>', ':'), 10, 4);
+    controller->addViewport(narrow, DisplayConfig(2, 16, '>', ':'), 10, 4);
+    controller->enablePositionIndicator();
+
+    EXPECT_EQ(wide->getLine(0).back(), '#');
+    EXPECT_EQ(wide->getLine(3).back(), '|');
+    EXPECT_EQ(narrow->getLine(0), ">Item0     :0   ");
+}
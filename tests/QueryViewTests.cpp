@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "ItemQuery.h"
+#include "QueryView.h"
+#include "WorkerPool.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+using TestQueryView = QueryView<TestDisplayItem>;
+
+class QueryViewTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> renderer = std::make_shared<MockRenderer>();
+
+    static std::vector<TestDisplayItem> makeItems()
+    {
+        return {{"BOLT-M4", 3}, {"NUT-M4", 12}, {"BOLT-M6", 8}, {"WASHER", 1},
+                {"BOLT-M8", 4}, {"SCREW", 0}};
+    }
+};
+
+TEST_F(QueryViewTests, ScalarMatchFollowsPrecedence)
+{
+    ItemQuery query("value < 5 AND key contains \"BOLT\" OR NOT (value != 0)");
+
+    EXPECT_TRUE(query.matches(3, "BOLT-M4"));
+    EXPECT_FALSE(query.matches(8, "BOLT-M6"));
+    EXPECT_TRUE(query.matches(0, "SCREW"));
+    EXPECT_FALSE(query.matches(1, "WASHER"));
+    EXPECT_TRUE(ItemQuery().matches(42, "anything"));
+    EXPECT_TRUE(ItemQuery("  ").matches(42, "anything"));
+    EXPECT_TRUE(ItemQuery("key startswith \"NUT\" and value >= 12").matches(12, "NUT-M4"));
+    EXPECT_TRUE(ItemQuery("KEY = \"WASHER\"").matches(1, "WASHER"));
+    EXPECT_TRUE(ItemQuery("value <= -1.5 or value == 7").matches(7, "X"));
+}
+
+TEST_F(QueryViewTests, SyntaxErrorsThrow)
+{
+    EXPECT_THROW(ItemQuery("value <"), std::invalid_argument);
+    EXPECT_THROW(ItemQuery("value contains \"A\""), std::invalid_argument);
+    EXPECT_THROW(ItemQuery("key < 5"), std::invalid_argument);
+    EXPECT_THROW(ItemQuery("key contains \"BOLT"), std::invalid_argument);
+    EXPECT_THROW(ItemQuery("(value < 5"), std::invalid_argument);
+    EXPECT_THROW(ItemQuery("value < 5 value > 1"), std::invalid_argument);
+    EXPECT_THROW(ItemQuery("price < 5"), std::invalid_argument);
+    EXPECT_THROW(ItemQuery("value ! 5"), std::invalid_argument);
+}
+
+TEST_F(QueryViewTests, TileKernelsMatchScalarEvaluation)
+{
+    std::mt19937 random(11);
+    std::vector<TestDisplayItem> items;
+    for (int i = 0; i < 20000; ++i)
+    {
+        int value = static_cast<int>(random() % 100);
+        items.emplace_back((i % 3 == 0 ? "BOLT" : "NUT") + std::to_string(i), value);
+    }
+    ItemQuery query("(value < 20 AND key contains \"BOLT\") OR NOT value < 95");
+    WorkerPool pool(4);
+
+    TestQueryView view(items, query, &pool);
+
+    size_t expected = 0;
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        bool match = query.matches(items[i].getValue(), items[i].getKeyText());
+        ASSERT_EQ(view.isMatch(i), match) << "item " << i;
+        if (match)
+        {
+            EXPECT_EQ(view.getItemAtRow(expected), i);
+            EXPECT_EQ(view.getRowOfItem(i), expected);
+            ++expected;
+        }
+    }
+    EXPECT_EQ(view.getRowCount(), expected);
+    EXPECT_EQ(view.getItemAtRow(expected), IItemView::noItem);
+}
+
+TEST_F(QueryViewTests, ContainsDoesNotMatchAcrossKeys)
+{
+    std::vector<TestDisplayItem> items = {{"AB", 1}, {"CD", 2}, {"", 3}, {"XBCX", 4}, {"BC", 5}};
+
+    TestQueryView view(items, ItemQuery("key contains \"BC\""));
+
+    EXPECT_EQ(view.getRowCount(), 2u);
+    EXPECT_EQ(view.getItemAtRow(0), 3u);
+    EXPECT_EQ(view.getItemAtRow(1), 4u);
+    EXPECT_EQ(TestQueryView(items, ItemQuery("key contains \"\"")).getRowCount(), 5u);
+}
+
+TEST_F(QueryViewTests, ControllerNavigatesMatchingItems)
+{
+    Controller controller(makeItems(), renderer, DisplayConfig(2, 16, '>', ':'));
+    controller.setView(std::make_shared<TestQueryView>(controller.getItems(),
+                                                       ItemQuery("value < 5 AND key contains \"BOLT\"")));
+
+    EXPECT_EQ(controller.getCurrentKey(), "BOLT-M4");
+    controller.navigateDown();
+    EXPECT_EQ(controller.getCurrentKey(), "BOLT-M8");
+    EXPECT_NE(renderer->getLine(1).find("BOLT-M8"), std::string::npos);
+}
+
+TEST_F(QueryViewTests, ValueChangesReevaluateIncrementally)
+{
+    Controller controller(makeItems(), renderer, DisplayConfig(2, 16, '>', ':'));
+    auto view = std::make_shared<TestQueryView>(controller.getItems(),
+                                                ItemQuery("value < 5 AND key contains \"BOLT\""));
+    controller.setView(view);
+    controller.navigateDown();                          // BOLT-M8
+
+    controller.updateValue(2, 2);                       // BOLT-M6 now matches
+    EXPECT_EQ(view->getRowCount(), 3u);
+    EXPECT_EQ(controller.getCurrentKey(), "BOLT-M8");
+    EXPECT_EQ(controller.getSelectedItemIndex(), 4u);
+
+    controller.setValues({{4, 9}});                     // Selected item drops out
+    EXPECT_EQ(view->getRowCount(), 2u);
+    EXPECT_EQ(controller.getCurrentKey(), "BOLT-M6");
+}
+
+TEST_F(QueryViewTests, FollowsInsertAndRemove)
+{
+    Controller controller(makeItems(), renderer, DisplayConfig(2, 16, '>', ':'));
+    auto view = std::make_shared<TestQueryView>(controller.getItems(), ItemQuery("value < 5"));
+    controller.setView(view);
+
+    controller.insertItem(1, TestDisplayItem("ANCHOR", 2));
+    EXPECT_EQ(view->getRowCount(), 5u);
+    EXPECT_EQ(view->getItemAtRow(1), 1u);
+    EXPECT_EQ(view->getItemAtRow(2), 4u);               // WASHER shifted up
+
+    controller.removeItem(0);
+    EXPECT_EQ(view->getRowCount(), 4u);
+    EXPECT_EQ(view->getItemAtRow(0), 0u);
+    EXPECT_EQ(controller.getItems()[view->getItemAtRow(3)].getKey(), "SCREW");
+}
+
+TEST_F(QueryViewTests, BitmapShiftsAcrossWordBoundaries)
+{
+    std::vector<TestDisplayItem> items;
+    for (int i = 0; i < 200; ++i)
+    {
+        items.emplace_back("K" + std::to_string(i), i % 2);
+    }
+    Controller controller(items, renderer, DisplayConfig(2, 16, '>', ':'));
+    auto view = std::make_shared<TestQueryView>(controller.getItems(), ItemQuery("value = 1"));
+    controller.setView(view);
+
+    controller.insertItem(10, TestDisplayItem("NEW", 1));
+    controller.removeItem(70);
+    controller.insertItem(controller.getItemCount(), TestDisplayItem("END", 1));
+    for (size_t i = 0; i < controller.getItemCount(); ++i)
+    {
+        ASSERT_EQ(view->isMatch(i), controller.getItems()[i].getValue() == 1) << "item " << i;
+    }
+    EXPECT_EQ(view->getRowCount(), view->getMatchCount());
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "ScanDecoder.h"
+#include "ScannerInputListener.h"
+#include "LCDInventoryController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include "SignalInterrupter.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDInventoryController<TestDisplayItem>;
+using Clock = ScanDecoder::Clock;
+using std::chrono::milliseconds;
+
+class ScannerInputTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::unique_ptr<Controller> controller;
+    Clock::time_point start;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+
+        std::vector<TestDisplayItem> items;
+        items.emplace_back("Bolt", 1);
+        items.emplace_back("Nut", 2);
+        items.emplace_back("4006381", 3);
+        controller.reset(new Controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':')));
+        controller->getDisplayController().enableKeyIndex();
+        start = Clock::now();
+    }
+
+    // Feed text with a fixed gap between characters; returns true if it completed a scan
+    bool type(ScanDecoder& decoder, const std::string& text, milliseconds gap)
+    {
+        bool scanned = false;
+        for (char c : text)
+        {
+            scanned = decoder.feed(c, start) || scanned;
+            start += gap;
+        }
+        return scanned;
+    }
+};
+
+TEST_F(ScannerInputTests, FastBurstEndingInEnterIsScan)
+{
+    ScanDecoder decoder;
+
+    EXPECT_TRUE(type(decoder, "4006381\r", milliseconds(2)));
+    EXPECT_EQ(decoder.getCode(), "4006381");
+
+    char c;
+    EXPECT_FALSE(decoder.takeKey(c));
+}
+
+TEST_F(ScannerInputTests, SlowTypingIsReleasedAsKeys)
+{
+    ScanDecoder decoder;
+
+    EXPECT_FALSE(type(decoder, "sse\n", milliseconds(150)));
+
+    std::string keys;
+    char c;
+    while (decoder.takeKey(c))
+    {
+        keys += c;
+    }
+    EXPECT_EQ(keys, "sse\n");
+}
+
+TEST_F(ScannerInputTests, QuietBurstWithoutEnterIsReleasedAtDeadline)
+{
+    ScanDecoder decoder;
+    type(decoder, "ws", milliseconds(1));
+
+    EXPECT_TRUE(decoder.hasPending());
+    decoder.expire(decoder.getDeadline() + milliseconds(1));
+
+    char c;
+    ASSERT_TRUE(decoder.takeKey(c));
+    EXPECT_EQ(c, 'w');
+    ASSERT_TRUE(decoder.takeKey(c));
+    EXPECT_EQ(c, 's');
+    EXPECT_FALSE(decoder.hasPending());
+}
+
+TEST_F(ScannerInputTests, ShortBurstIsNotScan)
+{
+    ScanDecoder decoder(milliseconds(30), 4);
+
+    EXPECT_FALSE(type(decoder, "ab\r", milliseconds(1)));
+}
+
+TEST_F(ScannerInputTests, ListenerReportsScansAndKeys)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ScannerInputListener listener(fds[0]);
+    listener.startListening();
+
+    // A scan arrives in one read; a key typed much later is a normal command
+    ASSERT_EQ(::write(fds[1], "4006381\n", 8), 8);
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::SelectByKey);
+    EXPECT_EQ(listener.getScannedCode(), "4006381");
+    EXPECT_EQ(listener.pollCommand(), NavigationCommand::None);
+
+    ASSERT_EQ(::write(fds[1], "s", 1), 1);
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::Down);
+
+    ::close(fds[1]);
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::None);
+    EXPECT_FALSE(listener.isListening());
+    ::close(fds[0]);
+}
+
+TEST_F(ScannerInputTests, SelectByKeyJumpsAndIncrementsInOneFrame)
+{
+    mockRenderer->reset();
+
+    EXPECT_TRUE(controller->selectByKey("4006381", true));
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(mockRenderer->getLine(1), ">4006381   :4   ");
+
+    EXPECT_FALSE(controller->selectByKey("0000000"));
+}
+
+TEST_F(ScannerInputTests, ListenerDecodesArrowKeys)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ScannerInputListener listener(fds[0]);
+    listener.startListening();
+
+    ASSERT_EQ(::write(fds[1], "\x1B[A", 3), 3);
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::Up);
+
+    ::close(fds[1]);
+    ::close(fds[0]);
+}
+
+TEST_F(ScannerInputTests, SignalDuringWaitDoesNotEndSession)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ScannerInputListener listener(fds[0]);
+    listener.startListening();
+
+    SignalInterrupter interrupter;
+    std::thread writer([&]
+    {
+        // The key is only written once the wait has been interrupted
+        EXPECT_TRUE(interrupter.interruptBlockedCall());
+        EXPECT_EQ(::write(fds[1], "s", 1), 1);
+    });
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::Down);
+    EXPECT_TRUE(listener.isListening());
+
+    writer.join();
+    ::close(fds[1]);
+    ::close(fds[0]);
+}
+
+TEST_F(ScannerInputTests, InputErrorEndsSession)
+{
+    // Reading a write-only descriptor fails: the session ends instead of polling forever
+    int fd = ::open("/dev/null", O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ScannerInputListener listener(fd);
+    listener.startListening();
+
+    EXPECT_EQ(listener.waitForCommand(), NavigationCommand::None);
+    EXPECT_FALSE(listener.isListening());
+    ::close(fd);
+}
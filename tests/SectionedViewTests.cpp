@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "SectionedView.h"
+#include "FenwickTree.h"
+#include "LCDDisplayController.h"
+#include "LCDInventoryController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+
+class SectionedViewTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::shared_ptr<SectionedView> sections;
+    std::unique_ptr<Controller> controller;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+
+        // Fasteners: Bolt, Nut, Screw | Tools: Drill, Saw
+        std::vector<TestDisplayItem> items;
+        items.emplace_back("Bolt", 1);
+        items.emplace_back("Nut", 2);
+        items.emplace_back("Screw", 3);
+        items.emplace_back("Drill", 4);
+        items.emplace_back("Saw", 5);
+        controller.reset(new Controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':')));
+
+        sections = std::make_shared<SectionedView>(SectionedView::fromCategories(
+            {"Fasteners", "Fasteners", "Fasteners", "Tools", "Tools"}));
+    }
+};
+
+TEST_F(SectionedViewTests, RowsIncludeOneHeaderPerSection)
+{
+    EXPECT_EQ(sections->getSectionCount(), 2);
+    EXPECT_EQ(sections->getRowCount(), 7);
+    EXPECT_EQ(sections->getItemAtRow(0), IItemView::noItem);
+    EXPECT_EQ(sections->getItemAtRow(1), 0);
+    EXPECT_EQ(sections->getItemAtRow(4), IItemView::noItem);
+    EXPECT_EQ(sections->getItemAtRow(6), 4);
+    EXPECT_EQ(sections->getRowOfItem(3), 5);
+}
+
+TEST_F(SectionedViewTests, CollapsingSectionHidesItsRows)
+{
+    EXPECT_TRUE(sections->setCollapsed(0, true));
+
+    EXPECT_EQ(sections->getRowCount(), 4);
+    EXPECT_EQ(sections->getItemAtRow(1), IItemView::noItem);
+    EXPECT_EQ(sections->getItemAtRow(2), 3);
+    EXPECT_EQ(sections->getRowOfItem(1), IItemView::noItem);
+    EXPECT_EQ(sections->getRowLabel(0), "[+] Fasteners");
+    EXPECT_EQ(sections->getRowLabel(1), "[-] Tools");
+}
+
+TEST_F(SectionedViewTests, ControllerRendersHeadersAndItems)
+{
+    controller->setView(sections);
+
+    EXPECT_EQ(mockRenderer->getLine(0), " [-] Fasteners  ");
+    EXPECT_EQ(mockRenderer->getLine(1), ">Bolt      :1   ");
+    EXPECT_EQ(controller->getSelectedRow(), 1);
+    EXPECT_EQ(controller->getSelectedItemIndex(), 0);
+    EXPECT_EQ(controller->getWindowStartIndex(), 0);
+}
+
+TEST_F(SectionedViewTests, SelectingHeaderTogglesSection)
+{
+    controller->setView(sections);
+    controller->navigateUp();   // Header of Fasteners
+
+    EXPECT_FALSE(controller->hasCurrentItem());
+    EXPECT_TRUE(controller->selectItem());
+
+    EXPECT_TRUE(sections->isCollapsed(0));
+    EXPECT_EQ(controller->getRowCount(), 4);
+    EXPECT_EQ(controller->getSelectedRow(), 0);
+    EXPECT_EQ(mockRenderer->getLine(1), " [-] Tools      ");
+}
+
+TEST_F(SectionedViewTests, NavigationSkipsCollapsedItems)
+{
+    sections->setCollapsed(0, true);
+    controller->setView(sections);
+
+    controller->navigateDown();
+    controller->navigateDown();
+
+    EXPECT_EQ(controller->getCurrentKey(), "Drill");
+    EXPECT_EQ(controller->getWindowStartIndex(), 1);
+}
+
+TEST_F(SectionedViewTests, IncrementOnHeaderIsIgnored)
+{
+    std::vector<TestDisplayItem> items;
+    items.emplace_back("Bolt", 1);
+    LCDInventoryController<TestDisplayItem> inventory(items, mockRenderer, DisplayConfig(2, 16, '>', ':'));
+    inventory.getDisplayController().setView(std::make_shared<SectionedView>(
+        std::vector<SectionedView::Section>{SectionedView::Section("Parts", 1)}));
+    inventory.getDisplayController().navigateUp();
+
+    EXPECT_NO_THROW(inventory.incrementValue());
+    EXPECT_EQ(inventory.getDisplayController().getItems()[0].getValue(), 1);
+}
+
+TEST_F(SectionedViewTests, SelectedItemSurvivesCollapsingOtherSections)
+{
+    controller->setView(sections);
+    for (int i = 0; i < 5; ++i)
+    {
+        controller->navigateDown();   // Saw (row 6)
+    }
+
+    sections->setCollapsed(0, true);
+    controller->refreshView();
+
+    EXPECT_EQ(controller->getCurrentKey(), "Saw");
+    EXPECT_EQ(controller->getSelectedRow(), 3);
+}
+
+TEST_F(SectionedViewTests, MillionItemListMapsRowsWithManySectionsCollapsed)
+{
+    const size_t sectionCount = 100000;
+    std::vector<SectionedView::Section> large;
+    for (size_t i = 0; i < sectionCount; ++i)
+    {
+        large.emplace_back("S" + std::to_string(i), 10, i % 2 == 0);
+    }
+    SectionedView view(std::move(large));
+
+    // Even sections collapsed (1 row), odd sections expanded (11 rows)
+    EXPECT_EQ(view.getRowCount(), sectionCount / 2 * 12);
+    EXPECT_EQ(view.getItemAtRow(2), 10);
+    EXPECT_EQ(view.getRowOfItem(999999), view.getRowCount() - 1);
+    EXPECT_EQ(view.getSectionOfRow(view.getRowCount() - 1), sectionCount - 1);
+
+    view.setAllCollapsed(false);
+    EXPECT_EQ(view.getRowCount(), sectionCount * 11);
+}
+
+TEST_F(SectionedViewTests, FenwickTreeFindsPositions)
+{
+    FenwickTree tree({3, 0, 2, 5});
+
+    EXPECT_EQ(tree.total(), 10);
+    EXPECT_EQ(tree.prefixSum(2), 3);
+    EXPECT_EQ(tree.findByPosition(2), 0);
+    EXPECT_EQ(tree.findByPosition(3), 2);
+    EXPECT_EQ(tree.findByPosition(9), 3);
+    EXPECT_EQ(tree.findByPosition(10), 4);
+
+    tree.add(1, 4);
+    EXPECT_EQ(tree.findByPosition(3), 1);
+
+    tree.subtract(3, 5);
+    EXPECT_EQ(tree.total(), 9);
+    EXPECT_EQ(tree.prefixSum(4), 9);
+    EXPECT_EQ(tree.findByPosition(8), 2);
+    EXPECT_EQ(tree.findByPosition(9), 4);
+}
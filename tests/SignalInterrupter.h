@@ -0,0 +1,96 @@
+#ifndef SIGNALINTERRUPTER_H
+#define SIGNALINTERRUPTER_H
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * Interrupts a thread blocked in a system call with SIGUSR1 for EINTR tests.
+ *
+ * The handler is installed without SA_RESTART, so a blocking call fails with EINTR instead
+ * of being restarted by the kernel. The thread constructing the interrupter is the target.
+ */
+class SignalInterrupter
+{
+public:
+    SignalInterrupter()
+        : target(::pthread_self()), targetId(static_cast<pid_t>(::syscall(SYS_gettid)))
+    {
+        struct sigaction action = {};
+        action.sa_handler = [](int) { ++handled(); };
+        sigemptyset(&action.sa_mask);
+        installed = (::sigaction(SIGUSR1, &action, &previous) == 0);
+    }
+
+    ~SignalInterrupter()
+    {
+        if (installed)
+        {
+            ::sigaction(SIGUSR1, &previous, nullptr);
+        }
+    }
+
+    SignalInterrupter(const SignalInterrupter&) = delete;
+    SignalInterrupter& operator=(const SignalInterrupter&) = delete;
+
+    /**
+     * Call from another thread: wait until the target sleeps in a system call, signal it and
+     * wait until the handler ran on it.
+     * @return false if the target never blocked or the signal was not handled in time
+     */
+    bool interruptBlockedCall()
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!isSleeping())
+        {
+            if (!installed || std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        int before = handled().load();
+        ::pthread_kill(target, SIGUSR1);
+        while (handled().load() == before)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+private:
+    pthread_t target;
+    pid_t targetId;
+    bool installed = false;
+    struct sigaction previous = {};
+
+    static std::atomic<int>& handled()
+    {
+        static std::atomic<int> count(0);
+        return count;
+    }
+
+    // True while the target is in interruptible sleep ('S' in /proc/<pid>/task/<tid>/stat)
+    bool isSleeping() const
+    {
+        std::ifstream stat("/proc/self/task/" + std::to_string(targetId) + "/stat");
+        std::string line;
+        std::getline(stat, line);
+        size_t name = line.rfind(')');
+        return name != std::string::npos && name + 2 < line.size() && line[name + 2] == 'S';
+    }
+};
+
+#endif // SIGNALINTERRUPTER_H
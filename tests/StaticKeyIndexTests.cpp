@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "StaticKeyIndex.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+
+namespace
+{
+    constexpr auto fasteners = makeStaticKeyIndex<5>({"Bolt", "Nut", "Screw", "Washer", "Rivet"});
+
+    // Lookups are evaluated at compile time when the key is a constant
+    static_assert(fasteners.find("Screw") == 2, "perfect hash lookup");
+    static_assert(fasteners.find("Nail") == StaticKeyIndex<5>::notFound, "unknown key");
+}
+
+class StaticKeyIndexTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::unique_ptr<Controller> controller;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+
+        std::vector<TestDisplayItem> items;
+        items.emplace_back("Bolt", 10);
+        items.emplace_back("Nut", 20);
+        items.emplace_back("Screw", 30);
+        items.emplace_back("Washer", 40);
+        items.emplace_back("Rivet", 50);
+        controller.reset(new Controller(items, mockRenderer, DisplayConfig(2, 16, '>', ':')));
+    }
+};
+
+TEST_F(StaticKeyIndexTests, EveryKeyMapsToItsIndex)
+{
+    for (size_t i = 0; i < fasteners.size(); ++i)
+    {
+        EXPECT_EQ(fasteners.find(fasteners.getKey(i)), i);
+    }
+    EXPECT_FALSE(fasteners.contains(std::string("Bol")));
+    EXPECT_FALSE(fasteners.contains(""));
+}
+
+TEST_F(StaticKeyIndexTests, LargerKeySetsArePlaced)
+{
+    constexpr auto skus = makeStaticKeyIndex<24>({
+        "SKU-00", "SKU-01", "SKU-02", "SKU-03", "SKU-04", "SKU-05", "SKU-06", "SKU-07",
+        "SKU-08", "SKU-09", "SKU-10", "SKU-11", "SKU-12", "SKU-13", "SKU-14", "SKU-15",
+        "SKU-16", "SKU-17", "SKU-18", "SKU-19", "SKU-20", "SKU-21", "SKU-22", "SKU-23"});
+
+    for (size_t i = 0; i < skus.size(); ++i)
+    {
+        EXPECT_EQ(skus.find(skus.getKey(i)), i);
+    }
+    EXPECT_EQ(skus.find("SKU-24"), StaticKeyIndex<24>::notFound);
+}
+
+TEST_F(StaticKeyIndexTests, DuplicateKeysAreRejected)
+{
+    EXPECT_THROW(makeStaticKeyIndex<2>({"Bolt", "Bolt"}), std::invalid_argument);
+}
+
+TEST_F(StaticKeyIndexTests, JumpToKeyMovesNavigator)
+{
+    EXPECT_TRUE(controller->jumpToKey(fasteners, "Washer"));
+    EXPECT_EQ(controller->getSelectedItemIndex(), 3);
+    EXPECT_EQ(controller->getWindowStartIndex(), 2);
+    EXPECT_EQ(mockRenderer->getLine(1), ">Washer    :40  ");
+
+    EXPECT_FALSE(controller->jumpToKey(fasteners, "Nail"));
+    EXPECT_EQ(controller->getSelectedItemIndex(), 3);
+}
+
+TEST_F(StaticKeyIndexTests, UpdatesByKeyRenderOnce)
+{
+    mockRenderer->reset();
+    std::vector<std::pair<std::string, int>> updates = {{"Bolt", 11}, {"Nail", 99}, {"Nut", 21}};
+
+    EXPECT_EQ(controller->applyUpdatesByKey(fasteners, updates), 2);
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(controller->getItems()[1].getValue(), 21);
+}
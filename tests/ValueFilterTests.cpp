@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "ValueFilter.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+class ValueFilterTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    std::unique_ptr<LCDDisplayController<TestDisplayItem>> controller;
+    Clock::time_point start;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+        std::vector<TestDisplayItem> items;
+        items.emplace_back("Temp", 20);
+        items.emplace_back("Humidity", 50);
+        controller.reset(new LCDDisplayController<TestDisplayItem>(items, mockRenderer, DisplayConfig(2, 16, '>', ':')));
+        start = Clock::now();
+    }
+};
+
+TEST_F(ValueFilterTests, UnfilteredUpdateRendersOnlyOnChange)
+{
+    EXPECT_TRUE(controller->updateValue(1, 51, start));
+    EXPECT_FALSE(controller->updateValue(1, 51, start));
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_EQ(controller->getItems()[1].getValue(), 51);
+}
+
+TEST_F(ValueFilterTests, DeadbandSuppressesAdjacentFlicker)
+{
+    controller->setValueFilter(0, ValueFilterConfig(1.0));
+
+    EXPECT_FALSE(controller->updateValue(0, 21, start));
+    EXPECT_FALSE(controller->updateValue(0, 19, start));
+    EXPECT_TRUE(controller->updateValue(0, 23, start));
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_FALSE(controller->isDirty());
+    EXPECT_EQ(controller->getItems()[0].getValue(), 23);
+}
+
+TEST_F(ValueFilterTests, MinimumIntervalLimitsChangeRate)
+{
+    controller->setValueFilter(0, ValueFilterConfig(0.0, milliseconds(100)));
+
+    EXPECT_TRUE(controller->updateValue(0, 30, start));
+    EXPECT_FALSE(controller->updateValue(0, 31, start + milliseconds(50)));
+    EXPECT_TRUE(controller->updateValue(0, 32, start + milliseconds(150)));
+
+    EXPECT_EQ(controller->getItems()[0].getValue(), 32);
+}
+
+TEST_F(ValueFilterTests, MovingAverageSmoothsSamples)
+{
+    controller->setValueFilter(0, ValueFilterConfig(0.0, milliseconds(0), 4));
+
+    controller->updateValue(0, 20, start);
+    controller->updateValue(0, 20, start);
+    controller->updateValue(0, 20, start);
+    EXPECT_TRUE(controller->updateValue(0, 40, start));
+
+    EXPECT_EQ(controller->getItems()[0].getValue(), 25);
+}
+
+TEST_F(ValueFilterTests, FilteredUpdatesWhileHiddenDoNotDirtyDisplay)
+{
+    controller->render();
+    controller->setVisible(false);
+    controller->setValueFilter(0, ValueFilterConfig(2.0));
+
+    controller->updateValue(0, 21, start);
+    controller->updateValue(0, 22, start);
+
+    EXPECT_FALSE(controller->isDirty());
+}
+
+TEST_F(ValueFilterTests, ClearValueFilterRestoresRawUpdates)
+{
+    controller->setValueFilter(0, ValueFilterConfig(5.0));
+    EXPECT_TRUE(controller->clearValueFilter(0));
+
+    EXPECT_TRUE(controller->updateValue(0, 21, start));
+    EXPECT_FALSE(controller->clearValueFilter(0));
+}
+
+TEST_F(ValueFilterTests, InvalidFilterConfigurationThrows)
+{
+    EXPECT_THROW(controller->setValueFilter(0, ValueFilterConfig(0.0, milliseconds(0), 0)), std::invalid_argument);
+    EXPECT_THROW(controller->setValueFilter(0, ValueFilterConfig(-1.0)), std::invalid_argument);
+    EXPECT_THROW(controller->setValueFilter(5, ValueFilterConfig()), std::out_of_range);
+    EXPECT_THROW(controller->updateValue(5, 1), std::out_of_range);
+}
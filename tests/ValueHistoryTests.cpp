@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "ValueHistory.h"
+#include "BarGlyphs.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+
+class ValueHistoryTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+    }
+};
+
+TEST_F(ValueHistoryTests, RecordsSamplesOldestFirst)
+{
+    ValueHistory<> history(2, 4);
+    history.record(1, 10);
+    history.record(1, 12);
+    history.record(1, 9);
+
+    int64_t samples[4];
+    ASSERT_EQ(history.copyRecent(1, 4, samples), 3);
+    EXPECT_EQ(samples[0], 10);
+    EXPECT_EQ(samples[1], 12);
+    EXPECT_EQ(samples[2], 9);
+    EXPECT_EQ(history.getSampleCount(0), 0);
+}
+
+TEST_F(ValueHistoryTests, FullRingEvictsOldestSample)
+{
+    ValueHistory<> history(1, 3);
+    for (int64_t value : {1, 2, 3, 4, 5})
+    {
+        history.record(0, value);
+    }
+
+    int64_t samples[3];
+    ASSERT_EQ(history.copyRecent(0, 3, samples), 3);
+    EXPECT_EQ(samples[0], 3);
+    EXPECT_EQ(samples[1], 4);
+    EXPECT_EQ(samples[2], 5);
+}
+
+TEST_F(ValueHistoryTests, OversizedDeltasSaturateAndCatchUp)
+{
+    ValueHistory<int8_t> history(1, 4);
+    history.record(0, 0);
+    history.record(0, 200);
+    history.record(0, 200);
+
+    int64_t samples[3];
+    history.copyRecent(0, 3, samples);
+    EXPECT_EQ(samples[1], 127);
+    EXPECT_EQ(samples[2], 200);
+}
+
+TEST_F(ValueHistoryTests, MemoryPerItemIsBoundedByCapacity)
+{
+    ValueHistory<int8_t> history(1000, 16);
+
+    EXPECT_LE(history.getBytesPerItem(), 16 + 24);
+}
+
+TEST_F(ValueHistoryTests, ZeroCapacityThrows)
+{
+    EXPECT_THROW(ValueHistory<>(1, 0), std::invalid_argument);
+}
+
+TEST_F(ValueHistoryTests, OversizedCapacityThrowsBeforeAllocating)
+{
+    // Validated before the rings are sized: no bad_alloc or huge allocation first
+    const size_t tooManySamples = static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1;
+    EXPECT_THROW(ValueHistory<>(1000000, tooManySamples), std::invalid_argument);
+    EXPECT_THROW(ValueHistory<>(std::numeric_limits<size_t>::max() / 2, 4), std::invalid_argument);
+}
+
+TEST_F(ValueHistoryTests, SparklineScalesBetweenMinAndMax)
+{
+    ValueHistory<> history(1, 8);
+    history.record(0, 0);
+    history.record(0, 7);
+    history.record(0, 14);
+
+    std::string line;
+    history.appendSparkline(0, 4, BarGlyphs::ascii(), line);
+
+    EXPECT_EQ(line, " _-#");
+}
+
+TEST_F(ValueHistoryTests, CgramGlyphsAvoidNulAndFillBottomUp)
+{
+    BarGlyphs glyphs = BarGlyphs::cgram();
+
+    EXPECT_EQ(glyphs.glyph(0), '\x08');
+    EXPECT_EQ(glyphs.glyph(99), '\x0F');
+    EXPECT_EQ(BarGlyphs::getCgramPattern(0, 7), 0x1F);
+    EXPECT_EQ(BarGlyphs::getCgramPattern(0, 6), 0x00);
+    EXPECT_EQ(BarGlyphs::getCgramPattern(7, 0), 0x1F);
+}
+
+TEST_F(ValueHistoryTests, ControllerRendersSparklineInSpareColumns)
+{
+    std::vector<TestDisplayItem> items;
+    items.emplace_back("Temp", 0);
+    LCDDisplayController<TestDisplayItem> controller(items, mockRenderer, DisplayConfig(1, 20, '>', ':'));
+
+    controller.enableHistory(16, 4);
+    controller.setCurrentValue(5);
+    controller.setCurrentValue(10);
+
+    EXPECT_EQ(mockRenderer->getLine(0), ">Temp      :10   _-#");
+    EXPECT_EQ(controller.getHistory()->getSampleCount(0), 3);
+}
+
+TEST_F(ValueHistoryTests, ControllerRejectsSparklineWiderThanSpareColumns)
+{
+    std::vector<TestDisplayItem> items;
+    items.emplace_back("Temp", 0);
+    LCDDisplayController<TestDisplayItem> controller(items, mockRenderer, DisplayConfig(1, 18, '>', ':'));
+
+    EXPECT_THROW(controller.enableHistory(16, 4), std::invalid_argument);
+    EXPECT_EQ(controller.getHistory(), nullptr);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "ValueUpdateChannel.h"
+#include "LCDDisplayController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+using Controller = LCDDisplayController<TestDisplayItem>;
+using Channel = ValueUpdateChannel<TestDisplayItem>;
+
+class ValueUpdateChannelTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> renderer = std::make_shared<MockRenderer>();
+
+    static std::vector<TestDisplayItem> makeItems(int count)
+    {
+        std::vector<TestDisplayItem> items;
+        for (int i = 0; i < count; ++i)
+        {
+            items.emplace_back("Item" + std::to_string(i), 0);
+        }
+        return items;
+    }
+};
+
+TEST_F(ValueUpdateChannelTests, DrainCoalescesUpdatesPerItem)
+{
+    Controller controller(makeItems(4), renderer, DisplayConfig(2, 16, '>', ':'));
+    Channel channel(controller);
+    renderer->reset();
+
+    channel.post(0, 1);
+    channel.post(0, 2);
+    channel.post(1, 5);
+    channel.post(0, 3);
+    Channel::Stats stats = channel.drain();
+
+    EXPECT_EQ(stats.received, 4u);
+    EXPECT_EQ(stats.applied, 2u);
+    EXPECT_EQ(stats.changed, 2u);
+    EXPECT_EQ(renderer->renderCallCount, 1);
+    EXPECT_EQ(controller.getItems()[0].getValue(), 3);
+    EXPECT_EQ(controller.getItems()[1].getValue(), 5);
+}
+
+TEST_F(ValueUpdateChannelTests, DrainDropsRemovedItems)
+{
+    Controller controller(makeItems(4), renderer, DisplayConfig(2, 16, '>', ':'));
+    Channel channel(controller);
+    channel.post(3, 7);
+    channel.post(9, 1);
+    controller.removeItem(3);
+    renderer->reset();
+
+    Channel::Stats stats = channel.drain();
+    EXPECT_EQ(stats.received, 2u);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.applied, 0u);
+    EXPECT_EQ(renderer->renderCallCount, 0);
+
+    stats = channel.drain();
+    EXPECT_EQ(stats.received, 0u);
+}
+
+TEST_F(ValueUpdateChannelTests, DrainDropsUpdatesPostedBeforeMiddleRemoval)
+{
+    Controller controller(makeItems(5), renderer, DisplayConfig(2, 16, '>', ':'));
+    Channel channel(controller);
+    channel.post(1, 11);
+    channel.post(3, 33);    // Item3 moves to index 2; index 3 becomes Item4
+    controller.removeItem(2);
+
+    Channel::Stats stats = channel.drain();
+    EXPECT_EQ(stats.received, 2u);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.applied, 0u);
+    for (size_t i = 0; i < controller.getItemCount(); ++i)
+    {
+        EXPECT_EQ(controller.getItems()[i].getValue(), 0) << controller.getItems()[i].getKey();
+    }
+
+    channel.post(2, 33);
+    stats = channel.drain();
+    EXPECT_EQ(stats.applied, 1u);
+    EXPECT_EQ(controller.getItems()[2].getKey(), "Item3");
+    EXPECT_EQ(controller.getItems()[2].getValue(), 33);
+}
+
+TEST_F(ValueUpdateChannelTests, StructureGenerationTracksMovedItems)
+{
+    Controller controller(makeItems(3), renderer, DisplayConfig(2, 16, '>', ':'));
+    Channel channel(controller);
+    const uint64_t initial = controller.getStructureGeneration();
+
+    channel.post(1, 5);
+    controller.insertItem(controller.getItemCount(), TestDisplayItem("Tail", 0));
+    controller.appendItems(makeItems(1));
+    EXPECT_EQ(controller.getStructureGeneration(), initial);    // Appends move nothing
+    EXPECT_EQ(channel.drain().applied, 1u);
+    EXPECT_EQ(controller.getItems()[1].getValue(), 5);
+
+    channel.post(1, 6, initial);
+    controller.insertItem(0, TestDisplayItem("Head", 0));
+    EXPECT_NE(controller.getStructureGeneration(), initial);
+    Channel::Stats stats = channel.drain();
+    EXPECT_EQ(stats.dropped, 1u);
+    EXPECT_EQ(controller.getItems()[2].getKey(), "Item1");
+    EXPECT_EQ(controller.getItems()[2].getValue(), 5);
+}
+
+TEST_F(ValueUpdateChannelTests, ConcurrentProducersLastWriteWins)
+{
+    const int producerCount = 8;
+    const int itemsPerProducer = 16;
+    const int postsPerItem = 2000;
+    Controller controller(makeItems(producerCount * itemsPerProducer), renderer,
+                          DisplayConfig(2, 16, '>', ':'));
+    Channel channel(controller);
+    std::atomic<int> finished{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p)
+    {
+        producers.emplace_back([&, p]()
+        {
+            for (int value = 1; value <= postsPerItem; ++value)
+            {
+                for (int i = 0; i < itemsPerProducer; ++i)
+                {
+                    channel.post(static_cast<size_t>(p * itemsPerProducer + i), value);
+                }
+            }
+            finished.fetch_add(1);
+        });
+    }
+
+    size_t received = 0;
+    while (finished.load() < producerCount)
+    {
+        received += channel.drain().received;           // Controller thread ticks
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    received += channel.drain().received;
+
+    EXPECT_EQ(received, static_cast<size_t>(producerCount * itemsPerProducer * postsPerItem));
+    for (const auto& item : controller.getItems())
+    {
+        EXPECT_EQ(item.getValue(), postsPerItem);
+    }
+}
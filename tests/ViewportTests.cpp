@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "LCDDisplayController.h"
+#include "ItemTextCache.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+
+class ViewportTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> handheldRenderer;
+    std::shared_ptr<MockRenderer> wallRenderer;
+    DisplayConfig handheldConfig;
+    DisplayConfig wallConfig;
+
+    void SetUp() override
+    {
+        handheldRenderer = std::make_shared<MockRenderer>();
+        wallRenderer = std::make_shared<MockRenderer>();
+        handheldConfig = DisplayConfig(2, 16, '>', ':');
+        wallConfig = DisplayConfig(4, 20, '*', '=');
+    }
+
+    std::vector<TestDisplayItem> createItems(int count)
+    {
+        std::vector<TestDisplayItem> items;
+        for (int i = 0; i < count; ++i)
+        {
+            items.emplace_back("Item" + std::to_string(i), i * 10);
+        }
+        return items;
+    }
+};
+
+TEST_F(ViewportTests, ViewportRendersWithItsOwnGeometry)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(6), handheldRenderer, handheldConfig);
+    controller.addViewport(wallRenderer, wallConfig, 13, 5);
+
+    controller.render();
+
+    ASSERT_EQ(wallRenderer->getLineCount(), 4);
+    EXPECT_EQ(wallRenderer->lastColumns, 20);
+    EXPECT_EQ(wallRenderer->getLine(0), "*Item0        =0    ");
+    EXPECT_EQ(wallRenderer->getLine(3), " Item3        =30   ");
+    EXPECT_EQ(handheldRenderer->getLine(0), ">Item0     :0   ");
+}
+
+TEST_F(ViewportTests, ViewportsShareSelectionButScrollIndependently)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(6), handheldRenderer, handheldConfig);
+    controller.addViewport(wallRenderer, wallConfig, 13, 5);
+
+    controller.navigateDown();
+    controller.navigateDown();
+
+    EXPECT_EQ(controller.getWindowStartIndex(), 1);
+    EXPECT_EQ(controller.getViewportWindowStartIndex(0), 0);
+    EXPECT_EQ(wallRenderer->getLine(2)[0], '*');
+    EXPECT_EQ(handheldRenderer->getLine(1)[0], '>');
+}
+
+TEST_F(ViewportTests, ValueChangesReachEveryViewport)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(3), handheldRenderer, handheldConfig);
+    controller.addViewport(wallRenderer, wallConfig, 13, 5);
+    controller.render();
+
+    controller.setCurrentValue(1234);
+
+    EXPECT_EQ(handheldRenderer->getLine(0), ">Item0     :1234");
+    EXPECT_EQ(wallRenderer->getLine(0), "*Item0        =1234 ");
+}
+
+TEST_F(ViewportTests, DirectItemEditsAreVisibleAfterRender)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(3), handheldRenderer, handheldConfig);
+    controller.render();
+
+    controller.getItems()[0].setKey("Renamed");
+    controller.render();
+
+    EXPECT_EQ(handheldRenderer->getLine(0), ">Renamed   :0   ");
+}
+
+TEST_F(ViewportTests, HeldItemsReferenceEditsAreVisibleInEveryViewport)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(3), handheldRenderer, handheldConfig);
+    controller.addViewport(wallRenderer, wallConfig, 13, 5);
+    std::vector<TestDisplayItem>& items = controller.getItems();
+    controller.render();
+
+    // The reference outlives a render; cached text must not hide edits made through it
+    items[1].setValue(42);
+    items[2].setKey("Renamed");
+    controller.render();
+
+    EXPECT_EQ(handheldRenderer->getLine(1), " Item1     :42  ");
+    EXPECT_EQ(wallRenderer->getLine(1), " Item1        =42   ");
+    EXPECT_EQ(wallRenderer->getLine(2), " Renamed      =20   ");
+}
+
+TEST_F(ViewportTests, TooNarrowViewportThrows)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(3), handheldRenderer, handheldConfig);
+
+    EXPECT_THROW(controller.addViewport(wallRenderer, wallConfig, 15, 5), std::invalid_argument);
+    EXPECT_THROW(controller.addViewport(nullptr, wallConfig, 10, 4), std::invalid_argument);
+}
+
+TEST_F(ViewportTests, HiddenControllerRendersNoViewport)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(3), handheldRenderer, handheldConfig);
+    controller.addViewport(wallRenderer, wallConfig, 13, 5);
+    controller.setVisible(false);
+
+    controller.navigateDown();
+
+    EXPECT_EQ(wallRenderer->renderCallCount, 0);
+    controller.setVisible(true);
+    EXPECT_EQ(wallRenderer->renderCallCount, 1);
+}
+
+TEST_F(ViewportTests, TextCacheSizeIsIndependentOfItemCount)
+{
+    ItemTextCache<TestDisplayItem> cache(6);
+    std::vector<TestDisplayItem> items = createItems(1000);
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        EXPECT_EQ(cache.getKeyText(i, items[i]), items[i].getKeyText());
+    }
+
+    EXPECT_EQ(cache.capacity(), 8);
+}
+
+TEST_F(ViewportTests, TextCacheRefreshesEditedItems)
+{
+    ItemTextCache<TestDisplayItem> cache;
+    TestDisplayItem item("Key", 5);
+
+    EXPECT_EQ(cache.getValueText(3, item), "5");
+    item.setValue(42);
+    EXPECT_EQ(cache.getValueText(3, item), "42");
+    item.setKey("Other");
+    EXPECT_EQ(cache.getKeyText(3, item), "Other");
+
+    cache.invalidate(3);
+    EXPECT_EQ(cache.getValueText(3, item), "42");
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "LCDDisplayController.h"
+#include "LCDInventoryController.h"
+#include "DisplayItem.h"
+#include "DisplayConfig.h"
+#include "MockRenderer.h"
+#include <memory>
+#include <vector>
+
+// Use a simple display item type for testing
+using TestDisplayItem = DisplayItem<std::string, int, 10, 4>;
+
+class VisibilityTests : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockRenderer> mockRenderer;
+    DisplayConfig config;
+
+    void SetUp() override
+    {
+        mockRenderer = std::make_shared<MockRenderer>();
+        config = DisplayConfig(2, 16, '>', ':');
+    }
+
+    std::vector<TestDisplayItem> createItems(int count)
+    {
+        std::vector<TestDisplayItem> items;
+        for (int i = 0; i < count; ++i)
+        {
+            items.emplace_back("Item" + std::to_string(i), i);
+        }
+        return items;
+    }
+};
+
+TEST_F(VisibilityTests, ControllerIsVisibleByDefault)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(3), mockRenderer, config);
+
+    EXPECT_TRUE(controller.isVisible());
+}
+
+TEST_F(VisibilityTests, MutationsWhileHiddenDoNotRender)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(5), mockRenderer, config);
+    controller.setVisible(false);
+    mockRenderer->reset();
+
+    controller.navigateDown();
+    controller.navigateDown();
+    controller.setCurrentValue(77);
+    controller.selectItem();
+    controller.render();
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 0);
+    EXPECT_TRUE(controller.isDirty());
+    EXPECT_EQ(controller.getSelectedItemIndex(), 2);
+    EXPECT_EQ(controller.getCurrentValue(), 77);
+}
+
+TEST_F(VisibilityTests, BecomingVisibleRendersExactlyOneCatchUpFrame)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(5), mockRenderer, config);
+    controller.render();
+    controller.setVisible(false);
+    controller.navigateDown();
+    controller.navigateDown();
+    mockRenderer->reset();
+
+    controller.setVisible(true);
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+    EXPECT_FALSE(controller.isDirty());
+    EXPECT_EQ(mockRenderer->getLine(1)[0], '>');
+    EXPECT_EQ(mockRenderer->getLine(1).substr(1, 5), "Item2");
+}
+
+TEST_F(VisibilityTests, BecomingVisibleWithoutChangesDoesNotRender)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(3), mockRenderer, config);
+    controller.render();
+    controller.setVisible(false);
+    mockRenderer->reset();
+
+    controller.setVisible(true);
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 0);
+}
+
+TEST_F(VisibilityTests, InvalidateForcesFrameOnNextShow)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(3), mockRenderer, config);
+    controller.render();
+    controller.setVisible(false);
+    controller.invalidate();
+    mockRenderer->reset();
+
+    controller.setVisible(true);
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+}
+
+TEST_F(VisibilityTests, SetVisibleReturnsFalseWhenUnchanged)
+{
+    LCDDisplayController<TestDisplayItem> controller(createItems(3), mockRenderer, config);
+
+    EXPECT_FALSE(controller.setVisible(true));
+    EXPECT_TRUE(controller.setVisible(false));
+    EXPECT_FALSE(controller.setVisible(false));
+}
+
+TEST_F(VisibilityTests, InventoryControllerForwardsVisibility)
+{
+    LCDInventoryController<TestDisplayItem> inventory(createItems(3), mockRenderer, config);
+    inventory.setVisible(false);
+    mockRenderer->reset();
+
+    inventory.incrementValue();
+    inventory.incrementValue();
+
+    EXPECT_EQ(mockRenderer->renderCallCount, 0);
+    EXPECT_EQ(inventory.getDisplayController().getCurrentValue(), 2);
+
+    inventory.setVisible(true);
+    EXPECT_EQ(mockRenderer->renderCallCount, 1);
+}